@@ -0,0 +1,46 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+
+// Best wall time of several runs, in milliseconds.  Taking the minimum keeps
+// the first run's page faults and the odd scheduler hiccup out of the result.
+template <typename F> double MeasureMilliseconds(F &&run, int repeat = 5) {
+  auto best = std::numeric_limits<double>::max();
+  for (int i = 0; i < repeat; i++) {
+    auto start = std::chrono::steady_clock::now();
+    run();
+    auto end = std::chrono::steady_clock::now();
+    best = std::min<double>(
+        best, std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  return best;
+}
+
+// Set by any benchmark whose result check failed; main then exits non-zero.
+inline bool ChecksFailed = false;
+
+// One result line: serial and parallel times and whether the outputs match.
+inline void PrintComparison(const char *name, double serialMs,
+                            double parallelMs, bool identical) {
+  ChecksFailed |= !identical;
+  std::printf("%-28s %10.2f ms %10.2f ms %7.2fx  %s\n", name, serialMs,
+              parallelMs, serialMs / parallelMs,
+              identical ? "identical" : "MISMATCH");
+}
+
+void RunTessellationBenchmark();
+void RunObjBenchmark();
+void RunNormalsBenchmark();
+void RunClothBenchmark();
+void RunSelfCollisionBenchmark();
+void RunColliderBenchmark();
+void RunDistanceFieldBenchmark();
+void RunSchedulerBenchmark();
+void RunStateBuffersBenchmark();
@@ -0,0 +1,122 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cpu_cloth.h"
+#include "../geometry_generator.h"
+#include "../simd.h"
+#include "benchmark.h"
+#include <string>
+
+using namespace DirectX;
+
+namespace {
+constexpr int Steps = 10;
+constexpr float StepTime = 1.0f / 60.0f;
+
+// A grid hanging from the two corners of its first row.
+CpuCloth MakeCloth(const GeometryGenerator::MeshData &grid, std::uint32_t n,
+                   const CpuCloth::Settings &settings) {
+  std::vector<XMFLOAT3> positions;
+  for (auto &vertex : grid.Vertices) {
+    positions.push_back(vertex.Position);
+  }
+  CpuCloth cloth(positions, grid.Indices32, settings);
+  cloth.SetInverseMass(0, 0.0f);
+  cloth.SetInverseMass(n - 1, 0.0f);
+  return cloth;
+}
+
+CpuCloth MakeCloth(const GeometryGenerator::MeshData &grid, std::uint32_t n,
+                   CpuCloth::Kernel kernels) {
+  CpuCloth::Settings settings;
+  settings.Kernels = kernels;
+  return MakeCloth(grid, n, settings);
+}
+
+// Longest edge along the grid rows relative to its rest length, where the
+// cloth is least converged.
+float MaxStretch(const CpuCloth &cloth, std::uint32_t n) {
+  float rest = 1.0f / (float)(n - 1), stretch = 0.0f;
+  for (std::uint32_t i = 0; i < n; i++) {
+    for (std::uint32_t j = 0; j + 1 < n; j++) {
+      auto a = cloth.Position(i * n + j), b = cloth.Position(i * n + j + 1);
+      XMVECTOR d = XMLoadFloat3(&b) - XMLoadFloat3(&a);
+      stretch = std::max(stretch, XMVectorGetX(XMVector3Length(d)) / rest);
+    }
+  }
+  return stretch;
+}
+
+bool Identical(const CpuCloth &a, const CpuCloth &b) {
+  for (size_t p = 0; p < a.ParticleCount(); p++) {
+    auto pa = a.Position(p), pb = b.Position(p);
+    if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+void RunClothBenchmark() {
+  GeometryGenerator geoGen;
+  auto &pool = ThreadPool::Shared();
+  CpuCloth::Settings defaults;
+  std::printf("simd width %zu, %d steps of %d substeps x %d iterations\n",
+              Simd::Width, Steps, defaults.Substeps, defaults.Iterations);
+
+  for (std::uint32_t n : {64, 128, 256, 512}) {
+    auto grid = geoGen.CreateGrid(1.0f, 1.0f, n, n);
+    auto scalar = MakeCloth(grid, n, CpuCloth::Kernel::Scalar);
+    auto simd = MakeCloth(grid, n, CpuCloth::Kernel::Simd);
+    auto parallel = MakeCloth(grid, n, CpuCloth::Kernel::Simd);
+
+    auto run = [](CpuCloth &cloth, ThreadPool *clothPool) {
+      for (int i = 0; i < Steps; i++) {
+        cloth.Execute(StepTime, clothPool);
+      }
+    };
+    auto scalarMs = MeasureMilliseconds([&]() { run(scalar, nullptr); });
+    auto simdMs = MeasureMilliseconds([&]() { run(simd, nullptr); });
+    auto parallelMs = MeasureMilliseconds([&]() { run(parallel, &pool); });
+
+    auto size = std::to_string(n) + "x" + std::to_string(n);
+    PrintComparison(("scalar vs simd " + size).c_str(), scalarMs, simdMs,
+                    Identical(scalar, simd));
+    PrintComparison(("simd vs parallel " + size).c_str(), simdMs, parallelMs,
+                    Identical(simd, parallel));
+
+    // Particles times iterations, the unit cloth solvers are budgeted in.
+    auto work = (double)simd.ParticleCount() * defaults.Substeps *
+                defaults.Iterations * Steps;
+    std::printf("%-28s %10.1f M particle-iterations/s, %zu colors\n",
+                size.c_str(), work / parallelMs / 1e3, simd.ColorCount());
+  }
+
+  // The same solver budget spent on substeps or on iterations, after two
+  // seconds of hanging.
+  const std::uint32_t n = 64;
+  auto grid = geoGen.CreateGrid(1.0f, 1.0f, n, n);
+  struct Split {
+    int Substeps, Iterations;
+  };
+  for (auto split : {Split{1, 8}, Split{1, 32}, Split{2, 2}, Split{4, 2},
+                     Split{8, 1}}) {
+    auto settings = defaults;
+    settings.Substeps = split.Substeps;
+    settings.Iterations = split.Iterations;
+    auto cloth = MakeCloth(grid, n, settings);
+    auto ms = MeasureMilliseconds(
+        [&]() {
+          for (int i = 0; i < 120; i++) {
+            cloth.Execute(StepTime, &pool);
+          }
+        },
+        1);
+    auto name = std::to_string(split.Substeps) + " substeps x " +
+                std::to_string(split.Iterations) + " iterations";
+    std::printf("%-28s %10.2f ms   max stretch %.3f\n", name.c_str(), ms,
+                MaxStretch(cloth, n));
+  }
+}
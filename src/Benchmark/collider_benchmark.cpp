@@ -0,0 +1,157 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cloth_colliders.h"
+#include "../cpu_cloth.h"
+#include "../geometry_generator.h"
+#include "../mesh_bounds.h"
+#include "../simd.h"
+#include "benchmark.h"
+#include <random>
+#include <string>
+
+using namespace DirectX;
+
+namespace {
+constexpr float StepTime = 1.0f / 60.0f;
+
+// The obstacles of the PBR scene: its floor, box, columns and the spheres
+// resting on them.
+ClothColliders MakeScene() {
+  ClothColliders colliders;
+  colliders.AddGrid(XMMatrixIdentity(), 20.0f, 30.0f);
+  colliders.AddBox(XMMatrixScaling(2.0f, 2.0f, 2.0f) *
+                       XMMatrixTranslation(0.0f, 0.5f, 0.0f),
+                   1.5f, 0.5f, 1.5f);
+  for (int i = 0; i < 5; i++) {
+    for (float x : {-5.0f, 5.0f}) {
+      float z = -10.0f + (float)i * 5.0f;
+      colliders.AddCylinder(XMMatrixTranslation(x, 1.5f, z), 0.5f, 0.3f,
+                            3.0f);
+      colliders.AddSphere(XMMatrixTranslation(x, 3.5f, z), 0.5f);
+    }
+  }
+  return colliders;
+}
+
+struct Particles {
+  std::vector<float> X, Y, Z, InverseMass;
+};
+
+// count particles scattered over the scene, padded to whole vectors.
+Particles Scatter(size_t count) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> x(-10.0f, 10.0f), y(-0.5f, 5.0f),
+      z(-15.0f, 15.0f);
+  Particles particles;
+  auto padded = Simd::Padded(count);
+  particles.InverseMass.assign(padded, 0.0f);
+  for (size_t p = 0; p < padded; p++) {
+    particles.X.push_back(x(random));
+    particles.Y.push_back(y(random));
+    particles.Z.push_back(z(random));
+    particles.InverseMass[p] = p < count ? 1.0f : 0.0f;
+  }
+  return particles;
+}
+
+// Deepest a particle of the cloth is inside a collider, found as the
+// farthest Resolve moves a particle with no margin.
+float MaxPenetration(const CpuCloth &cloth, const ClothColliders &colliders) {
+  Particles particles;
+  auto padded = Simd::Padded(cloth.ParticleCount());
+  particles.InverseMass.assign(padded, 0.0f);
+  for (size_t p = 0; p < padded; p++) {
+    auto position = p < cloth.ParticleCount() ? cloth.Position(p)
+                                              : XMFLOAT3(0.0f, 0.0f, 0.0f);
+    particles.X.push_back(position.x);
+    particles.Y.push_back(position.y);
+    particles.Z.push_back(position.z);
+    particles.InverseMass[p] = p < cloth.ParticleCount() ? 1.0f : 0.0f;
+  }
+  auto resolved = particles;
+  ClothColliders::Selection all;
+  colliders.Cull(BoundingBox({0.0f, 0.0f, 0.0f}, {1e9f, 1e9f, 1e9f}), 0.0f,
+                 all);
+  colliders.Resolve(all, 0.0f, resolved.X.data(), resolved.Y.data(),
+                    resolved.Z.data(), resolved.InverseMass.data(), 0, padded,
+                    true);
+
+  float deepest = 0.0f;
+  for (size_t p = 0; p < cloth.ParticleCount(); p++) {
+    float dx = resolved.X[p] - particles.X[p];
+    float dy = resolved.Y[p] - particles.Y[p];
+    float dz = resolved.Z[p] - particles.Z[p];
+    deepest = std::max(deepest, std::sqrt(dx * dx + dy * dy + dz * dz));
+  }
+  return deepest;
+}
+} // namespace
+
+void RunColliderBenchmark() {
+  auto colliders = MakeScene();
+  ClothColliders::Selection all;
+  colliders.Cull(BoundingBox({0.0f, 0.0f, 0.0f}, {1e9f, 1e9f, 1e9f}), 0.0f,
+                 all);
+
+  // The kernels alone: every particle against every collider.
+  const size_t count = 1 << 18;
+  auto scalar = Scatter(count), simd = scalar;
+  auto resolve = [&](Particles &particles, bool useSimd) {
+    colliders.Resolve(all, 0.005f, particles.X.data(), particles.Y.data(),
+                      particles.Z.data(), particles.InverseMass.data(), 0,
+                      particles.X.size(), useSimd);
+  };
+  auto scalarMs = MeasureMilliseconds([&]() { resolve(scalar, false); });
+  auto simdMs = MeasureMilliseconds([&]() { resolve(simd, true); });
+  bool identical = scalar.X == simd.X && scalar.Y == simd.Y &&
+                   scalar.Z == simd.Z;
+  PrintComparison("scalar vs simd colliders", scalarMs, simdMs, identical);
+  std::printf("%-28s %10.2f ns per particle-collider, %zu colliders\n",
+              ("simd width " + std::to_string(Simd::Width)).c_str(),
+              simdMs * 1e6 / (double)count / (double)colliders.Count(),
+              colliders.Count());
+
+  // A cloth dropped onto a column of the scene, selecting only the
+  // colliders its bounds reach.
+  GeometryGenerator geoGen;
+  auto &pool = ThreadPool::Shared();
+  for (std::uint32_t n : {64, 128, 256}) {
+    auto grid = geoGen.CreateGrid(4.0f, 4.0f, n, n);
+    std::vector<XMFLOAT3> positions;
+    for (auto &vertex : grid.Vertices) {
+      positions.push_back(
+          {vertex.Position.x - 5.0f, 4.2f, vertex.Position.z});
+    }
+    CpuCloth cloth(positions, grid.Indices32, {});
+    cloth.SetColliders(&colliders);
+
+    auto ms = MeasureMilliseconds(
+        [&]() {
+          for (int i = 0; i < 120; i++) {
+            cloth.Execute(StepTime, &pool);
+          }
+        },
+        1);
+
+    BoundingBox bounds;
+    BoundingSphere sphere;
+    std::vector<float> x, y, z;
+    for (size_t p = 0; p < cloth.ParticleCount(); p++) {
+      auto position = cloth.Position(p);
+      x.push_back(position.x);
+      y.push_back(position.y);
+      z.push_back(position.z);
+    }
+    MeshBounds::Compute(x.data(), y.data(), z.data(), x.size(), bounds,
+                        sphere);
+    ClothColliders::Selection nearby;
+    colliders.Cull(bounds, 0.0f, nearby);
+
+    auto size = std::to_string(n) + "x" + std::to_string(n) + " draped";
+    std::printf("%-28s %10.2f ms   %zu of %zu colliders, deepest %.2f mm\n",
+                size.c_str(), ms, nearby.Count(), colliders.Count(),
+                MaxPenetration(cloth, colliders) * 1e3f);
+  }
+}
@@ -0,0 +1,124 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cloth_colliders.h"
+#include "../distance_field.h"
+#include "../geometry_generator.h"
+#include "../simd.h"
+#include "benchmark.h"
+#include <cmath>
+#include <random>
+#include <string>
+
+using namespace DirectX;
+
+namespace {
+constexpr float Radius = 1.0f;
+
+struct Points {
+  std::vector<float> X, Y, Z, InverseMass;
+};
+
+// count points in the cube around the sphere, padded to whole vectors.
+Points Scatter(size_t count) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<float> coordinate(-1.2f * Radius,
+                                                   1.2f * Radius);
+  Points points;
+  for (size_t p = 0; p < Simd::Padded(count); p++) {
+    points.X.push_back(coordinate(random));
+    points.Y.push_back(coordinate(random));
+    points.Z.push_back(coordinate(random));
+    points.InverseMass.push_back(p < count ? 1.0f : 0.0f);
+  }
+  return points;
+}
+
+bool Identical(const DistanceField &a, const DistanceField &b,
+               const Points &points) {
+  for (size_t p = 0; p < points.X.size(); p++) {
+    XMFLOAT3 ga, gb;
+    float da = a.Sample(points.X[p], points.Y[p], points.Z[p], ga);
+    float db = b.Sample(points.X[p], points.Y[p], points.Z[p], gb);
+    if (da != db || ga.x != gb.x || ga.y != gb.y || ga.z != gb.z) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct Errors {
+  float Inside = 0.0f, Outside = 0.0f;
+};
+
+// Largest difference from the analytic distance to the sphere, which the
+// tessellated mesh only approximates to within its flattening.  Points
+// outside the nodes are clamped onto them, so they are measured apart from
+// the bake itself.
+Errors MaxError(const DistanceField &field, const Points &points) {
+  auto bounds = field.Bounds();
+  Errors errors;
+  for (size_t p = 0; p < points.X.size(); p++) {
+    XMFLOAT3 gradient;
+    float x = points.X[p], y = points.Y[p], z = points.Z[p];
+    float exact = std::sqrt(x * x + y * y + z * z) - Radius;
+    float error = std::abs(field.Sample(x, y, z, gradient) - exact);
+    bool inside = std::abs(x - bounds.Center.x) <= bounds.Extents.x &&
+                  std::abs(y - bounds.Center.y) <= bounds.Extents.y &&
+                  std::abs(z - bounds.Center.z) <= bounds.Extents.z;
+    auto &worst = inside ? errors.Inside : errors.Outside;
+    worst = std::max(worst, error);
+  }
+  return errors;
+}
+} // namespace
+
+void RunDistanceFieldBenchmark() {
+  GeometryGenerator geoGen;
+  auto &pool = ThreadPool::Shared();
+  auto points = Scatter(1 << 16);
+
+  for (std::uint32_t subdivisions : {3, 5}) {
+    auto mesh = geoGen.CreateGeosphere(Radius, subdivisions);
+    auto triangles = std::to_string(mesh.Indices32.size() / 3);
+    for (float cellSize : {0.05f, 0.02f}) {
+      DistanceField serial, parallel;
+      auto serialMs = MeasureMilliseconds(
+          [&]() {
+            serial = DistanceField::Bake(mesh.Vertices, mesh.Indices32,
+                                         cellSize);
+          },
+          1);
+      auto parallelMs = MeasureMilliseconds(
+          [&]() {
+            parallel = DistanceField::Bake(mesh.Vertices, mesh.Indices32,
+                                           cellSize, &pool);
+          },
+          1);
+      auto nodes = std::to_string(serial.SizeX()) + "^3";
+      PrintComparison(("bake " + triangles + " tris, " + nodes).c_str(),
+                      serialMs, parallelMs,
+                      Identical(serial, parallel, points));
+      auto errors = MaxError(serial, points);
+      std::printf("%-28s %10.2f mm max error, %.2f mm outside the nodes\n",
+                  "", errors.Inside * 1e3f, errors.Outside * 1e3f);
+
+      // Pushing particles out costs the same whatever the triangle count.
+      ClothColliders colliders;
+      colliders.AddField(XMMatrixIdentity(), parallel);
+      ClothColliders::Selection all;
+      colliders.Cull(BoundingBox({0.0f, 0.0f, 0.0f}, {1e9f, 1e9f, 1e9f}),
+                     0.0f, all);
+      auto moved = points;
+      auto resolveMs = MeasureMilliseconds([&]() {
+        moved = points;
+        colliders.Resolve(all, 0.005f, moved.X.data(), moved.Y.data(),
+                          moved.Z.data(), moved.InverseMass.data(), 0,
+                          moved.X.size(), true);
+      });
+      std::printf("%-28s %10.2f ns per particle\n", "",
+                  resolveMs * 1e6 / (double)points.X.size());
+    }
+  }
+}
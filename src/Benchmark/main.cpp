@@ -0,0 +1,43 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../thread_pool.h"
+#include "benchmark.h"
+#include <cstring>
+
+namespace {
+struct Benchmark {
+  const char *Name;
+  void (*Run)();
+};
+
+const Benchmark Benchmarks[] = {
+    {"tessellation", RunTessellationBenchmark},
+    {"obj", RunObjBenchmark},
+    {"normals", RunNormalsBenchmark},
+    {"cloth", RunClothBenchmark},
+    {"selfcollision", RunSelfCollisionBenchmark},
+    {"colliders", RunColliderBenchmark},
+    {"sdf", RunDistanceFieldBenchmark},
+    {"scheduler", RunSchedulerBenchmark},
+    {"statebuffers", RunStateBuffersBenchmark},
+};
+} // namespace
+
+// Runs every benchmark, or only those named on the command line.  Exits
+// non-zero if any of them found a wrong result.
+int main(int argc, char *argv[]) {
+  std::printf("%zu threads\n", ThreadPool::Shared().ThreadCount() + 1);
+  for (auto &benchmark : Benchmarks) {
+    bool selected = argc < 2;
+    for (int i = 1; i < argc; i++) {
+      selected |= std::strcmp(argv[i], benchmark.Name) == 0;
+    }
+    if (selected) {
+      std::printf("\n[%s]\n", benchmark.Name);
+      benchmark.Run();
+    }
+  }
+  return ChecksFailed ? 1 : 0;
+}
@@ -0,0 +1,65 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../geometry_generator.h"
+#include "../mesh_normals.h"
+#include "benchmark.h"
+#include <cstring>
+
+using namespace DirectX;
+
+namespace {
+using Vertex = GeometryGenerator::Vertex;
+
+MeshNormals::Stream<XMFLOAT3> Normals(std::vector<Vertex> &vertices) {
+  return {&vertices[0].Normal, sizeof(Vertex)};
+}
+
+bool Identical(const std::vector<Vertex> &a, const std::vector<Vertex> &b) {
+  return std::memcmp(a.data(), b.data(), a.size() * sizeof(Vertex)) == 0;
+}
+} // namespace
+
+void RunNormalsBenchmark() {
+  GeometryGenerator geoGen;
+  auto mesh = geoGen.CreateSphere(1.0f, 1024, 1024);
+  auto &pool = ThreadPool::Shared();
+
+  MeshNormals normals(mesh.Indices32, mesh.Vertices.size());
+  MeshNormals::Stream<const XMFLOAT3> positions{&mesh.Vertices[0].Position,
+                                                sizeof(Vertex)};
+  MeshNormals::Stream<const XMFLOAT2> texcoords{&mesh.Vertices[0].TexC,
+                                                sizeof(Vertex)};
+  auto serial = mesh.Vertices, parallel = mesh.Vertices;
+
+  auto serialMs = MeasureMilliseconds(
+      [&]() { normals.ComputeNormals(positions, Normals(serial)); });
+  auto parallelMs = MeasureMilliseconds(
+      [&]() { normals.ComputeNormals(positions, Normals(parallel), &pool); });
+  PrintComparison("normals sphere 1024x1024", serialMs, parallelMs,
+                  Identical(serial, parallel));
+
+  auto tangents = [&](std::vector<Vertex> &out, ThreadPool *tangentPool) {
+    normals.ComputeTangents(positions, {&out[0].Normal, sizeof(Vertex)},
+                            texcoords, {&out[0].TangentU, sizeof(Vertex)},
+                            {nullptr, 0}, tangentPool);
+  };
+  serialMs = MeasureMilliseconds([&]() { tangents(serial, nullptr); });
+  parallelMs = MeasureMilliseconds([&]() { tangents(parallel, &pool); });
+  PrintComparison("tangents sphere 1024x1024", serialMs, parallelMs,
+                  Identical(serial, parallel));
+
+  // A deformation touching one vertex in a hundred, against redoing all.
+  std::vector<MeshNormals::uint32> touched;
+  for (MeshNormals::uint32 v = 0; v < mesh.Vertices.size(); v += 100) {
+    touched.push_back(v);
+  }
+  auto fullMs = MeasureMilliseconds(
+      [&]() { normals.ComputeNormals(positions, Normals(serial), &pool); });
+  auto updateMs = MeasureMilliseconds([&]() {
+    normals.UpdateNormals(touched, positions, Normals(parallel), &pool);
+  });
+  PrintComparison("update 1% vs full", fullMs, updateMs,
+                  Identical(serial, parallel));
+}
@@ -0,0 +1,66 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../obj_parser.h"
+#include "benchmark.h"
+#include <cstring>
+#include <string>
+
+namespace {
+using Result = ObjParser::Result;
+
+bool Identical(const Result &a, const Result &b) {
+  return a.Vertices == b.Vertices && a.Normals == b.Normals &&
+         a.Texcoords == b.Texcoords &&
+         a.Indices.size() == b.Indices.size() &&
+         std::memcmp(a.Indices.data(), b.Indices.data(),
+                     a.Indices.size() * sizeof(ObjParser::Index)) == 0;
+}
+
+// An n x n vertex grid of quads, written the way exporters do: full v/vt/vn
+// triplets with six decimals.
+std::string GridObj(int n) {
+  std::string text;
+  // Room for the longest face line, twelve 11-character ints.
+  char line[256];
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      float u = (float)j / (n - 1), v = (float)i / (n - 1);
+      std::snprintf(line, sizeof(line),
+                    "v %f %f %f\nvt %f %f\nvn %f %f %f\n", u * 2.0f - 1.0f,
+                    0.01f * (i % 7), 1.0f - v * 2.0f, u, v, 0.0f, 1.0f, 0.0f);
+      text += line;
+    }
+  }
+  for (int i = 0; i + 1 < n; i++) {
+    for (int j = 0; j + 1 < n; j++) {
+      int a = i * n + j + 1, b = a + 1, c = a + n + 1, d = a + n;
+      std::snprintf(line, sizeof(line),
+                    "f %d/%d/%d %d/%d/%d %d/%d/%d %d/%d/%d\n", a, a, a, b, b,
+                    b, c, c, c, d, d, d);
+      text += line;
+    }
+  }
+  return text;
+}
+} // namespace
+
+void RunObjBenchmark() {
+  for (int n : {256, 1024}) {
+    auto text = GridObj(n);
+    auto bytes = std::as_bytes(std::span(text.data(), text.size()));
+
+    Result serial, parallel;
+    auto serialMs =
+        MeasureMilliseconds([&]() { serial = ObjParser::Parse(bytes); });
+    auto parallelMs = MeasureMilliseconds([&]() {
+      parallel = ObjParser::Parse(bytes, &ThreadPool::Shared());
+    });
+
+    char name[64];
+    std::snprintf(name, sizeof(name), "grid %dx%d (%.0f MB)", n, n,
+                  text.size() / 1e6);
+    PrintComparison(name, serialMs, parallelMs, Identical(serial, parallel));
+  }
+}
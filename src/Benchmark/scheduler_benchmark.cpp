@@ -0,0 +1,78 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cloth_scheduler.h"
+#include "../cpu_cloth.h"
+#include "../geometry_generator.h"
+#include "benchmark.h"
+#include <string>
+#include <vector>
+
+using namespace DirectX;
+
+namespace {
+constexpr std::uint32_t GridSize = 64;
+constexpr float Seconds = 2.0f;
+
+// A grid hanging from the two corners of its first row.
+CpuCloth MakeCloth() {
+  GeometryGenerator geoGen;
+  auto grid = geoGen.CreateGrid(1.0f, 1.0f, GridSize, GridSize);
+  std::vector<XMFLOAT3> positions;
+  for (auto &vertex : grid.Vertices) {
+    positions.push_back(vertex.Position);
+  }
+  CpuCloth cloth(positions, grid.Indices32, {});
+  cloth.SetInverseMass(0, 0.0f);
+  cloth.SetInverseMass(GridSize - 1, 0.0f);
+  return cloth;
+}
+
+struct Run {
+  const char *Name;
+  float FrameTime;
+  // One frame this long in the middle of the run, or 0.
+  float Hitch;
+};
+} // namespace
+
+void RunSchedulerBenchmark() {
+  auto &pool = ThreadPool::Shared();
+  std::vector<XMFLOAT3> positions(GridSize * GridSize);
+  const Run runs[] = {
+      {"144 Hz", 1.0f / 144.0f, 0.0f},
+      {"60 Hz", 1.0f / 60.0f, 0.0f},
+      {"30 Hz", 1.0f / 30.0f, 0.0f},
+      {"60 Hz, 500 ms hitch", 1.0f / 60.0f, 0.5f},
+  };
+
+  // The same simulated time at every frame rate costs the same steps; only
+  // a hitch beyond the cap loses time.
+  for (auto &run : runs) {
+    auto cloth = MakeCloth();
+    ClothScheduler scheduler;
+    int frames = (int)(Seconds / run.FrameTime), maxSteps = 0;
+    double frameMs = 0.0, worstFrameMs = 0.0;
+    for (int f = 0; f < frames; f++) {
+      float deltaTime =
+          run.Hitch > 0.0f && f == frames / 2 ? run.Hitch : run.FrameTime;
+      auto ms = MeasureMilliseconds(
+          [&]() {
+            scheduler.Advance(deltaTime, cloth, &pool);
+            scheduler.Interpolate(cloth, {positions.data(), sizeof(XMFLOAT3)});
+          },
+          1);
+      frameMs += ms;
+      worstFrameMs = std::max(worstFrameMs, ms);
+      maxSteps = std::max(maxSteps, scheduler.LastFrame().Steps);
+    }
+
+    auto &metrics = scheduler.LastFrame();
+    std::printf("%-28s %10.2f ms per frame, %.2f ms worst, %llu steps "
+                "(%d max), %.2f ms per step, %.0f ms dropped\n",
+                run.Name, frameMs / frames, worstFrameMs,
+                (unsigned long long)metrics.TotalSteps, maxSteps,
+                metrics.StepMilliseconds, metrics.DroppedSeconds * 1e3);
+  }
+}
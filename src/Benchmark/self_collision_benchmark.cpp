@@ -0,0 +1,86 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cpu_cloth.h"
+#include "../geometry_generator.h"
+#include "benchmark.h"
+#include <cmath>
+#include <string>
+
+using namespace DirectX;
+
+namespace {
+constexpr int Steps = 4;
+constexpr float StepTime = 1.0f / 60.0f;
+constexpr float Spacing = 0.01f;
+constexpr int Folds = 8;
+
+// A flat grid with 1 cm between particles, folded like an accordion into
+// layers closer than its thickness, so every layer is in contact with the
+// next.
+CpuCloth MakeFoldedCloth(std::uint32_t n, bool selfCollision) {
+  GeometryGenerator geoGen;
+  float width = Spacing * (float)(n - 1);
+  auto grid = geoGen.CreateGrid(width, width, n, n);
+  std::vector<XMFLOAT3> positions;
+  for (auto &vertex : grid.Vertices) {
+    positions.push_back(vertex.Position);
+  }
+
+  CpuCloth::Settings settings;
+  settings.Substeps = 1;
+  settings.Iterations = 1;
+  settings.SelfCollision = selfCollision;
+  settings.Thickness = 0.8f * Spacing;
+  CpuCloth cloth(positions, grid.Indices32, settings);
+
+  float layer = width / Folds, gap = 0.75f * settings.Thickness;
+  for (size_t p = 0; p < positions.size(); p++) {
+    float u = (positions[p].z / width + 0.5f) * Folds;
+    float fold = std::min<float>(std::floor(u), Folds - 1);
+    float t = u - fold;
+    float z = ((int)fold % 2 == 0 ? t : 1.0f - t) * layer;
+    cloth.SetPosition(p, {positions[p].x, fold * gap, z});
+  }
+  return cloth;
+}
+
+bool Identical(const CpuCloth &a, const CpuCloth &b) {
+  for (size_t p = 0; p < a.ParticleCount(); p++) {
+    auto pa = a.Position(p), pb = b.Position(p);
+    if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+void RunSelfCollisionBenchmark() {
+  auto &pool = ThreadPool::Shared();
+  for (std::uint32_t n : {32, 100, 317}) {
+    auto without = MakeFoldedCloth(n, false);
+    auto serial = MakeFoldedCloth(n, true);
+    auto parallel = MakeFoldedCloth(n, true);
+
+    auto run = [](CpuCloth &cloth, ThreadPool *clothPool) {
+      for (int i = 0; i < Steps; i++) {
+        cloth.Execute(StepTime, clothPool);
+      }
+    };
+    auto withoutMs = MeasureMilliseconds([&]() { run(without, &pool); });
+    auto serialMs = MeasureMilliseconds([&]() { run(serial, nullptr); });
+    auto parallelMs = MeasureMilliseconds([&]() { run(parallel, &pool); });
+
+    auto particles = std::to_string(serial.ParticleCount()) + " particles";
+    PrintComparison(("self collision " + particles).c_str(), serialMs,
+                    parallelMs, Identical(serial, parallel));
+
+    // What the collision pass adds to a step, per particle.
+    auto collisionNs = (parallelMs - withoutMs) * 1e6 / Steps /
+                       (double)serial.ParticleCount();
+    std::printf("%-28s %10.1f ns per particle per substep\n",
+                particles.c_str(), collisionNs);
+  }
+}
@@ -0,0 +1,61 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cloth_state_buffers.h"
+#include "benchmark.h"
+
+namespace {
+constexpr int Steps = 1000;
+constexpr std::uint32_t VertexCount = 128 * 128;
+} // namespace
+
+// Records a reset and a run of GPU cloth frames, each a step and a draw,
+// into the logging stand-in, which checks every transition against the
+// state its buffer is in, and counts what a frame costs in copies and
+// barriers.
+void RunStateBuffersBenchmark() {
+  ClothStateBuffers buffers;
+  RecordingClothCommands commands;
+  buffers.RecordReset(commands);
+  auto resetCommands = commands.Commands().size();
+  int written = buffers.Current();
+  bool drawable = true;
+  for (int i = 0; i < Steps; i++) {
+    buffers.RecordStep(commands, VertexCount);
+    buffers.RecordPrepareForDraw(commands);
+    drawable &= buffers.State(buffers.Current()) ==
+                ClothBufferState::VertexBuffer;
+  }
+
+  size_t copies = 0, barrierCalls = 0, transitions = 0, dispatches = 0;
+  bool alternates = true;
+  for (size_t i = resetCommands; i < commands.Commands().size(); i++) {
+    auto &command = commands.Commands()[i];
+    switch (command.Type) {
+    case RecordingClothCommands::Kind::Copy:
+      copies++;
+      break;
+    case RecordingClothCommands::Kind::Barrier:
+      barrierCalls++;
+      transitions += command.Transitions.size();
+      break;
+    case RecordingClothCommands::Kind::Dispatch:
+      // Each step reads what the one before wrote.
+      alternates &= command.Source == written;
+      written = command.Destination;
+      dispatches++;
+      break;
+    }
+  }
+
+  bool valid = commands.Valid() && alternates && drawable &&
+               dispatches == Steps && written == buffers.Current();
+  ChecksFailed |= !valid;
+  std::printf("%-28s %zu commands\n", "reset", resetCommands);
+  std::printf("%-28s %.2f copies, %.2f barrier calls, %.2f transitions, "
+              "%s\n",
+              "per step and draw", (double)copies / Steps,
+              (double)barrierCalls / Steps, (double)transitions / Steps,
+              valid ? "valid" : "INVALID");
+}
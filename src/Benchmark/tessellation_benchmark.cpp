@@ -0,0 +1,49 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../geometry_generator.h"
+#include "benchmark.h"
+#include <cstring>
+
+namespace {
+using MeshData = GeometryGenerator::MeshData;
+
+bool Identical(const MeshData &a, const MeshData &b) {
+  return a.Vertices.size() == b.Vertices.size() &&
+         a.Indices32 == b.Indices32 &&
+         std::memcmp(a.Vertices.data(), b.Vertices.data(),
+                     a.Vertices.size() * sizeof(GeometryGenerator::Vertex)) ==
+             0;
+}
+
+// create(pool) builds the mesh serially when pool is null.
+template <typename Create> void Compare(const char *name, Create create) {
+  MeshData serial, parallel;
+  auto serialMs = MeasureMilliseconds([&]() { serial = create(nullptr); });
+  auto parallelMs = MeasureMilliseconds(
+      [&]() { parallel = create(&ThreadPool::Shared()); });
+  PrintComparison(name, serialMs, parallelMs, Identical(serial, parallel));
+}
+} // namespace
+
+void RunTessellationBenchmark() {
+  GeometryGenerator geoGen;
+
+  Compare("grid 2048x2048", [&](ThreadPool *pool) {
+    return pool ? geoGen.CreateGrid(100.0f, 100.0f, 2048, 2048, *pool)
+                : geoGen.CreateGrid(100.0f, 100.0f, 2048, 2048);
+  });
+  Compare("sphere 1024x1024", [&](ThreadPool *pool) {
+    return pool ? geoGen.CreateSphere(1.0f, 1024, 1024, *pool)
+                : geoGen.CreateSphere(1.0f, 1024, 1024);
+  });
+  Compare("cylinder 1024x1024", [&](ThreadPool *pool) {
+    return pool ? geoGen.CreateCylinder(1.0f, 0.5f, 2.0f, 1024, 1024, *pool)
+                : geoGen.CreateCylinder(1.0f, 0.5f, 2.0f, 1024, 1024);
+  });
+  Compare("geosphere 6", [&](ThreadPool *pool) {
+    return pool ? geoGen.CreateGeosphere(1.0f, 6, *pool)
+                : geoGen.CreateGeosphere(1.0f, 6);
+  });
+}
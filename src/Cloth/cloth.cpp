@@ -6,26 +6,100 @@
 #include "../dx_utils.h"
 #include "frame_resource.h"
 
+namespace {
+D3D12_RESOURCE_STATES ToD3D12(ClothBufferState state)
+{
+  switch (state) {
+    case ClothBufferState::CopyDest:
+      return D3D12_RESOURCE_STATE_COPY_DEST;
+    case ClothBufferState::ShaderResource:
+      return D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE;
+    case ClothBufferState::UnorderedAccess:
+      return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
+    case ClothBufferState::VertexBuffer:
+      return D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER;
+    default:
+      return D3D12_RESOURCE_STATE_COMMON;
+  }
+}
+} // namespace
+
+// ClothCommands recorded into a D3D12 command list.
+class Cloth::Commands : public ClothCommands
+{
+public:
+  Commands(Cloth& cloth,
+           ID3D12GraphicsCommandList* cmdList,
+           ID3D12Resource* input = nullptr)
+    : Owner(cloth)
+    , CmdList(cmdList)
+    , Input(input)
+  {
+  }
+
+  void ResourceBarrier(std::span<const Transition> transitions) override
+  {
+    CD3DX12_RESOURCE_BARRIER barriers[ClothStateBuffers::Count];
+    for (size_t i = 0; i < transitions.size(); i++) {
+      auto& transition = transitions[i];
+      barriers[i] = CD3DX12_RESOURCE_BARRIER::Transition(
+        Owner.StateBuffers[transition.Buffer].Get(),
+        ToD3D12(transition.Before),
+        ToD3D12(transition.After));
+    }
+    CmdList->ResourceBarrier((UINT)transitions.size(), barriers);
+  }
+
+  void CopyInitialState(int buffer) override
+  {
+    CmdList->CopyResource(Owner.StateBuffers[buffer].Get(), Input);
+  }
+
+  void Dispatch(int source, int destination, uint32 groupCount) override
+  {
+    CmdList->SetComputeRootDescriptorTable(0, Owner.StateGpuSrv[source]);
+    CmdList->SetComputeRootDescriptorTable(1,
+                                           Owner.StateGpuUav[destination]);
+    CmdList->Dispatch(groupCount, 1, 1);
+  }
+
+private:
+  Cloth& Owner;
+  ID3D12GraphicsCommandList* CmdList;
+  ID3D12Resource* Input;
+};
+
 Cloth::Cloth(ID3D12Device* device, UINT vertexSize, DXGI_FORMAT format)
 {
+  Device = device;
   VertexSize = vertexSize;
   Format = format;
   BuildResources();
 }
 
-ID3D12Resource* Cloth::Output() const
+ID3D12Resource* Cloth::Output(ID3D12GraphicsCommandList* cmdList)
 {
-  return OutputVertexBuffer.Get();
+  Commands commands(*this, cmdList);
+  States.RecordPrepareForDraw(commands);
+  return StateBuffers[States.Current()].Get();
 }
 
 void Cloth::BuildDescriptors(CD3DX12_CPU_DESCRIPTOR_HANDLE cpuDescriptor,
                              CD3DX12_GPU_DESCRIPTOR_HANDLE gpuDescriptor,
                              UINT descriptorSize)
 {
-  InputVertexCpuSrv = cpuDescriptor;
-  OutputVertexCpuUav = cpuDescriptor.Offset(1, descriptorSize);
-  InputVertexGpuSrv = gpuDescriptor;
-  OutputVertexGpuUav = gpuDescriptor.Offset(1, descriptorSize);
+  for (int b = 0; b < ClothStateBuffers::Count; b++) {
+    StateCpuSrv[b] = cpuDescriptor;
+    StateGpuSrv[b] = gpuDescriptor;
+    cpuDescriptor.Offset(1, descriptorSize);
+    gpuDescriptor.Offset(1, descriptorSize);
+  }
+  for (int b = 0; b < ClothStateBuffers::Count; b++) {
+    StateCpuUav[b] = cpuDescriptor;
+    StateGpuUav[b] = gpuDescriptor;
+    cpuDescriptor.Offset(1, descriptorSize);
+    gpuDescriptor.Offset(1, descriptorSize);
+  }
 
   BuildDescriptors();
 }
@@ -56,46 +130,33 @@ void Cloth::BuildDescriptors()
                                         .CounterOffsetInBytes = 0,
                                         .Flags = D3D12_BUFFER_UAV_FLAG_NONE,
                                       } };
-  Device->CreateShaderResourceView(
-    InputVertexBuffer.Get(), &srvDesc, InputVertexCpuSrv);
-  Device->CreateUnorderedAccessView(
-    OutputVertexBuffer.Get(), nullptr, &uavDesc, OutputVertexCpuUav);
+  // Either buffer can be read or written, depending on the step.
+  for (int b = 0; b < ClothStateBuffers::Count; b++) {
+    Device->CreateShaderResourceView(
+      StateBuffers[b].Get(), &srvDesc, StateCpuSrv[b]);
+    Device->CreateUnorderedAccessView(
+      StateBuffers[b].Get(), nullptr, &uavDesc, StateCpuUav[b]);
+  }
+}
+
+void Cloth::Reset(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* input)
+{
+  Commands commands(*this, cmdList, input);
+  States.RecordReset(commands);
 }
 
 void Cloth::Execute(ID3D12GraphicsCommandList* cmdList,
                     ID3D12RootSignature* rootSig,
                     ID3D12PipelineState* pso,
-                    ID3D12Resource* input,
                     UINT vertexCount)
 {
   cmdList->SetComputeRootSignature(rootSig);
-  auto barrier =
-    CD3DX12_RESOURCE_BARRIER::Transition(InputVertexBuffer.Get(),
-                                         D3D12_RESOURCE_STATE_COMMON,
-                                         D3D12_RESOURCE_STATE_COPY_DEST);
-
-  // Copy input to input buffer
-  cmdList->ResourceBarrier(1, &barrier);
-  cmdList->CopyResource(InputVertexBuffer.Get(), input);
-
-  barrier =
-    CD3DX12_RESOURCE_BARRIER::Transition(InputVertexBuffer.Get(),
-                                         D3D12_RESOURCE_STATE_COPY_DEST,
-                                         D3D12_RESOURCE_STATE_GENERIC_READ);
-  cmdList->ResourceBarrier(1, &barrier);
-
-  barrier =
-    CD3DX12_RESOURCE_BARRIER::Transition(OutputVertexBuffer.Get(),
-                                         D3D12_RESOURCE_STATE_COMMON,
-                                         D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
-  cmdList->ResourceBarrier(1, &barrier);
-
   cmdList->SetPipelineState(pso);
-  cmdList->SetComputeRootDescriptorTable(0, InputVertexGpuSrv);
-  cmdList->SetComputeRootDescriptorTable(1, OutputVertexGpuUav);
 
-  UINT GroupSize = (UINT)ceilf(vertexCount / 64.0f);
-  cmdList->Dispatch(GroupSize, 1, 1);
+  // The states are tracked across calls, so the only barrier is the one
+  // swapping the buffers' roles.
+  Commands commands(*this, cmdList);
+  States.RecordStep(commands, vertexCount);
 }
 
 void Cloth::BuildResources()
@@ -113,18 +174,14 @@ void Cloth::BuildResources()
                          .Flags = D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS };
 
   auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
-  ThrowIfFailed(Device->CreateCommittedResource(
-    &heapProps,
-    D3D12_HEAP_FLAG_NONE,
-    &bufferDesc,
-    D3D12_RESOURCE_STATE_COMMON,
-    nullptr,
-    IID_PPV_ARGS(InputVertexBuffer.GetAddressOf())));
-  ThrowIfFailed(Device->CreateCommittedResource(
-    &heapProps,
-    D3D12_HEAP_FLAG_NONE,
-    &bufferDesc,
-    D3D12_RESOURCE_STATE_COMMON,
-    nullptr,
-    IID_PPV_ARGS(OutputVertexBuffer.GetAddressOf())));
+  // Created in COMMON, where ClothStateBuffers starts tracking them.
+  for (auto& buffer : StateBuffers) {
+    ThrowIfFailed(Device->CreateCommittedResource(
+      &heapProps,
+      D3D12_HEAP_FLAG_NONE,
+      &bufferDesc,
+      D3D12_RESOURCE_STATE_COMMON,
+      nullptr,
+      IID_PPV_ARGS(buffer.GetAddressOf())));
+  }
 }
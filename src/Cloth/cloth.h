@@ -4,39 +4,54 @@
 
 #pragma once
 
+#include "../cloth_state_buffers.h"
 #include "../stdafx.h"
 
+// The cloth simulated by a compute shader, its state in a ClothStateBuffers
+// pair: each step reads one buffer and writes the other, and Output is
+// whichever holds the latest state.
 class Cloth
 {
 public:
+  // A CPU and shader visible descriptor per buffer and role.
+  static constexpr UINT DescriptorCount = 2 * ClothStateBuffers::Count;
+
   Cloth(ID3D12Device* device, UINT vertexSize, DXGI_FORMAT format);
   Cloth(const Cloth& rhs) = delete;
   Cloth operator=(const Cloth& rhs) = delete;
 
-  ID3D12Resource* Output() const;
+  // The buffer holding the latest state, with the transition that makes it
+  // a vertex buffer recorded into cmdList.  Execute leaves it an unordered
+  // access target, so draws must go through this.
+  ID3D12Resource* Output(ID3D12GraphicsCommandList* cmdList);
+  // DescriptorCount descriptors from cpuDescriptor and gpuDescriptor on: the
+  // SRVs of the buffers, then their UAVs.
   void BuildDescriptors(CD3DX12_CPU_DESCRIPTOR_HANDLE cpuDescriptor,
                         CD3DX12_GPU_DESCRIPTOR_HANDLE gpuDescriptor,
                         UINT descriptorSize);
   void BuildDescriptors();
   void BuildResources();
 
+  // Starts the cloth from input's vertices.  Called once, not per step.
+  void Reset(ID3D12GraphicsCommandList* cmdList, ID3D12Resource* input);
+
   void Execute(ID3D12GraphicsCommandList* cmdList,
                ID3D12RootSignature* rootSig,
                ID3D12PipelineState* pso,
-               ID3D12Resource* input,
                UINT vertexCount);
 
 private:
+  class Commands;
+
   UINT VertexSize;
   DXGI_FORMAT Format;
 
   ComPtr<ID3D12Device> Device;
-  CD3DX12_CPU_DESCRIPTOR_HANDLE InputVertexCpuSrv;
-  CD3DX12_CPU_DESCRIPTOR_HANDLE OutputVertexCpuUav;
-  CD3DX12_GPU_DESCRIPTOR_HANDLE InputVertexGpuSrv;
-  CD3DX12_GPU_DESCRIPTOR_HANDLE OutputVertexGpuUav;
-
-  ComPtr<ID3D12Resource> InputVertexBuffer = nullptr;
-  ComPtr<ID3D12Resource> InputVertexUploadBuffer = nullptr;
-  ComPtr<ID3D12Resource> OutputVertexBuffer = nullptr;
+  CD3DX12_CPU_DESCRIPTOR_HANDLE StateCpuSrv[ClothStateBuffers::Count];
+  CD3DX12_CPU_DESCRIPTOR_HANDLE StateCpuUav[ClothStateBuffers::Count];
+  CD3DX12_GPU_DESCRIPTOR_HANDLE StateGpuSrv[ClothStateBuffers::Count];
+  CD3DX12_GPU_DESCRIPTOR_HANDLE StateGpuUav[ClothStateBuffers::Count];
+
+  ComPtr<ID3D12Resource> StateBuffers[ClothStateBuffers::Count];
+  ClothStateBuffers States;
 };
@@ -3,64 +3,462 @@
 //
 
 #include "cloth_renderer.h"
-#include <iostream>
+#include "../geometry_arena.h"
+#include "../mapped_upload_buffer.h"
+#include "../mesh_normals.h"
+#include "../mesh_optimizer.h"
+#include "../mesh_simplifier.h"
+#include "../mesh_welder.h"
+#include "../obj_parser.h"
 #include <stdexcept>
-#include <tiny_obj_loader.h>
+
+using namespace DirectX;
 
 void ClothRenderer::InitDirectX(const InitInfo& initInfo)
 {
   Renderer::InitDirectX(initInfo);
 
-  LoadCloth();
+  ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
+
+  Assets = std::make_unique<AssetLoader>(device.Get(), commandQueue.Get());
+  RequestCloth();
   CreateRootSignature();
   CreateClothRootSignature();
   CreateDescriptorHeaps();
   CreateShadersAndInputLayout();
+  CreateShapeGeometry();
   CreateRenderItems();
   CreateFrameResources();
   CreatePSOs();
+
+  ThrowIfFailed(commandList->Close());
+  ID3D12CommandList* cmdsLists[] = { commandList.Get() };
+  commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+
+  FlushCommandQueue();
+}
+void ClothRenderer::OnResize(UINT width, UINT height)
+{
+  Renderer::OnResize(width, height);
 }
-void ClothRenderer::OnResize(UINT width, UINT height) {}
-void ClothRenderer::Update(const GameTimer& timer) {}
-void ClothRenderer::Draw(const GameTimer& timer) {}
 
-void ClothRenderer::LoadCloth()
+void ClothRenderer::Update(const GameTimer& timer)
 {
-  std::string inputfile = MODEL_DIR "/cloth.obj";
-  tinyobj::ObjReaderConfig reader_config;
-  reader_config.mtl_search_path = "./";
-  tinyobj::ObjReader reader;
+  CurrentFrameResourceIndex =
+    (CurrentFrameResourceIndex + 1) % FrameResourceCount;
+  CurrentFrameResource = FrameResources[CurrentFrameResourceIndex].get();
+
+  if (CurrentFrameResource->Fence != 0 &&
+      fence->GetCompletedValue() < CurrentFrameResource->Fence) {
+    WaitForFence(CurrentFrameResource->Fence);
+  }
+
+  Assets->Pump();
+
+  if (!ClothState && ClothGeometry.Ready()) {
+    CreateClothState();
+  }
+  if (ClothState) {
+    // Steps are fixed, so the cloth neither speeds up nor stiffens with
+    // the frame rate.
+    auto& pool = ThreadPool::Shared();
+    Scheduler.Advance(timer.DeltaTime(), *ClothState, &pool);
+    Scheduler.Interpolate(*ClothState,
+                          { ClothPositions.data(), sizeof(XMFLOAT3) });
+    UpdateClothVertices();
+  }
+  UpdateObjectConstants();
+  UpdatePassConstants(timer);
+}
+
+void ClothRenderer::Draw(const GameTimer& timer)
+{
+  auto cmdListAllocator = CurrentFrameResource->CommandAllocator;
+  ThrowIfFailed(cmdListAllocator->Reset());
+  ThrowIfFailed(
+    commandList->Reset(cmdListAllocator.Get(), PSOs["main"].Get()));
+
+  commandList->RSSetViewports(1, &viewport);
+  commandList->RSSetScissorRects(1, &scissorRect);
+
+  auto barrier =
+    CD3DX12_RESOURCE_BARRIER::Transition(CurrentBackBuffer(),
+                                         D3D12_RESOURCE_STATE_PRESENT,
+                                         D3D12_RESOURCE_STATE_RENDER_TARGET);
+  commandList->ResourceBarrier(1, &barrier);
+
+  commandList->ClearRenderTargetView(
+    CurrentBackBufferView(), Colors::LightSteelBlue, 0, nullptr);
+  commandList->ClearDepthStencilView(
+    DepthStencilView(),
+    D3D12_CLEAR_FLAG_DEPTH | D3D12_CLEAR_FLAG_STENCIL,
+    1.0f,
+    0,
+    0,
+    nullptr);
+
+  auto currentBackBufferView = CurrentBackBufferView();
+  auto depthStencilView = DepthStencilView();
+  commandList->OMSetRenderTargets(
+    1, &currentBackBufferView, true, &depthStencilView);
+
+  commandList->SetGraphicsRootSignature(RootSignature.Get());
+  commandList->SetGraphicsRootConstantBufferView(
+    1,
+    CurrentFrameResource->PassConstantsBuffer->Resource()
+      ->GetGPUVirtualAddress());
+
+  DrawRenderItems(ShapeItems);
+
+  // Nothing more to draw until the cloth has loaded.
+  if (ClothState) {
+    UINT objCBByteSize =
+      DXUtils::CalcConstantBufferSize(sizeof(ObjectConstants));
+    auto objectCB = CurrentFrameResource->ObjectConstantsBuffer->Resource();
+    commandList->SetGraphicsRootConstantBufferView(
+      0,
+      objectCB->GetGPUVirtualAddress() +
+        ClothItem->ObjectCBIndex * objCBByteSize);
+
+    // The vertices come from this frame's upload memory; the indices from
+    // the loaded geometry.
+    auto& vertices = CurrentFrameResource->ClothVertices;
+    auto vertexBufferView = D3D12_VERTEX_BUFFER_VIEW{
+      .BufferLocation =
+        CurrentFrameResource->ClothVertexBuffer->Resource()
+          ->GetGPUVirtualAddress() +
+        vertices.Offset,
+      .SizeInBytes = (UINT)vertices.ByteSize,
+      .StrideInBytes = sizeof(Vertex),
+    };
+    auto indexBufferView = ClothItem->Geometry->IndexBufferView();
+    commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+    commandList->IASetIndexBuffer(&indexBufferView);
+    commandList->IASetPrimitiveTopology(ClothItem->PrimitiveType);
+    commandList->DrawIndexedInstanced(ClothItem->IndexCount,
+                                      1,
+                                      ClothItem->StartIndexLocation,
+                                      ClothItem->BaseVertexLocation,
+                                      0);
+  }
+
+  barrier =
+    CD3DX12_RESOURCE_BARRIER::Transition(CurrentBackBuffer(),
+                                         D3D12_RESOURCE_STATE_RENDER_TARGET,
+                                         D3D12_RESOURCE_STATE_PRESENT);
+  commandList->ResourceBarrier(1, &barrier);
+
+  ThrowIfFailed(commandList->Close());
+  ID3D12CommandList* cmdsLists[] = { commandList.Get() };
+  commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
+
+  ThrowIfFailed(swapChain->Present(0, 0));
+  currentBackBufferIndex = (currentBackBufferIndex + 1) % swapChainBufferCount;
+
+  CurrentFrameResource->Fence = ++fenceValue;
+  commandQueue->Signal(fence.Get(), fenceValue);
+}
+
+void ClothRenderer::DrawRenderItems(const std::vector<RenderItem*>& items)
+{
+  UINT objCBByteSize =
+    DXUtils::CalcConstantBufferSize(sizeof(ObjectConstants));
+  auto objectCB = CurrentFrameResource->ObjectConstantsBuffer->Resource();
+
+  for (auto item : items) {
+    auto vertexBufferView = item->Geometry->VertexBufferView();
+    auto indexBufferView = item->Geometry->IndexBufferView();
+    commandList->IASetVertexBuffers(0, 1, &vertexBufferView);
+    commandList->IASetIndexBuffer(&indexBufferView);
+    commandList->IASetPrimitiveTopology(item->PrimitiveType);
+    commandList->SetGraphicsRootConstantBufferView(
+      0,
+      objectCB->GetGPUVirtualAddress() + item->ObjectCBIndex * objCBByteSize);
+    commandList->DrawIndexedInstanced(item->IndexCount,
+                                      1,
+                                      item->StartIndexLocation,
+                                      item->BaseVertexLocation,
+                                      0);
+  }
+}
+
+void ClothRenderer::UpdateClothVertices()
+{
+  ClothNormals->ComputeNormals({ ClothPositions.data(), sizeof(XMFLOAT3) },
+                               { ClothVertexNormals.data(), sizeof(XMFLOAT3) },
+                               &ThreadPool::Shared());
+
+  // Upload memory is write-combined, so it is written once, in order, and
+  // never read back.
+  auto vertices = CurrentFrameResource->ClothVertices.As<Vertex>();
+  for (size_t i = 0; i < vertices.size(); i++) {
+    vertices[i] = { ClothPositions[i], ClothVertexNormals[i] };
+  }
+}
+
+void ClothRenderer::UpdateObjectConstants()
+{
+  auto objectCB = CurrentFrameResource->ObjectConstantsBuffer.get();
+  for (auto& item : AllRenderItems) {
+    if (item->NumberFramesDirty > 0) {
+      ObjectConstants constants;
+      XMStoreFloat4x4(&constants.World,
+                      XMMatrixTranspose(XMLoadFloat4x4(&item->World)));
+      objectCB->CopyData(item->ObjectCBIndex, constants);
+      item->NumberFramesDirty--;
+    }
+  }
+}
+
+void ClothRenderer::UpdatePassConstants(const GameTimer& timer)
+{
+  // A fixed view of the cloth hanging from its far edge.
+  XMVECTOR eye = XMVectorSet(3.0f, 0.5f, 4.5f, 1.0f);
+  XMVECTOR target = XMVectorSet(0.0f, -0.8f, 0.5f, 1.0f);
+  XMVECTOR up = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  XMMATRIX view = XMMatrixLookAtLH(eye, target, up);
+  XMMATRIX proj = XMMatrixPerspectiveFovLH(
+    0.25f * (float)MathHelper::PI, AspectRatio(), 0.1f, 100.0f);
+  XMMATRIX viewProj = XMMatrixMultiply(view, proj);
+
+  XMStoreFloat4x4(&MainPassCB.View, XMMatrixTranspose(view));
+  XMStoreFloat4x4(&MainPassCB.InvView,
+                  XMMatrixTranspose(XMMatrixInverse(nullptr, view)));
+  XMStoreFloat4x4(&MainPassCB.Proj, XMMatrixTranspose(proj));
+  XMStoreFloat4x4(&MainPassCB.InvProj,
+                  XMMatrixTranspose(XMMatrixInverse(nullptr, proj)));
+  XMStoreFloat4x4(&MainPassCB.ViewProj, XMMatrixTranspose(viewProj));
+  XMStoreFloat4x4(&MainPassCB.InvViewProj,
+                  XMMatrixTranspose(XMMatrixInverse(nullptr, viewProj)));
+  XMStoreFloat3(&MainPassCB.EyePosW, eye);
+  MainPassCB.RenderTargetSize = XMFLOAT2((float)Width, (float)Height);
+  MainPassCB.InvRenderTargetSize = XMFLOAT2(1.0f / Width, 1.0f / Height);
+  MainPassCB.NearZ = 0.1f;
+  MainPassCB.FarZ = 100.0f;
+  MainPassCB.TotalTime = timer.TotalTime();
+  MainPassCB.DeltaTime = timer.DeltaTime();
+
+  CurrentFrameResource->PassConstantsBuffer->CopyData(0, MainPassCB);
+}
 
-  if (!reader.ParseFromFile(inputfile, reader_config)) {
-    if (!reader.Error().empty()) {
-      throw(std::runtime_error("TinyObjReader: " + reader.Error()));
+void ClothRenderer::RequestCloth()
+{
+  // Importing or mapping the mesh and writing it to upload memory happen on
+  // a worker; only the copy commands are recorded on this thread.
+  ClothGeometry = Assets->Load<MeshGeometry>(
+    [this]() {
+      LoadCloth();
+      return StageClothGeometry();
+    },
+    [this](StagedGeometry& staged, AssetLoader::UploadContext& context) {
+      return CreateClothGeometry(staged, context);
+    });
+}
+
+void ClothRenderer::CreateClothState()
+{
+  auto vertices = ClothMesh.VerticesAs<Vertex>();
+  ClothPositions.resize(vertices.size());
+  ClothVertexNormals.resize(vertices.size());
+  for (size_t i = 0; i < vertices.size(); i++) {
+    ClothPositions[i] = vertices[i].Pos;
+  }
+  // The index buffer holds every LOD; the full detail one comes first.
+  auto indices = ClothMesh.Indices;
+  if (!ClothMesh.Submeshes.empty()) {
+    indices = indices.first(ClothMesh.Submeshes[0].IndexCount);
+  }
+  ClothState = std::make_unique<CpuCloth>(
+    ClothPositions, indices, CpuCloth::Settings());
+  ClothState->SetColliders(&Colliders);
+  ClothNormals = std::make_unique<MeshNormals>(
+    std::vector<std::uint32_t>(indices.begin(), indices.end()),
+    vertices.size());
+
+  // The mesh lies flat, so it is hung from the vertices along its far edge
+  // and swings down from there.
+  auto& bounds = ClothMesh.Bounds;
+  float edge = bounds.Center.z + bounds.Extents.z;
+  float tolerance = 0.01f * bounds.Extents.z;
+  for (size_t i = 0; i < ClothPositions.size(); i++) {
+    if (ClothPositions[i].z >= edge - tolerance) {
+      ClothState->SetInverseMass(i, 0.0f);
     }
   }
 
-  if (!reader.Warning().empty()) {
-    std::cout << "TinyObjReader: " << reader.Warning();
+  // Each frame in flight writes its own copy of the vertices.
+  auto byteSize = vertices.size() * sizeof(Vertex);
+  for (auto& frame : FrameResources) {
+    frame->ClothVertexBuffer =
+      std::make_unique<MappedUploadBuffer>(device.Get(), byteSize);
+    frame->ClothVertices = frame->ClothVertexBuffer->Allocate(byteSize);
   }
 
-  auto& attrib = reader.GetAttrib();
-  auto& shapes = reader.GetShapes();
-  auto& materials = reader.GetMaterials();
+  auto geometry = ClothGeometry.Get();
+  auto& lod0 = geometry->DrawArgs[MeshSimplifier::LodName("cloth", 0)];
+  ClothItem->Geometry = geometry;
+  ClothItem->IndexCount = lod0.IndexCount;
+  ClothItem->StartIndexLocation = lod0.StartIndexLocation;
+  ClothItem->BaseVertexLocation = lod0.BaseVertexLocation;
+}
 
-  assert(shapes.size() == 1);
+// Bumped whenever ImportCloth changes what it produces, so caches written by
+// an older import are rebuilt.
+static constexpr std::uint64_t ClothImportVersion = 2;
 
-  Vertecies.reserve(shapes[0].mesh.indices.size() / 3);
-  for (const auto& index : shapes[0].mesh.indices) {
-    Vertex vertex;
+void ClothRenderer::LoadCloth()
+{
+  std::string inputfile = MODEL_DIR "/cloth.obj";
+  std::string cachefile = inputfile + ".meshcache";
 
-    vertex.Pos.x = attrib.vertices[3 * index.vertex_index + 0];
-    vertex.Pos.y = attrib.vertices[3 * index.vertex_index + 1];
-    vertex.Pos.z = attrib.vertices[3 * index.vertex_index + 2];
+  MappedFile source;
+  if (!source.Open(inputfile)) {
+    throw(std::runtime_error("LoadCloth: cannot open " + inputfile));
+  }
+  auto sourceHash = MeshCache::Hash(source.Bytes()) ^ ClothImportVersion;
 
-    vertex.Normal.x = attrib.normals[3 * index.normal_index + 0];
-    vertex.Normal.y = attrib.normals[3 * index.normal_index + 1];
-    vertex.Normal.z = attrib.normals[3 * index.normal_index + 2];
+  if (ClothCache.Load(cachefile, sourceHash, sizeof(Vertex))) {
+    ClothMesh = ClothCache.Get();
+    return;
+  }
+
+  ImportCloth(source);
+
+  ClothMesh.Vertices = std::as_bytes(std::span(Vertecies));
+  ClothMesh.VertexStride = sizeof(Vertex);
+  ClothMesh.Indices = Indices;
+  ClothMesh.Submeshes = ClothSubmeshes;
+  MeshBounds::Compute(&Vertecies[0].Pos,
+                      Vertecies.size(),
+                      sizeof(Vertex),
+                      ClothMesh.Bounds,
+                      ClothMesh.SphereBounds);
+
+  // Later launches map the cache instead.  Without one this launch still
+  // works from the imported arrays.
+  if (MeshCache::Write(cachefile, sourceHash, ClothMesh) &&
+      ClothCache.Load(cachefile, sourceHash, sizeof(Vertex))) {
+    ClothMesh = ClothCache.Get();
+    Vertecies = {};
+    Indices = {};
+    ClothSubmeshes = {};
+  } else {
+    ::OutputDebugStringA(
+      ("LoadCloth: cannot write " + cachefile + "\n").c_str());
+  }
+}
+
+void ClothRenderer::ImportCloth(const MappedFile& source)
+{
+  auto obj = ObjParser::Parse(source.Bytes(), &ThreadPool::Shared());
+
+  // One vertex per distinct position and normal rather than per face
+  // corner.  The cloth vertex has no texture coordinates, so UV seams do not
+  // split it.
+  std::vector<ObjParser::Index> welded;
+  MeshWelder::WeldCorners(
+    obj, { .KeepTexcoordSeams = false }, welded, Indices);
+
+  bool hasNormals = true;
+  Vertecies.reserve(welded.size());
+  for (const auto& index : welded) {
+    Vertex vertex = {};
+
+    vertex.Pos.x = obj.Vertices[3 * index.VertexIndex + 0];
+    vertex.Pos.y = obj.Vertices[3 * index.VertexIndex + 1];
+    vertex.Pos.z = obj.Vertices[3 * index.VertexIndex + 2];
+
+    if (index.NormalIndex >= 0) {
+      vertex.Normal.x = obj.Normals[3 * index.NormalIndex + 0];
+      vertex.Normal.y = obj.Normals[3 * index.NormalIndex + 1];
+      vertex.Normal.z = obj.Normals[3 * index.NormalIndex + 2];
+    } else {
+      hasNormals = false;
+    }
 
     Vertecies.push_back(vertex);
   }
+
+  // Files exported without vn records get smooth normals instead.
+  if (!hasNormals) {
+    MeshNormals normals(Indices, Vertecies.size());
+    normals.ComputeNormals({ &Vertecies[0].Pos, sizeof(Vertex) },
+                           { &Vertecies[0].Normal, sizeof(Vertex) },
+                           &ThreadPool::Shared());
+  }
+
+  auto report = MeshOptimizer::Optimize(Vertecies, Indices);
+  ::OutputDebugStringA(MeshOptimizer::Describe("cloth", report).c_str());
+
+  auto lods = MeshSimplifier::BuildLodChain(Vertecies, Indices);
+  ::OutputDebugStringA(MeshSimplifier::Describe("cloth", lods).c_str());
+
+  // Every level draws from the same vertices.
+  for (auto& lod : lods) {
+    ClothSubmeshes.push_back({ .IndexCount = lod.IndexCount,
+                               .StartIndexLocation = lod.StartIndex,
+                               .BaseVertexLocation = 0,
+                               .LodError = lod.Error });
+  }
+}
+
+ClothRenderer::StagedGeometry ClothRenderer::StageClothGeometry()
+{
+  auto vertices = ClothMesh.VerticesAs<Vertex>();
+  auto& indices = ClothMesh.Indices;
+  const UINT vbByteSize = (UINT)vertices.size_bytes();
+  const UINT ibByteSize = (UINT)indices.size_bytes();
+
+  StagedGeometry staged;
+  staged.Geometry = std::make_unique<MeshGeometry>();
+  auto& geometry = *staged.Geometry;
+  geometry.Name = "clothGeo";
+
+  // Copy the mesh once, straight from the cache mapping into mapped upload
+  // memory.
+  staged.Upload = std::make_unique<MappedUploadBuffer>(
+    device.Get(), vbByteSize + ibByteSize + 16);
+  staged.Vertices = staged.Upload->Allocate(vbByteSize);
+  staged.Indices = staged.Upload->Allocate(ibByteSize);
+  std::copy(vertices.begin(),
+            vertices.end(),
+            staged.Vertices.As<Vertex>().begin());
+  std::copy(indices.begin(),
+            indices.end(),
+            staged.Indices.As<std::uint32_t>().begin());
+
+  geometry.VertexByteStride = sizeof(Vertex);
+  geometry.VertexBufferByteSize = vbByteSize;
+  geometry.IndexFormat = DXGI_FORMAT_R32_UINT;
+  geometry.IndexBufferByteSize = ibByteSize;
+
+  // Every level draws from the same vertices, so they share one set of
+  // bounds.
+  for (size_t i = 0; i < ClothMesh.Submeshes.size(); i++) {
+    auto& cached = ClothMesh.Submeshes[i];
+    SubmeshGeometry submesh;
+    submesh.IndexCount = cached.IndexCount;
+    submesh.StartIndexLocation = cached.StartIndexLocation;
+    submesh.BaseVertexLocation = cached.BaseVertexLocation;
+    submesh.LodError = cached.LodError;
+    submesh.Bounds = ClothMesh.Bounds;
+    submesh.SphereBounds = ClothMesh.SphereBounds;
+    geometry.DrawArgs[MeshSimplifier::LodName("cloth", i)] = submesh;
+  }
+  return staged;
+}
+
+std::unique_ptr<MeshGeometry> ClothRenderer::CreateClothGeometry(
+  StagedGeometry& staged,
+  AssetLoader::UploadContext& context)
+{
+  auto& upload = *staged.Upload;
+  staged.Geometry->VertexGPUBuffer = upload.CreateDefaultBuffer(
+    context.Device, context.CommandList, staged.Vertices);
+  staged.Geometry->IndexGPUBuffer = upload.CreateDefaultBuffer(
+    context.Device, context.CommandList, staged.Indices);
+  context.KeepAlive(upload.Resource());
+  return std::move(staged.Geometry);
 }
 
 void ClothRenderer::CreateRootSignature()
@@ -138,12 +536,16 @@ void ClothRenderer::CreateDescriptorHeaps()
 {
   auto srvHeapDesc = D3D12_DESCRIPTOR_HEAP_DESC{
     .Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
-    .NumDescriptors = 2,
+    .NumDescriptors = Cloth::DescriptorCount,
     .Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE,
   };
   ThrowIfFailed(
     device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&SrvUavCbvHeap)));
 
+  // The GPU simulator is not created yet; the CPU cloth is drawn instead.
+  if (!ClothSimulator) {
+    return;
+  }
   ClothSimulator->BuildDescriptors(
     CD3DX12_CPU_DESCRIPTOR_HANDLE(
       SrvUavCbvHeap->GetCPUDescriptorHandleForHeapStart(),
@@ -156,7 +558,64 @@ void ClothRenderer::CreateDescriptorHeaps()
     cbvUavDescriptorSize);
 }
 
-void ClothRenderer::CreateRenderItems() {}
+void ClothRenderer::CreateShapeGeometry()
+{
+  GeometryGenerator geoGen;
+  auto column = geoGen.CreateCylinder(0.2f, 0.2f, 1.2f, 20, 2);
+  ColumnField = DistanceField::Bake(
+    column.Vertices, column.Indices32, 0.02f, &ThreadPool::Shared());
+
+  GeometryArena arena;
+  arena.AddGrid("floor", 6.0f, 6.0f, 2, 2);
+  arena.AddSphere("sphere", 0.4f, 20, 20);
+  arena.Add("column", column);
+  auto geo = arena.Build<Vertex>(
+    "shapeGeo",
+    device.Get(),
+    commandList.Get(),
+    [](Vertex& out,
+       const GeometryGenerator::Vertex& in,
+       const SubmeshGeometry& submesh) {
+      out.Pos = in.Position;
+      out.Normal = in.Normal;
+    });
+  Geometries[geo->Name] = std::move(geo);
+}
+
+void ClothRenderer::CreateRenderItems()
+{
+  // Its geometry and draw arguments are filled in once the cloth loads.
+  auto cloth = std::make_unique<RenderItem>();
+  cloth->ObjectCBIndex = 0;
+  ClothItem = cloth.get();
+  AllRenderItems.push_back(std::move(cloth));
+
+  auto geo = Geometries["shapeGeo"].get();
+  auto addShape = [&](const std::string& name, FXMMATRIX world) {
+    auto item = std::make_unique<RenderItem>();
+    XMStoreFloat4x4(&item->World, world);
+    item->ObjectCBIndex = (UINT)AllRenderItems.size();
+    item->Geometry = geo;
+    item->IndexCount = geo->DrawArgs[name].IndexCount;
+    item->StartIndexLocation = geo->DrawArgs[name].StartIndexLocation;
+    item->BaseVertexLocation = geo->DrawArgs[name].BaseVertexLocation;
+    ShapeItems.push_back(item.get());
+    AllRenderItems.push_back(std::move(item));
+  };
+
+  // The cloth swings down from its far edge, at z = 1, onto a sphere and a
+  // column standing on the floor.
+  auto floorWorld = XMMatrixTranslation(0.0f, -1.6f, 0.0f);
+  auto sphereWorld = XMMatrixTranslation(-0.3f, -1.0f, 0.8f);
+  auto columnWorld = XMMatrixTranslation(0.5f, -1.0f, 0.8f);
+  addShape("floor", floorWorld);
+  addShape("sphere", sphereWorld);
+  addShape("column", columnWorld);
+
+  Colliders.AddGrid(floorWorld, 6.0f, 6.0f);
+  Colliders.AddSphere(sphereWorld, 0.4f);
+  Colliders.AddField(columnWorld, ColumnField);
+}
 
 void ClothRenderer::CreateFrameResources()
 {
@@ -172,29 +631,49 @@ void ClothRenderer::CreateShadersAndInputLayout()
     DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", nullptr, "VS", "vs_5_1");
   Shaders["mainPS"] =
     DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", nullptr, "PS", "ps_5_1");
-  Shaders["clothCS"] =
-    DXUtils::CompileShader(SHADER_DIR L"/cloth.hlsl", nullptr, "CS", "cs_5_0");
+  if (ClothSimulator) {
+    Shaders["clothCS"] = DXUtils::CompileShader(
+      SHADER_DIR L"/cloth.hlsl", nullptr, "CS", "cs_5_0");
+  }
 
-  InputLayouts = { D3D12_INPUT_ELEMENT_DESC{
-    .SemanticName = "INDEX",
-    .SemanticIndex = 0,
-    .Format = DXGI_FORMAT_R32_UINT,
-    .InputSlot = 0,
-    .AlignedByteOffset = 0,
-    .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-    .InstanceDataStepRate = 0,
-  } };
+  // The CPU cloth's vertices, see UpdateClothVertices.
+  InputLayouts = {
+    D3D12_INPUT_ELEMENT_DESC{
+      .SemanticName = "POSITION",
+      .SemanticIndex = 0,
+      .Format = DXGI_FORMAT_R32G32B32_FLOAT,
+      .InputSlot = 0,
+      .AlignedByteOffset = offsetof(Vertex, Pos),
+      .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+      .InstanceDataStepRate = 0,
+    },
+    D3D12_INPUT_ELEMENT_DESC{
+      .SemanticName = "NORMAL",
+      .SemanticIndex = 0,
+      .Format = DXGI_FORMAT_R32G32B32_FLOAT,
+      .InputSlot = 0,
+      .AlignedByteOffset = offsetof(Vertex, Normal),
+      .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+      .InstanceDataStepRate = 0,
+    },
+  };
 }
 
 void ClothRenderer::CreatePSOs()
 {
-  D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {
-    .pRootSignature = RootSignature.Get(),
-    .CS = CD3DX12_SHADER_BYTECODE(Shaders["ClothCS"].Get()),
-    .Flags = D3D12_PIPELINE_STATE_FLAG_NONE,
-  };
-  ThrowIfFailed(device->CreateComputePipelineState(
-    &computePsoDesc, IID_PPV_ARGS(PSOs["ClothCS"].GetAddressOf())));
+  if (ClothSimulator) {
+    D3D12_COMPUTE_PIPELINE_STATE_DESC computePsoDesc = {
+      .pRootSignature = ClothRootSignature.Get(),
+      .CS = CD3DX12_SHADER_BYTECODE(Shaders["clothCS"].Get()),
+      .Flags = D3D12_PIPELINE_STATE_FLAG_NONE,
+    };
+    ThrowIfFailed(device->CreateComputePipelineState(
+      &computePsoDesc, IID_PPV_ARGS(PSOs["ClothCS"].GetAddressOf())));
+  }
+
+  // The cloth is seen from both sides.
+  auto rasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+  rasterizerState.CullMode = D3D12_CULL_MODE_NONE;
 
   D3D12_GRAPHICS_PIPELINE_STATE_DESC mainPsoDesc = {
       .pRootSignature = RootSignature.Get(),
@@ -202,7 +681,7 @@ void ClothRenderer::CreatePSOs()
       .PS = CD3DX12_SHADER_BYTECODE(Shaders["mainPS"].Get()),
       .BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT),
       .SampleMask = UINT_MAX,
-      .RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT),
+      .RasterizerState = rasterizerState,
       .DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT),
       .InputLayout = { InputLayouts.data(), (UINT)InputLayouts.size() },
       .PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE,
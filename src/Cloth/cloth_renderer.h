@@ -4,6 +4,15 @@
 
 #pragma once
 
+#include "../asset_loader.h"
+#include "../cloth_colliders.h"
+#include "../cloth_scheduler.h"
+#include "../cpu_cloth.h"
+#include "../distance_field.h"
+#include "../mapped_upload_buffer.h"
+#include "../mesh_cache.h"
+#include "../mesh_normals.h"
+#include "../mesh_simplifier.h"
 #include "../renderer.h"
 #include "../stdafx.h"
 #include "cloth.h"
@@ -20,21 +29,74 @@ public:
   void Draw(const GameTimer& timer) override;
 
 protected:
+  // Cloth geometry written to upload memory, waiting for its copy to be
+  // recorded.
+  struct StagedGeometry
+  {
+    std::unique_ptr<MeshGeometry> Geometry;
+    std::unique_ptr<MappedUploadBuffer> Upload;
+    MappedUploadBuffer::Allocation Vertices;
+    MappedUploadBuffer::Allocation Indices;
+  };
+
+  void RequestCloth();
+  void CreateClothState();
   void LoadCloth();
+  void ImportCloth(const MappedFile& source);
+  StagedGeometry StageClothGeometry();
+  std::unique_ptr<MeshGeometry> CreateClothGeometry(
+    StagedGeometry& staged,
+    AssetLoader::UploadContext& context);
   void CreateRootSignature();
   void CreateClothRootSignature();
   void CreateDescriptorHeaps();
+  void CreateShapeGeometry();
   void CreateRenderItems();
   void CreateFrameResources();
   void CreateShadersAndInputLayout();
   void CreatePSOs();
 
+  void UpdateClothVertices();
+  void UpdateObjectConstants();
+  void UpdatePassConstants(const GameTimer& timer);
+  void DrawRenderItems(const std::vector<RenderItem*>& items);
+
+  // The cloth mesh as views into ClothCache, or into the imported arrays
+  // below when no cache could be written.
+  MeshCache::Mesh ClothMesh;
+  MeshCache ClothCache;
   std::vector<Vertex> Vertecies;
+  std::vector<std::uint32_t> Indices;
+  std::vector<MeshCache::Submesh> ClothSubmeshes;
+  // Empty until the background load has finished uploading.
+  AssetLoader::Handle<MeshGeometry> ClothGeometry;
   std::unique_ptr<Cloth> ClothSimulator;
 
+  // The column's mesh baked into a field, which the cloth collides with in
+  // place of an analytic cylinder.  Referenced by Colliders.
+  DistanceField ColumnField;
+  // The obstacles the cloth falls onto, built with the same dimensions and
+  // world matrices as the ShapeItems that draw them.
+  ClothColliders Colliders;
+
+  // The cloth stepped at a fixed rate once its mesh has loaded, and its
+  // positions interpolated to the current frame, with normals to match.
+  std::unique_ptr<CpuCloth> ClothState;
+  ClothScheduler Scheduler;
+  std::unique_ptr<MeshNormals> ClothNormals;
+  std::vector<DirectX::XMFLOAT3> ClothPositions;
+  std::vector<DirectX::XMFLOAT3> ClothVertexNormals;
+
   std::vector<std::unique_ptr<FrameResource>> FrameResources;
   FrameResource* CurrentFrameResource = nullptr;
+  int CurrentFrameResourceIndex = 0;
   std::vector<std::unique_ptr<RenderItem>> AllRenderItems;
+  // Drawn once the cloth has loaded.
+  RenderItem* ClothItem = nullptr;
+  // The floor and obstacles, drawn every frame.
+  std::vector<RenderItem*> ShapeItems;
+  std::unordered_map<std::string, std::unique_ptr<MeshGeometry>> Geometries;
+  PassConstants MainPassCB;
 
   ComPtr<ID3D12RootSignature> RootSignature = nullptr;
   ComPtr<ID3D12RootSignature> ClothRootSignature = nullptr;
@@ -46,4 +108,7 @@ protected:
 
   std::unordered_map<std::string, ComPtr<ID3D12PipelineState>> PSOs;
 
+  // Last, so it is destroyed first and its workers never outlive what they
+  // load into.
+  std::unique_ptr<AssetLoader> Assets;
 };
@@ -3,6 +3,7 @@
 //
 
 #pragma once
+#include "../mapped_upload_buffer.h"
 #include "../math_helper.h"
 #include "../stdafx.h"
 #include "../upload_buffer.h"
@@ -28,6 +29,7 @@ struct PassConstants {
   DirectX::XMFLOAT4X4 ViewProj = MathHelper::Identity4x4();
   DirectX::XMFLOAT4X4 InvViewProj = MathHelper::Identity4x4();
   DirectX::XMFLOAT3 EyePosW = {0.0f, 0.0f, 0.0f};
+  float cbPerObjectPad1 = 0.0f;
   DirectX::XMFLOAT2 RenderTargetSize = {0.0f, 0.0f};
   DirectX::XMFLOAT2 InvRenderTargetSize = {0.0f, 0.0f};
   float NearZ = 0.0f;
@@ -46,6 +48,10 @@ public:
   std::unique_ptr<UploadBuffer<ObjectConstants>> ObjectConstantsBuffer =
       nullptr;
   std::unique_ptr<UploadBuffer<PassConstants>> PassConstantsBuffer = nullptr;
+  // The CPU cloth's vertices for this frame, drawn straight from upload
+  // memory.  Created once the cloth has loaded.
+  std::unique_ptr<MappedUploadBuffer> ClothVertexBuffer = nullptr;
+  MappedUploadBuffer::Allocation ClothVertices;
 
   UINT64 Fence = 0;
 };
\ No newline at end of file
@@ -0,0 +1,52 @@
+// The cloth simulated on the CPU, lit from above by one directional light
+// and from both sides, as it has no back faces.
+
+cbuffer cbPerObject : register(b0) {
+  float4x4 gWorld;
+};
+
+cbuffer cbPass : register(b1) {
+  float4x4 gView;
+  float4x4 gInvView;
+  float4x4 gProj;
+  float4x4 gInvProj;
+  float4x4 gViewProj;
+  float4x4 gInvViewProj;
+  float3 gEyePosW;
+  float cbPerObjectPad1;
+  float2 gRenderTargetSize;
+  float2 gInvRenderTargetSize;
+  float gNearZ;
+  float gFarZ;
+  float gTotalTime;
+  float gDeltaTime;
+};
+
+static const float3 gLightDirection = float3(0.3f, -0.8f, -0.5f);
+static const float3 gAlbedo = float3(0.8f, 0.2f, 0.2f);
+
+struct VertexIn {
+  float3 PosL : POSITION;
+  float3 NormalL : NORMAL;
+};
+
+struct VertexOut {
+  float4 PosH : SV_POSITION;
+  float3 NormalW : NORMAL;
+};
+
+VertexOut VS(VertexIn vin) {
+  VertexOut vout = (VertexOut)0.0f;
+
+  float4 posW = mul(float4(vin.PosL, 1.0f), gWorld);
+  vout.NormalW = mul(vin.NormalL, (float3x3)gWorld);
+  vout.PosH = mul(posW, gViewProj);
+
+  return vout;
+}
+
+float4 PS(VertexOut pin) : SV_Target {
+  float3 normal = normalize(pin.NormalW);
+  float diffuse = abs(dot(normal, -normalize(gLightDirection)));
+  return float4(gAlbedo * (0.2f + 0.8f * diffuse), 1.0f);
+}
@@ -1,7 +1,8 @@
 #include "frame_resource.h"
 
 FrameResource::FrameResource(ID3D12Device *device, UINT passCount,
-                             UINT objectCount, UINT materialCount) {
+                             UINT objectCount, UINT materialCount,
+                             UINT terrainChunkCount) {
   ThrowIfFailed(device->CreateCommandAllocator(
       D3D12_COMMAND_LIST_TYPE_DIRECT,
       IID_PPV_ARGS(CommandAllocator.GetAddressOf())));
@@ -11,4 +12,6 @@ FrameResource::FrameResource(ID3D12Device *device, UINT passCount,
       std::make_unique<UploadBuffer<ObjectConstants>>(device, objectCount);
   PBRMaterialConstantsBuffer =
       std::make_unique<UploadBuffer<PBRMaterialConstants>>(device, materialCount);
+  TerrainChunkBuffer = std::make_unique<UploadBuffer<TerrainChunkConstants>>(
+      device, terrainChunkCount);
 }
@@ -7,6 +7,7 @@
 #include "../dx_utils.h"
 #include "../math_helper.h"
 #include "../upload_buffer.h"
+#include "../vertex_formats.h"
 
 #define MaxLights 16
 
@@ -19,6 +20,21 @@ struct Light {
 
 struct ObjectConstants {
   DirectX::XMFLOAT4X4 World = MathHelper::Identity4x4();
+  DirectX::XMFLOAT3 PositionMin = {0.0f, 0.0f, 0.0f};
+  float _padding0 = 0.0f;
+  DirectX::XMFLOAT3 PositionExtent = {1.0f, 1.0f, 1.0f};
+  float _padding1 = 0.0f;
+};
+
+// Placement and morph range of one CDLOD terrain chunk, see terrain.hlsl.
+struct TerrainChunkConstants {
+  DirectX::XMFLOAT2 ChunkOffset = {0.0f, 0.0f};
+  float CellSize = 1.0f;
+  float PatchResolution = 1.0f;
+  DirectX::XMFLOAT3 PositionMin = {0.0f, 0.0f, 0.0f};
+  float MorphStart = 0.0f;
+  DirectX::XMFLOAT3 PositionExtent = {1.0f, 1.0f, 1.0f};
+  float MorphEnd = 1.0f;
 };
 
 struct PassConstants {
@@ -55,14 +71,19 @@ struct AreaLight {
 };
 
 struct Vertex {
-  DirectX::XMFLOAT3 Pos;
-  DirectX::XMFLOAT3 Normal;
+  VertexFormats::Position Pos;
+  VertexFormats::Direction Normal;
+
+  static std::array<D3D12_INPUT_ELEMENT_DESC, 2> InputLayout() {
+    return {VertexElement("POSITION", &Vertex::Pos),
+            VertexElement("NORMAL", &Vertex::Normal)};
+  }
 };
 
 class FrameResource {
 public:
   FrameResource(ID3D12Device *device, UINT passCount, UINT objectCount,
-                UINT materialCount);
+                UINT materialCount, UINT terrainChunkCount);
   FrameResource(const FrameResource &) = delete;
   FrameResource &operator=(const FrameResource &) = delete;
 
@@ -72,6 +93,8 @@ public:
   std::unique_ptr<UploadBuffer<PassConstants>> PassConstantsBuffer = nullptr;
   std::unique_ptr<UploadBuffer<PBRMaterialConstants>>
       PBRMaterialConstantsBuffer = nullptr;
+  std::unique_ptr<UploadBuffer<TerrainChunkConstants>> TerrainChunkBuffer =
+      nullptr;
 
   UINT64 Fence = 0;
 };
\ No newline at end of file
@@ -3,7 +3,10 @@
 //
 
 #include "pbr_renderer.h"
+#include "../geometry_arena.h"
 #include "../geometry_generator.h"
+#include "../mesh_optimizer.h"
+#include "../mesh_simplifier.h"
 #include "render_item.h"
 #include <GLFW/glfw3.h>
 
@@ -16,6 +19,7 @@ void PBRRenderer::InitDirectX(const InitInfo &initInfo) {
 
   CreateRootSignature();
   CreateShaderAndInputLayout();
+  CreateTerrain();
   CreateShapeGeometry();
   CreateMaterials();
   CreateRenderItems();
@@ -34,6 +38,10 @@ void PBRRenderer::InitDirectX(const InitInfo &initInfo) {
 
 void PBRRenderer::Update(const GameTimer &timer) {
   UpdateCamera(timer);
+  UpdateWorldBounds();
+  SelectLods();
+  CullRenderItems();
+  SelectTerrainChunks();
 
   CurrentFrameResourceIndex =
       (CurrentFrameResourceIndex + 1) % FrameResourceCount;
@@ -47,6 +55,7 @@ void PBRRenderer::Update(const GameTimer &timer) {
   UpdateObjectConstantsBuffer(timer);
   UpdateMaterialConstantsBuffer(timer);
   UpdateMainPassConstantsBuffer(timer);
+  UpdateTerrainChunkBuffer();
 }
 
 void PBRRenderer::OnResize(UINT width, UINT height) {
@@ -104,6 +113,7 @@ void PBRRenderer::Draw(const GameTimer &timer) {
              ->GetGPUVirtualAddress());
 
   DrawRenderItems(commandList.Get(), OpaqueRenderItems);
+  DrawTerrain(commandList.Get());
 
   const auto barrier2 = CD3DX12_RESOURCE_BARRIER::Transition(
       CurrentBackBuffer(), D3D12_RESOURCE_STATE_RENDER_TARGET,
@@ -155,9 +165,49 @@ void PBRRenderer::DrawRenderItems(ID3D12GraphicsCommandList *cmdList,
     // cbvHandle.Offset(cbvIndex, cbvUavDescriptorSize);
     // cmdList->SetGraphicsRootDescriptorTable(0, cbvHandle);
 
-    cmdList->DrawIndexedInstanced(renderItem->IndexCount, 1,
-                                  renderItem->StartIndexLocation,
-                                  renderItem->BaseVertexLocation, 0);
+    for (auto &range : renderItem->VisibleRanges) {
+      cmdList->DrawIndexedInstanced(range.IndexCount, 1,
+                                    range.StartIndexLocation,
+                                    renderItem->BaseVertexLocation, 0);
+    }
+  }
+}
+
+void PBRRenderer::DrawTerrain(ID3D12GraphicsCommandList *cmdList) {
+  if (TerrainChunks.empty()) {
+    return;
+  }
+  cmdList->SetPipelineState(
+      PSOs[IsWireFrame ? "terrain_wireframe" : "terrain"].Get());
+
+  auto geo = Geometries["shapeGeo"].get();
+  auto vertexBufferView = geo->VertexBufferView();
+  auto indexBufferView = geo->IndexBufferView();
+  cmdList->IASetVertexBuffers(0, 1, &vertexBufferView);
+  cmdList->IASetIndexBuffer(&indexBufferView);
+  cmdList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+  UINT chunkCBByteSize =
+      DXUtils::CalcConstantBufferSize(sizeof(TerrainChunkConstants));
+  UINT matCBByteSize =
+      DXUtils::CalcConstantBufferSize(sizeof(PBRMaterialConstants));
+  auto chunkCB = CurrentFrameResource->TerrainChunkBuffer->Resource();
+  auto matCB = CurrentFrameResource->PBRMaterialConstantsBuffer->Resource();
+
+  auto matCBAddress = matCB->GetGPUVirtualAddress() +
+                      Materials["tile0"]->MatCBIndex * matCBByteSize;
+  cmdList->SetGraphicsRootConstantBufferView(1, matCBAddress);
+
+  auto &patch = geo->DrawArgs["terrainPatch"];
+  for (UINT i = 0; i < TerrainChunks.size(); i++) {
+    UINT startIndexLocation, indexCount;
+    CdlodTerrain::PatchRange(patch, TerrainChunks[i].Quadrant,
+                             startIndexLocation, indexCount);
+
+    cmdList->SetGraphicsRootConstantBufferView(
+        0, chunkCB->GetGPUVirtualAddress() + i * chunkCBByteSize);
+    cmdList->DrawIndexedInstanced(indexCount, 1, startIndexLocation,
+                                  patch.BaseVertexLocation, 0);
   }
 }
 
@@ -193,149 +243,99 @@ void PBRRenderer::CreateRootSignature() {
 }
 
 void PBRRenderer::CreateShaderAndInputLayout() {
+  auto defines = VertexFormats::ShaderDefines();
   Shaders["standardVS"] = DXUtils::CompileShader(SHADER_DIR L"/color.hlsl",
-                                                 nullptr, "VS", "vs_5_1");
+                                                 defines, "VS", "vs_5_1");
   Shaders["opaquePS"] = DXUtils::CompileShader(SHADER_DIR L"/color.hlsl",
-                                               nullptr, "PS", "ps_5_1");
-
-  InputLayout.push_back(D3D12_INPUT_ELEMENT_DESC{
-      .SemanticName = "POSITION",
-      .SemanticIndex = 0,
-      .Format = DXGI_FORMAT_R32G32B32_FLOAT,
-      .InputSlot = 0,
-      .AlignedByteOffset = 0,
-      .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-      .InstanceDataStepRate = 0});
-  InputLayout.push_back(D3D12_INPUT_ELEMENT_DESC{
-      .SemanticName = "NORMAL",
-      .SemanticIndex = 0,
-      .Format = DXGI_FORMAT_R32G32B32_FLOAT,
-      .InputSlot = 0,
-      .AlignedByteOffset = 12,
-      .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-      .InstanceDataStepRate = 0});
+                                               defines, "PS", "ps_5_1");
+  Shaders["terrainVS"] = DXUtils::CompileShader(SHADER_DIR L"/terrain.hlsl",
+                                                defines, "VS", "vs_5_1");
+
+  auto layout = Vertex::InputLayout();
+  InputLayout.assign(layout.begin(), layout.end());
+}
+
+void PBRRenderer::CreateTerrain() {
+  CdlodTerrain::Settings settings;
+  settings.Size = 256.0f;
+  settings.LodCount = 6;
+  settings.PatchResolution = 32;
+  settings.FinestRange = 16.0f;
+  Terrain = std::make_unique<CdlodTerrain>(settings);
 }
 
 void PBRRenderer::CreateShapeGeometry() {
   GeometryGenerator geoGen;
   GeometryGenerator::MeshData box = geoGen.CreateBox(1.5f, 0.5f, 1.5f, 3);
-  GeometryGenerator::MeshData grid = geoGen.CreateGrid(20.0f, 30.0f, 60, 40);
-  GeometryGenerator::MeshData sphere = geoGen.CreateSphere(0.5f, 20, 20);
-  GeometryGenerator::MeshData cylinder =
-      geoGen.CreateCylinder(0.5f, 0.3f, 3.0f, 20, 20);
-
-  //
-  // We are concatenating all the geometry into one big vertex/index buffer.  So
-  // define the regions in the buffer each submesh covers.
-  //
-
-  // Cache the vertex offsets to each object in the concatenated vertex buffer.
-  UINT boxVertexOffset = 0;
-  UINT gridVertexOffset = (UINT)box.Vertices.size();
-  UINT sphereVertexOffset = gridVertexOffset + (UINT)grid.Vertices.size();
-  UINT cylinderVertexOffset = sphereVertexOffset + (UINT)sphere.Vertices.size();
-
-  // Cache the starting index for each object in the concatenated index buffer.
-  UINT boxIndexOffset = 0;
-  UINT gridIndexOffset = (UINT)box.Indices32.size();
-  UINT sphereIndexOffset = gridIndexOffset + (UINT)grid.Indices32.size();
-  UINT cylinderIndexOffset = sphereIndexOffset + (UINT)sphere.Indices32.size();
-
-  // Define the SubmeshGeometry that cover different
-  // regions of the vertex/index buffers.
 
-  SubmeshGeometry boxSubmesh;
-  boxSubmesh.IndexCount = (UINT)box.Indices32.size();
-  boxSubmesh.StartIndexLocation = boxIndexOffset;
-  boxSubmesh.BaseVertexLocation = boxVertexOffset;
-
-  SubmeshGeometry gridSubmesh;
-  gridSubmesh.IndexCount = (UINT)grid.Indices32.size();
-  gridSubmesh.StartIndexLocation = gridIndexOffset;
-  gridSubmesh.BaseVertexLocation = gridVertexOffset;
-
-  SubmeshGeometry sphereSubmesh;
-  sphereSubmesh.IndexCount = (UINT)sphere.Indices32.size();
-  sphereSubmesh.StartIndexLocation = sphereIndexOffset;
-  sphereSubmesh.BaseVertexLocation = sphereVertexOffset;
-
-  SubmeshGeometry cylinderSubmesh;
-  cylinderSubmesh.IndexCount = (UINT)cylinder.Indices32.size();
-  cylinderSubmesh.StartIndexLocation = cylinderIndexOffset;
-  cylinderSubmesh.BaseVertexLocation = cylinderVertexOffset;
-
-  //
-  // Extract the vertex elements we are interested in and pack the
-  // vertices of all the meshes into one vertex buffer.
-  //
-
-  auto totalVertexCount = box.Vertices.size() + grid.Vertices.size() +
-                          sphere.Vertices.size() + cylinder.Vertices.size();
-
-  std::vector<Vertex> vertices(totalVertexCount);
-
-  UINT k = 0;
-  for (size_t i = 0; i < box.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = box.Vertices[i].Position;
-    vertices[k].Normal = box.Vertices[i].Normal;
+  // Tessellation ladders of the curved shapes, finest first.  Every level is
+  // its own mesh, named "sphere", "sphere_lod1", ...
+  auto sphereLadder = LodSelector::SphereLadder(0.5f, 40, 40, 4);
+  auto cylinderLadder = LodSelector::CylinderLadder(0.5f, 0.3f, 40, 20, 4);
+  std::vector<GeometryGenerator::MeshData> sphereLevels, cylinderLevels;
+  for (auto &level : sphereLadder) {
+    sphereLevels.push_back(geoGen.CreateSphere(
+        0.5f, level.SliceCount, level.StackCount, ThreadPool::Shared()));
   }
-
-  for (size_t i = 0; i < grid.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = grid.Vertices[i].Position;
-    vertices[k].Normal = grid.Vertices[i].Normal;
+  for (auto &level : cylinderLadder) {
+    cylinderLevels.push_back(
+        geoGen.CreateCylinder(0.5f, 0.3f, 3.0f, level.SliceCount,
+                              level.StackCount, ThreadPool::Shared()));
   }
 
-  for (size_t i = 0; i < sphere.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = sphere.Vertices[i].Position;
-    vertices[k].Normal = sphere.Vertices[i].Normal;
+  std::vector<std::pair<std::string, GeometryGenerator::MeshData *>> meshes = {
+      {"box", &box}};
+  for (size_t i = 0; i < sphereLevels.size(); i++) {
+    meshes.push_back({MeshSimplifier::LodName("sphere", i), &sphereLevels[i]});
   }
-
-  for (size_t i = 0; i < cylinder.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = cylinder.Vertices[i].Position;
-    vertices[k].Normal = cylinder.Vertices[i].Normal;
+  for (size_t i = 0; i < cylinderLevels.size(); i++) {
+    meshes.push_back(
+        {MeshSimplifier::LodName("cylinder", i), &cylinderLevels[i]});
   }
 
-  std::vector<std::uint16_t> indices;
-  indices.insert(indices.end(), std::begin(box.GetIndices16()),
-                 std::end(box.GetIndices16()));
-  indices.insert(indices.end(), std::begin(grid.GetIndices16()),
-                 std::end(grid.GetIndices16()));
-  indices.insert(indices.end(), std::begin(sphere.GetIndices16()),
-                 std::end(sphere.GetIndices16()));
-  indices.insert(indices.end(), std::begin(cylinder.GetIndices16()),
-                 std::end(cylinder.GetIndices16()));
-
-  const UINT vbByteSize = (UINT)vertices.size() * sizeof(Vertex);
-  const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint16_t);
-
-  auto geo = std::make_unique<MeshGeometry>();
-  geo->Name = "shapeGeo";
-
-  ThrowIfFailed(D3DCreateBlob(vbByteSize, &geo->VertexCPUBuffer));
-  CopyMemory(geo->VertexCPUBuffer->GetBufferPointer(), vertices.data(),
-             vbByteSize);
-
-  ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexCPUBuffer));
-  CopyMemory(geo->IndexCPUBuffer->GetBufferPointer(), indices.data(),
-             ibByteSize);
-
-  geo->VertexGPUBuffer = DXUtils::CreateDefaultBuffer(
-      device.Get(), commandList.Get(), vertices.data(), vbByteSize,
-      geo->VertexBufferUploader);
+  // Reorder every mesh for the post-transform cache, overdraw and vertex fetch
+  // before it is packed.
+  for (auto &[name, mesh] : meshes) {
+    auto report = MeshOptimizer::Optimize(*mesh);
+    ::OutputDebugStringA(MeshOptimizer::Describe(name, report).c_str());
+  }
 
-  geo->IndexGPUBuffer = DXUtils::CreateDefaultBuffer(
-      device.Get(), commandList.Get(), indices.data(), ibByteSize,
-      geo->IndexBufferUploader);
+  // The terrain patch keeps its triangles grouped by quadrant, so it skips
+  // the optimizer.
+  auto terrainPatch =
+      CdlodTerrain::CreatePatch(Terrain->GetSettings().PatchResolution);
 
-  geo->VertexByteStride = sizeof(Vertex);
-  geo->VertexBufferByteSize = vbByteSize;
-  geo->IndexFormat = DXGI_FORMAT_R16_UINT;
-  geo->IndexBufferByteSize = ibByteSize;
+  // Pack every mesh into one vertex/index buffer.
+  GeometryArena arena;
+  for (auto &[name, mesh] : meshes) {
+    arena.Add(name, *mesh);
+  }
+  arena.Add("terrainPatch", terrainPatch);
+  auto geo = arena.Build<Vertex>(
+      "shapeGeo", device.Get(), commandList.Get(),
+      [](Vertex &out, const GeometryGenerator::Vertex &in,
+         const SubmeshGeometry &submesh) {
+        VertexFormats::EncodePosition(out.Pos, in.Position,
+                                      submesh.Quantization);
+        VertexFormats::EncodeDirection(out.Normal, in.Normal);
+      });
+
+  for (size_t i = 0; i < sphereLadder.size(); i++) {
+    geo->DrawArgs[MeshSimplifier::LodName("sphere", i)].LodError =
+        sphereLadder[i].Error;
+  }
+  for (size_t i = 0; i < cylinderLadder.size(); i++) {
+    geo->DrawArgs[MeshSimplifier::LodName("cylinder", i)].LodError =
+        cylinderLadder[i].Error;
+  }
 
-  geo->DrawArgs["box"] = boxSubmesh;
-  geo->DrawArgs["grid"] = gridSubmesh;
-  geo->DrawArgs["sphere"] = sphereSubmesh;
-  geo->DrawArgs["cylinder"] = cylinderSubmesh;
+  // Split every mesh into meshlets for CPU cluster culling.
+  for (auto &[name, mesh] : meshes) {
+    auto &submesh = geo->DrawArgs[name];
+    geo->Meshlets[name] = MeshletBuilder::Build(
+        mesh->Indices32, &mesh->Vertices[0].Position, mesh->Vertices.size(),
+        sizeof(GeometryGenerator::Vertex), submesh.StartIndexLocation);
+  }
 
   Geometries[geo->Name] = std::move(geo);
 }
@@ -395,22 +395,26 @@ void PBRRenderer::CreateRenderItems() {
       boxRitem->Geometry->DrawArgs["box"].StartIndexLocation;
   boxRitem->BaseVertexLocation =
       boxRitem->Geometry->DrawArgs["box"].BaseVertexLocation;
+  boxRitem->Quantization = boxRitem->Geometry->DrawArgs["box"].Quantization;
+  boxRitem->Bounds = boxRitem->Geometry->DrawArgs["box"].Bounds;
+  boxRitem->SphereBounds = boxRitem->Geometry->DrawArgs["box"].SphereBounds;
+  boxRitem->Meshlets = &boxRitem->Geometry->Meshlets["box"];
   AllRenderItems.push_back(std::move(boxRitem));
 
-  auto gridRitem = std::make_unique<RenderItem>();
-  gridRitem->World = MathHelper::Identity4x4();
-  gridRitem->ObjectCBIndex = 1;
-  gridRitem->Geometry = Geometries["shapeGeo"].get();
-  gridRitem->Material = Materials["tile0"].get();
-  gridRitem->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
-  gridRitem->IndexCount = gridRitem->Geometry->DrawArgs["grid"].IndexCount;
-  gridRitem->StartIndexLocation =
-      gridRitem->Geometry->DrawArgs["grid"].StartIndexLocation;
-  gridRitem->BaseVertexLocation =
-      gridRitem->Geometry->DrawArgs["grid"].BaseVertexLocation;
-  AllRenderItems.push_back(std::move(gridRitem));
-
-  UINT ObjectCBIndex = 2;
+  // Gives an item the LOD chain of a DrawArgs entry.
+  auto setLodChain = [](RenderItem *item, const std::string &name) {
+    auto geo = item->Geometry;
+    std::vector<float> errors;
+    for (size_t i = 0; geo->DrawArgs.count(MeshSimplifier::LodName(name, i));
+         i++) {
+      auto lodName = MeshSimplifier::LodName(name, i);
+      item->Lods.push_back({&geo->DrawArgs[lodName], &geo->Meshlets[lodName]});
+      errors.push_back(geo->DrawArgs[lodName].LodError);
+    }
+    item->LodSelection = LodSelector(std::move(errors));
+  };
+
+  UINT ObjectCBIndex = 1;
   for (int i = 0; i < 5; ++i) {
     auto leftCylRitem = std::make_unique<RenderItem>();
     auto rightCylRitem = std::make_unique<RenderItem>();
@@ -437,6 +441,13 @@ void PBRRenderer::CreateRenderItems() {
         leftCylRitem->Geometry->DrawArgs["cylinder"].StartIndexLocation;
     leftCylRitem->BaseVertexLocation =
         leftCylRitem->Geometry->DrawArgs["cylinder"].BaseVertexLocation;
+    leftCylRitem->Quantization =
+        leftCylRitem->Geometry->DrawArgs["cylinder"].Quantization;
+    leftCylRitem->Bounds = leftCylRitem->Geometry->DrawArgs["cylinder"].Bounds;
+    leftCylRitem->SphereBounds =
+        leftCylRitem->Geometry->DrawArgs["cylinder"].SphereBounds;
+    leftCylRitem->Meshlets = &leftCylRitem->Geometry->Meshlets["cylinder"];
+    setLodChain(leftCylRitem.get(), "cylinder");
 
     XMStoreFloat4x4(&rightCylRitem->World, leftCylWorld);
     rightCylRitem->ObjectCBIndex = ObjectCBIndex++;
@@ -449,6 +460,14 @@ void PBRRenderer::CreateRenderItems() {
         rightCylRitem->Geometry->DrawArgs["cylinder"].StartIndexLocation;
     rightCylRitem->BaseVertexLocation =
         rightCylRitem->Geometry->DrawArgs["cylinder"].BaseVertexLocation;
+    rightCylRitem->Quantization =
+        rightCylRitem->Geometry->DrawArgs["cylinder"].Quantization;
+    rightCylRitem->Bounds =
+        rightCylRitem->Geometry->DrawArgs["cylinder"].Bounds;
+    rightCylRitem->SphereBounds =
+        rightCylRitem->Geometry->DrawArgs["cylinder"].SphereBounds;
+    rightCylRitem->Meshlets = &rightCylRitem->Geometry->Meshlets["cylinder"];
+    setLodChain(rightCylRitem.get(), "cylinder");
 
     XMStoreFloat4x4(&leftSphereRitem->World, leftSphereWorld);
     leftSphereRitem->ObjectCBIndex = ObjectCBIndex++;
@@ -461,6 +480,14 @@ void PBRRenderer::CreateRenderItems() {
         leftSphereRitem->Geometry->DrawArgs["sphere"].StartIndexLocation;
     leftSphereRitem->BaseVertexLocation =
         leftSphereRitem->Geometry->DrawArgs["sphere"].BaseVertexLocation;
+    leftSphereRitem->Quantization =
+        leftSphereRitem->Geometry->DrawArgs["sphere"].Quantization;
+    leftSphereRitem->Bounds =
+        leftSphereRitem->Geometry->DrawArgs["sphere"].Bounds;
+    leftSphereRitem->SphereBounds =
+        leftSphereRitem->Geometry->DrawArgs["sphere"].SphereBounds;
+    leftSphereRitem->Meshlets = &leftSphereRitem->Geometry->Meshlets["sphere"];
+    setLodChain(leftSphereRitem.get(), "sphere");
 
     XMStoreFloat4x4(&rightSphereRitem->World, rightSphereWorld);
     rightSphereRitem->ObjectCBIndex = ObjectCBIndex++;
@@ -473,6 +500,15 @@ void PBRRenderer::CreateRenderItems() {
         rightSphereRitem->Geometry->DrawArgs["sphere"].StartIndexLocation;
     rightSphereRitem->BaseVertexLocation =
         rightSphereRitem->Geometry->DrawArgs["sphere"].BaseVertexLocation;
+    rightSphereRitem->Quantization =
+        rightSphereRitem->Geometry->DrawArgs["sphere"].Quantization;
+    rightSphereRitem->Bounds =
+        rightSphereRitem->Geometry->DrawArgs["sphere"].Bounds;
+    rightSphereRitem->SphereBounds =
+        rightSphereRitem->Geometry->DrawArgs["sphere"].SphereBounds;
+    rightSphereRitem->Meshlets =
+        &rightSphereRitem->Geometry->Meshlets["sphere"];
+    setLodChain(rightSphereRitem.get(), "sphere");
 
     AllRenderItems.push_back(std::move(leftCylRitem));
     AllRenderItems.push_back(std::move(rightCylRitem));
@@ -514,7 +550,8 @@ void PBRRenderer::CreateFrameResource() {
   FrameResources.reserve(FrameResourceCount);
   for (auto i = 0; i < FrameResourceCount; i++) {
     FrameResources.push_back(std::make_unique<FrameResource>(
-        device.Get(), 1, AllRenderItems.size(), Materials.size()));
+        device.Get(), 1, AllRenderItems.size(), Materials.size(),
+        MaxTerrainChunks));
   }
 }
 
@@ -612,6 +649,19 @@ void PBRRenderer::CreatePSOs() {
   opaqueWireframePsoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME;
   ThrowIfFailed(device->CreateGraphicsPipelineState(
       &opaqueWireframePsoDesc, IID_PPV_ARGS(&PSOs["opaque_wireframe"])));
+
+  D3D12_GRAPHICS_PIPELINE_STATE_DESC terrainPsoDesc = opaquePsoDesc;
+  terrainPsoDesc.VS = {
+      .pShaderBytecode = Shaders["terrainVS"]->GetBufferPointer(),
+      .BytecodeLength = Shaders["terrainVS"]->GetBufferSize(),
+  };
+  ThrowIfFailed(device->CreateGraphicsPipelineState(
+      &terrainPsoDesc, IID_PPV_ARGS(&PSOs["terrain"])));
+
+  D3D12_GRAPHICS_PIPELINE_STATE_DESC terrainWireframePsoDesc = terrainPsoDesc;
+  terrainWireframePsoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_WIREFRAME;
+  ThrowIfFailed(device->CreateGraphicsPipelineState(
+      &terrainWireframePsoDesc, IID_PPV_ARGS(&PSOs["terrain_wireframe"])));
 }
 
 void PBRRenderer::UpdateObjectConstantsBuffer(const GameTimer &timer) {
@@ -623,6 +673,8 @@ void PBRRenderer::UpdateObjectConstantsBuffer(const GameTimer &timer) {
       ObjectConstants objConstants;
       DirectX::XMStoreFloat4x4(&objConstants.World,
                                DirectX::XMMatrixTranspose(world));
+      objConstants.PositionMin = i->Quantization.Min;
+      objConstants.PositionExtent = i->Quantization.Extent;
 
       currentObjectCB->CopyData(i->ObjectCBIndex, objConstants);
       i->NumberFramesDirty--;
@@ -661,6 +713,108 @@ void PBRRenderer::UpdateCamera(const GameTimer &timer) {
   XMStoreFloat4x4(&ViewMatrix, view);
 }
 
+void PBRRenderer::UpdateWorldBounds() {
+  for (auto item : OpaqueRenderItems) {
+    item->WorldBounds.Update(item->World, item->Bounds, item->SphereBounds);
+  }
+}
+
+void PBRRenderer::SelectLods() {
+  // Pixels covered by one world unit at a distance of one unit.
+  const float pixelsPerUnit = 0.5f * viewport.Height * ProjectionMatrix(1, 1);
+  XMVECTOR eye = XMLoadFloat3(&EyePos);
+
+  for (auto item : OpaqueRenderItems) {
+    if (item->Lods.empty()) {
+      continue;
+    }
+
+    // Measure to the nearest point of the bounding sphere, so large items
+    // do not coarsen while the camera is close to one of their ends.  Nothing
+    // is drawn closer than the near plane at 1.
+    auto &sphere = item->WorldBounds.Sphere();
+    float scale = item->WorldBounds.Scale();
+    float distance = std::max<float>(
+        XMVectorGetX(XMVector3Length(XMLoadFloat3(&sphere.Center) - eye)) -
+            sphere.Radius,
+        1.0f);
+
+    auto previous = item->LodSelection.Level();
+    auto lod = item->LodSelection.Update(scale * pixelsPerUnit / distance,
+                                         MaxLodPixelError, LodHysteresis);
+
+    auto &selected = item->Lods[lod];
+    item->IndexCount = selected.Submesh->IndexCount;
+    item->StartIndexLocation = selected.Submesh->StartIndexLocation;
+    item->BaseVertexLocation = selected.Submesh->BaseVertexLocation;
+    item->Quantization = selected.Submesh->Quantization;
+    item->Meshlets = selected.Meshlets;
+
+    // The quantization range lives in the object constants.
+    if (lod != previous) {
+      item->NumberFramesDirty = FrameResourceCount;
+    }
+  }
+}
+
+void PBRRenderer::CullRenderItems() {
+  auto view = XMLoadFloat4x4(&ViewMatrix);
+  auto proj = XMLoadFloat4x4(&ProjectionMatrix);
+
+  XMFLOAT4 planes[6];
+  ClusterCuller::ExtractFrustumPlanes(XMMatrixMultiply(view, proj), planes);
+
+  for (auto item : OpaqueRenderItems) {
+    item->VisibleRanges.clear();
+    if (!MeshBounds::Intersects(item->WorldBounds.Box(), planes)) {
+      continue;
+    }
+    if (item->Meshlets == nullptr) {
+      item->VisibleRanges.push_back(
+          {item->StartIndexLocation, item->IndexCount});
+      continue;
+    }
+
+    ClusterCuller::Cull(*item->Meshlets, XMLoadFloat4x4(&item->World), planes,
+                        EyePos, item->VisibleRanges);
+  }
+}
+
+void PBRRenderer::SelectTerrainChunks() {
+  auto view = XMLoadFloat4x4(&ViewMatrix);
+  auto proj = XMLoadFloat4x4(&ProjectionMatrix);
+
+  XMFLOAT4 planes[6];
+  ClusterCuller::ExtractFrustumPlanes(XMMatrixMultiply(view, proj), planes);
+
+  Terrain->Select(EyePos, planes, TerrainChunks);
+  if (TerrainChunks.size() > MaxTerrainChunks) {
+    ::OutputDebugStringA("Terrain: too many chunks selected, dropping some\n");
+    TerrainChunks.resize(MaxTerrainChunks);
+  }
+}
+
+void PBRRenderer::UpdateTerrainChunkBuffer() {
+  auto &patch = Geometries["shapeGeo"]->DrawArgs["terrainPatch"];
+  auto currentChunkCB = CurrentFrameResource->TerrainChunkBuffer.get();
+  for (size_t i = 0; i < TerrainChunks.size(); i++) {
+    auto &chunk = TerrainChunks[i];
+    auto morph = Terrain->MorphRange(chunk.Level);
+
+    TerrainChunkConstants chunkConstants;
+    chunkConstants.ChunkOffset = chunk.Min;
+    chunkConstants.CellSize = Terrain->CellSize(chunk);
+    chunkConstants.PatchResolution =
+        (float)Terrain->GetSettings().PatchResolution;
+    chunkConstants.PositionMin = patch.Quantization.Min;
+    chunkConstants.MorphStart = morph.x;
+    chunkConstants.PositionExtent = patch.Quantization.Extent;
+    chunkConstants.MorphEnd = morph.y;
+
+    currentChunkCB->CopyData((int)i, chunkConstants);
+  }
+}
+
 void PBRRenderer::UpdateMainPassConstantsBuffer(const GameTimer &timer) {
   auto view = DirectX::XMLoadFloat4x4(&ViewMatrix);
   auto proj = DirectX::XMLoadFloat4x4(&ProjectionMatrix);
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../cdlod_terrain.h"
 #include "../renderer.h"
 #include "../stdafx.h"
 #include "frame_resource.h"
@@ -20,6 +21,7 @@ public:
   void Draw(const GameTimer &timer) override;
   void DrawRenderItems(ID3D12GraphicsCommandList *cmdList,
                        std::vector<RenderItem *> items);
+  void DrawTerrain(ID3D12GraphicsCommandList *cmdList);
   void OnResize(UINT width, UINT height) override;
 
   static int GetFrameResourceCount() { return FrameResourceCount; }
@@ -31,6 +33,7 @@ public:
 private:
   void CreateRootSignature();
   void CreateShaderAndInputLayout();
+  void CreateTerrain();
   void CreateShapeGeometry();
   void CreateMaterials();
   void CreateRenderItems();
@@ -41,9 +44,14 @@ private:
   void CreatePSOs();
 
   void UpdateCamera(const GameTimer &timer);
+  void UpdateWorldBounds();
+  void SelectLods();
+  void CullRenderItems();
+  void SelectTerrainChunks();
   void UpdateObjectConstantsBuffer(const GameTimer &timer);
   void UpdateMaterialConstantsBuffer(const GameTimer &timer);
   void UpdateMainPassConstantsBuffer(const GameTimer &timer);
+  void UpdateTerrainChunkBuffer();
 
 private:
   static const int FrameResourceCount = 3;
@@ -58,6 +66,11 @@ private:
   std::vector<std::unique_ptr<RenderItem>> AllRenderItems;
   std::vector<RenderItem *> OpaqueRenderItems;
 
+  // The ground: one shared patch drawn once per selected chunk.
+  std::unique_ptr<CdlodTerrain> Terrain;
+  std::vector<CdlodTerrain::Chunk> TerrainChunks;
+  static constexpr UINT MaxTerrainChunks = 256;
+
   int LightNum = 0;
   Light AllLights[MaxLights];
 
@@ -75,6 +88,11 @@ private:
   float Phi = 0.2f * DirectX::XM_PI;
   float Radius = 15.0f;
 
+  // Coarsest LOD whose projected error stays below this many pixels is used.
+  // Coarsening waits until the error is this fraction below the threshold.
+  static constexpr float MaxLodPixelError = 1.0f;
+  static constexpr float LodHysteresis = 0.25f;
+
   ComPtr<ID3D12RootSignature> RootSignature = nullptr;
   std::vector<D3D12_INPUT_ELEMENT_DESC> InputLayout;
 
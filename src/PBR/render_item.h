@@ -5,9 +5,15 @@
 #pragma once
 
 #include "../dx_utils.h"
+#include "../lod_selector.h"
 #include "../math_helper.h"
 #include "../stdafx.h"
 
+struct RenderItemLod {
+  const SubmeshGeometry *Submesh = nullptr;
+  const std::vector<Meshlet> *Meshlets = nullptr;
+};
+
 struct RenderItem {
   DirectX::XMFLOAT4X4 World = MathHelper::Identity4x4();
 
@@ -22,4 +28,22 @@ struct RenderItem {
   UINT IndexCount = 0;
   UINT StartIndexLocation = 0;
   UINT BaseVertexLocation = 0;
+  PositionQuantization Quantization;
+
+  // Local bounds of the submesh, and their world-space copy which is only
+  // recomputed when World changes.
+  DirectX::BoundingBox Bounds;
+  DirectX::BoundingSphere SphereBounds;
+  WorldBoundsCache WorldBounds;
+
+  // Meshlets of the submesh and the index ranges that survived culling this
+  // frame.  Items without meshlets draw their whole index range.
+  const std::vector<Meshlet> *Meshlets = nullptr;
+  std::vector<ClusterCuller::DrawRange> VisibleRanges;
+
+  // LOD chain of the submesh, finest first.  Empty when it has none.  Levels
+  // may have their own vertices, so switching also changes
+  // BaseVertexLocation and Quantization.
+  std::vector<RenderItemLod> Lods;
+  LodSelector LodSelection;
 };
\ No newline at end of file
@@ -1,7 +1,14 @@
 
 #include "LightUtil.hlsl"
-
-cbuffer cbPerObject : register(b0) { float4x4 gWorld; };
+#include "../../shaders/VertexFormats.hlsl"
+
+cbuffer cbPerObject : register(b0) {
+  float4x4 gWorld;
+  float3 gPositionMin;
+  float gPositionPad0;
+  float3 gPositionExtent;
+  float gPositionPad1;
+};
 
 cbuffer cbMaterial : register(b1) {
   float4 gDiffuseAlbedo;
@@ -30,8 +37,8 @@ cbuffer cbPass : register(b2) {
 };
 
 struct VertexIn {
-  float3 PosL : POSITION;
-  float3 NormalL : NORMAL;
+  VERTEX_POSITION PosL : POSITION;
+  VERTEX_DIRECTION NormalL : NORMAL;
 };
 
 struct VertexOut {
@@ -43,10 +50,13 @@ struct VertexOut {
 VertexOut VS(VertexIn vin) {
   VertexOut vout = (VertexOut)0.0f;
 
-  float4 posW = mul(float4(vin.PosL, 1.0f), gWorld);
+  float3 posL = DecodePosition(vin.PosL, gPositionMin, gPositionExtent);
+  float3 normalL = DecodeDirection(vin.NormalL);
+
+  float4 posW = mul(float4(posL, 1.0f), gWorld);
   vout.PosW = posW.xyz;
 
-  vout.NormalW = mul(vin.NormalL, (float3x3)gWorld);
+  vout.NormalW = mul(normalL, (float3x3)gWorld);
   vout.PosH = mul(posW, gViewProj);
 
   return vout;
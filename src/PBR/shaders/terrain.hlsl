@@ -0,0 +1,69 @@
+#include "LightUtil.hlsl"
+#include "../../shaders/VertexFormats.hlsl"
+
+// Vertex shader of the CDLOD terrain chunks.  Every chunk draws the same
+// patch; this places it and morphs it towards the next coarser level.  The
+// pixel shader is the one from color.hlsl.
+
+cbuffer cbTerrainChunk : register(b0) {
+  float2 gChunkOffset;
+  float gCellSize;
+  float gPatchResolution;
+  float3 gPositionMin;
+  float gMorphStart;
+  float3 gPositionExtent;
+  float gMorphEnd;
+};
+
+cbuffer cbPass : register(b2) {
+  float4x4 gView;
+  float4x4 gInvView;
+  float4x4 gProj;
+  float4x4 gInvProj;
+  float4x4 gViewProj;
+  float4x4 gInvViewProj;
+  float3 gEyePosW;
+  float cbPerObjectPad1;
+  float2 gRenderTargetSize;
+  float2 gInvRenderTargetSize;
+  float gNearZ;
+  float gFarZ;
+  float gTotalTime;
+  float gDeltaTime;
+
+  Light gLights[MaxLights];
+};
+
+struct VertexIn {
+  VERTEX_POSITION PosL : POSITION;
+  VERTEX_DIRECTION NormalL : NORMAL;
+};
+
+struct VertexOut {
+  float4 PosH : SV_POSITION;
+  float3 PosW : POSITION;
+  float3 NormalW : NORMAL;
+};
+
+VertexOut VS(VertexIn vin) {
+  VertexOut vout = (VertexOut)0.0f;
+
+  // The patch spans [-0.5, 0.5]; round to whole grid steps so quantization
+  // error does not leak into the morph.
+  float3 posL = DecodePosition(vin.PosL, gPositionMin, gPositionExtent);
+  float2 gridPos = round((posL.xz + 0.5f) * gPatchResolution);
+
+  // Odd grid vertices slide onto their even neighbour, which is where the
+  // coarser level has its vertices.
+  float2 posW = gChunkOffset + gridPos * gCellSize;
+  float distance = length(float3(posW.x, 0.0f, posW.y) - gEyePosW);
+  float morph = saturate((distance - gMorphStart) / (gMorphEnd - gMorphStart));
+  gridPos -= frac(gridPos * 0.5f) * 2.0f * morph;
+  posW = gChunkOffset + gridPos * gCellSize;
+
+  vout.PosW = float3(posW.x, 0.0f, posW.y);
+  vout.NormalW = DecodeDirection(vin.NormalL);
+  vout.PosH = mul(float4(vout.PosW, 1.0f), gViewProj);
+
+  return vout;
+}
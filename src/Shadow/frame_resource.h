@@ -7,10 +7,14 @@
 #include "../dx_utils.h"
 #include "../math_helper.h"
 #include "../upload_buffer.h"
+#include "../vertex_formats.h"
 
 struct ObjectConstants {
   DirectX::XMFLOAT4X4 World = MathHelper::Identity4x4();
   DirectX::XMFLOAT4X4 TexTransform = MathHelper::Identity4x4();
+  DirectX::XMFLOAT3 PositionMin = {0.0f, 0.0f, 0.0f};
+  float _padding0 = 0.0f;
+  DirectX::XMFLOAT3 PositionExtent = {1.0f, 1.0f, 1.0f};
   int MaterialIndex = -1;
 };
 
@@ -63,10 +67,26 @@ struct AreaLight {
 };
 
 struct Vertex {
-  DirectX::XMFLOAT3 Pos;
-  DirectX::XMFLOAT3 Normal;
-  DirectX::XMFLOAT2 TexC;
-  DirectX::XMFLOAT3 TangentU;
+  VertexFormats::Position Pos;
+  VertexFormats::Direction Normal;
+  VertexFormats::TexCoord TexC;
+  VertexFormats::Direction TangentU;
+
+  static std::array<D3D12_INPUT_ELEMENT_DESC, 4> InputLayout() {
+    return {VertexElement("POSITION", &Vertex::Pos),
+            VertexElement("NORMAL", &Vertex::Normal),
+            VertexElement("TEXCOORD", &Vertex::TexC),
+            VertexElement("TANGENT", &Vertex::TangentU)};
+  }
+};
+
+// Vertex of the position-only stream read by depth-only passes.
+struct PositionVertex {
+  VertexFormats::Position Pos;
+
+  static std::array<D3D12_INPUT_ELEMENT_DESC, 1> InputLayout() {
+    return {VertexElement("POSITION", &PositionVertex::Pos)};
+  }
 };
 
 struct Material {
@@ -0,0 +1,56 @@
+// Constants and resources shared by the main and shadow passes, matching
+// the root signature built in ShadowRenderer::CreateRootSignature.
+
+#include "../../shaders/VertexFormats.hlsl"
+
+#define MaxLights 16
+
+struct Light {
+  float3 Color;
+  float Intensity;
+  float3 Direction;
+  float _Padding;
+};
+
+struct MaterialData {
+  float4 Albedo;
+  float3 FresnelR0;
+  float Roughness;
+  float Metallic;
+  float4x4 MatTransform;
+  uint DiffuseMapIndex;
+  uint NormalMapIndex;
+  uint MaterialPad1;
+  uint MaterialPad2;
+};
+
+StructuredBuffer<MaterialData> gMaterialData : register(t0, space1);
+
+cbuffer cbPerObject : register(b0) {
+  float4x4 gWorld;
+  float4x4 gTexTransform;
+  float3 gPositionMin;
+  float gPositionPad0;
+  float3 gPositionExtent;
+  int gMaterialIndex;
+};
+
+cbuffer cbPass : register(b1) {
+  float4x4 gView;
+  float4x4 gInvView;
+  float4x4 gProj;
+  float4x4 gInvProj;
+  float4x4 gViewProj;
+  float4x4 gInvViewProj;
+  float4x4 gShadowTransform;
+  float3 gEyePosW;
+  float cbPerObjectPad1;
+  float2 gRenderTargetSize;
+  float2 gInvRenderTargetSize;
+  float gNearZ;
+  float gFarZ;
+  float gTotalTime;
+  float gDeltaTime;
+
+  Light gLights[MaxLights];
+};
@@ -0,0 +1,42 @@
+#include "Common.hlsl"
+
+struct VertexIn {
+  VERTEX_POSITION PosL : POSITION;
+  VERTEX_DIRECTION NormalL : NORMAL;
+  VERTEX_TEXCOORD TexC : TEXCOORD;
+  VERTEX_DIRECTION TangentU : TANGENT;
+};
+
+struct VertexOut {
+  float4 PosH : SV_POSITION;
+  float3 PosW : POSITION;
+  float3 NormalW : NORMAL;
+};
+
+VertexOut VS(VertexIn vin) {
+  VertexOut vout = (VertexOut)0.0f;
+
+  float3 posL = DecodePosition(vin.PosL, gPositionMin, gPositionExtent);
+  float3 normalL = DecodeDirection(vin.NormalL);
+
+  float4 posW = mul(float4(posL, 1.0f), gWorld);
+  vout.PosW = posW.xyz;
+
+  vout.NormalW = mul(normalL, (float3x3)gWorld);
+  vout.PosH = mul(posW, gViewProj);
+
+  return vout;
+}
+
+float4 PS(VertexOut pin) : SV_Target {
+  MaterialData mat = gMaterialData[gMaterialIndex];
+  float3 normal = normalize(pin.NormalW);
+
+  float3 color = 0.1f * mat.Albedo.rgb;
+  for (int i = 0; i < 3; i++) {
+    float3 lightDir = -gLights[i].Direction;
+    color += mat.Albedo.rgb * gLights[i].Color *
+             max(dot(normal, lightDir), 0.0f);
+  }
+  return float4(color, mat.Albedo.a);
+}
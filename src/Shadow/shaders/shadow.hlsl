@@ -0,0 +1,23 @@
+// Depth-only pass into the shadow map, reading the position-only stream.
+
+#include "Common.hlsl"
+
+struct VertexIn {
+  VERTEX_POSITION PosL : POSITION;
+};
+
+struct VertexOut {
+  float4 PosH : SV_POSITION;
+};
+
+VertexOut VS(VertexIn vin) {
+  VertexOut vout = (VertexOut)0.0f;
+
+  float3 posL = DecodePosition(vin.PosL, gPositionMin, gPositionExtent);
+  float4 posW = mul(float4(posL, 1.0f), gWorld);
+  vout.PosH = mul(posW, gViewProj);
+
+  return vout;
+}
+
+void PS(VertexOut pin) {}
@@ -3,9 +3,10 @@
 //
 
 #include "shadow_renderer.h"
+#include "../geometry_arena.h"
 #include "../geometry_generator.h"
-#include <DDSTextureLoader.h>
-#include <ResourceUploadBatch.h>
+#include "../mesh_optimizer.h"
+#include "../mesh_welder.h"
 
 using namespace DirectX;
 
@@ -15,17 +16,20 @@ void ShadowRenderer::InitDirectX(const InitInfo &initInfo) {
   ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
 
   shadowMap = std::make_unique<ShadowMap>(device.Get(), 2048, 2048);
+  Assets = std::make_unique<AssetLoader>(device.Get(), commandQueue.Get());
 
   LoadTextures();
   CreateRootSignature();
   CreateDescriptorHeaps();
   CreateShadersAndInputLayout();
   CreateShapeGeometry();
-  CreateFrameResources();
   CreateMaterials();
   CreateRenderItems();
+  CreateFrameResources();
   CreatePSOs();
 
+  camera.SetPosition(0.0f, 2.0f, -15.0f);
+
   ThrowIfFailed(commandList->Close());
   ID3D12CommandList *cmdsLists[] = {commandList.Get()};
   commandQueue->ExecuteCommandLists(_countof(cmdsLists), cmdsLists);
@@ -41,6 +45,8 @@ void ShadowRenderer::Draw(const GameTimer &timer) {
   auto cmdListAllocater = CurrentFrameResource->CommandAllocator;
 
   ThrowIfFailed(cmdListAllocater->Reset());
+  ThrowIfFailed(
+      commandList->Reset(cmdListAllocater.Get(), PSOs["opaque"].Get()));
 
   ID3D12DescriptorHeap *descriptorHeaps[] = {srvDescriptorHeap.Get()};
   commandList->SetDescriptorHeaps(_countof(descriptorHeaps), descriptorHeaps);
@@ -115,6 +121,17 @@ void ShadowRenderer::Update(const GameTimer &timer) {
     WaitForSingleObject(eventHandle, INFINITE);
     CloseHandle(eventHandle);
   }
+
+  if (Assets->Pump() > 0) {
+    PublishTextures();
+  }
+
+  camera.UpdateViewMatrix();
+  UpdateObjectCBs(timer);
+  UpdateMaterialBuffer(timer);
+  UpdateShadowTransform(timer);
+  UpdateMainPassCB(timer);
+  UpdateShadowPassCB(timer);
 }
 
 void ShadowRenderer::LoadTextures() {
@@ -123,20 +140,53 @@ void ShadowRenderer::LoadTextures() {
 
   };
 
-  DirectX::ResourceUploadBatch upload(device.Get());
-
+  // Decoded and uploaded in the background; the first frames render with
+  // null SRVs in their slots.
   for (auto &tex : textures) {
-    std::wstring path = TEXTURE_DIR + tex.second;
-    auto texMap = std::make_unique<Texture>();
-    texMap->Name = tex.first;
-    texMap->FileName = path;
-    ThrowIfFailed(DirectX::CreateDDSTextureFromFile(
-        device.Get(), upload, texMap->FileName.c_str(),
-        texMap->Resource.GetAddressOf()))
+    Textures.push_back(
+        Assets->LoadTexture(tex.first, TEXTURE_DIR + tex.second));
+    TexturePublished.push_back(false);
   }
+}
 
-  auto finish = upload.End(commandQueue.Get());
-  finish.wait();
+void ShadowRenderer::PublishTextures() {
+  // A descriptor must not change while frames in flight may read it, so
+  // drain the queue once before swapping in the textures that just finished.
+  bool flushed = false;
+  for (size_t i = 0; i < Textures.size(); i++) {
+    if (TexturePublished[i] || !Textures[i].Ready()) {
+      continue;
+    }
+    if (!flushed) {
+      FlushCommandQueue();
+      flushed = true;
+    }
+    WriteTextureSrv(i, Textures[i].Get()->Resource.Get());
+    TexturePublished[i] = true;
+  }
+}
+
+void ShadowRenderer::WriteTextureSrv(size_t slot, ID3D12Resource *texture) {
+  auto srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{
+      .Format = DXGI_FORMAT_R8G8B8A8_UNORM,
+      .ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D,
+      .Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING,
+      .Texture2D =
+          D3D12_TEX2D_SRV{
+              .MostDetailedMip = 0,
+              .MipLevels = 1,
+              .ResourceMinLODClamp = 0.0f,
+          },
+  };
+  if (texture) {
+    srvDesc.Format = texture->GetDesc().Format;
+    srvDesc.Texture2D.MipLevels = texture->GetDesc().MipLevels;
+  }
+  device->CreateShaderResourceView(
+      texture, &srvDesc,
+      CD3DX12_CPU_DESCRIPTOR_HANDLE(
+          srvDescriptorHeap->GetCPUDescriptorHandleForHeapStart(), (INT)slot,
+          cbvUavDescriptorSize));
 }
 
 void ShadowRenderer::CreateRootSignature() {
@@ -186,50 +236,22 @@ void ShadowRenderer::CreateDescriptorHeaps() {
   ThrowIfFailed(device->CreateDescriptorHeap(
       &srvHeapDesc, IID_PPV_ARGS(srvDescriptorHeap.GetAddressOf())));
 
-  CD3DX12_CPU_DESCRIPTOR_HANDLE descriptorHandle(
-      srvDescriptorHeap->GetCPUDescriptorHandleForHeapStart());
-  std::vector<ComPtr<ID3D12Resource>> texturesList; // TODO: fill texture list
-
-  auto srvDesc = D3D12_SHADER_RESOURCE_VIEW_DESC{
-      .ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D,
-      .Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING,
-      .Texture2D =
-          D3D12_TEX2D_SRV{
-              .MostDetailedMip = 0,
-              .ResourceMinLODClamp = 0.0f,
-          },
-  };
-
-  for (auto &i : texturesList) {
-    srvDesc.Format = i->GetDesc().Format;
-    srvDesc.Texture2D.MipLevels = i->GetDesc().MipLevels;
-    device->CreateShaderResourceView(i.Get(), &srvDesc, descriptorHandle);
-    descriptorHandle.Offset(1, cbvUavDescriptorSize);
+  // Texture slots start out null and are filled in by PublishTextures.
+  for (size_t i = 0; i < Textures.size(); i++) {
+    WriteTextureSrv(i, nullptr);
   }
 
-  ShadowMapHeapIndex = texturesList.size();
+  ShadowMapHeapIndex = (UINT)Textures.size();
   NullTextureSrvIndex = ShadowMapHeapIndex + 1;
 
   auto srvCPUStart = srvDescriptorHeap->GetCPUDescriptorHandleForHeapStart();
   auto srvGPUStart = srvDescriptorHeap->GetGPUDescriptorHandleForHeapStart();
   auto dsvCPUStart = dsvHeap->GetCPUDescriptorHandleForHeapStart();
 
-  auto nullSrv = CD3DX12_CPU_DESCRIPTOR_HANDLE(srvCPUStart, NullTextureSrvIndex,
-                                               cbvUavDescriptorSize);
+  WriteTextureSrv(NullTextureSrvIndex, nullptr);
   NullSrv = CD3DX12_GPU_DESCRIPTOR_HANDLE(srvGPUStart, NullTextureSrvIndex,
                                           cbvUavDescriptorSize);
 
-  srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
-  srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
-  srvDesc.Texture2D = D3D12_TEX2D_SRV{
-      .MostDetailedMip = 0,
-      .MipLevels = 1,
-      .PlaneSlice = 0,
-      .ResourceMinLODClamp = 0.0f,
-  };
-
-  device->CreateShaderResourceView(nullptr, &srvDesc, nullSrv);
-
   shadowMap->BuildDescriptors(
       CD3DX12_CPU_DESCRIPTOR_HANDLE(srvCPUStart, ShadowMapHeapIndex,
                                     cbvUavDescriptorSize),
@@ -242,27 +264,23 @@ void ShadowRenderer::CreateShadersAndInputLayout() {
   constexpr D3D_SHADER_MACRO alphaTestDefines[] = {"ALPHA_TEST", "1", nullptr,
                                                    nullptr};
 
+  auto defines = VertexFormats::ShaderDefines();
   Shaders["mainVS"] =
-      DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", nullptr, "VS", "vs_5_1");
+      DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", defines, "VS", "vs_5_1");
   Shaders["mainOpaquePS"] =
-      DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", nullptr, "PS", "ps_5_1");
+      DXUtils::CompileShader(SHADER_DIR L"/main.hlsl", defines, "PS", "ps_5_1");
   Shaders["shadowVS"] = DXUtils::CompileShader(SHADER_DIR L"/shadow.hlsl",
-                                               nullptr, "VS", "vs_5_1");
+                                               defines, "VS", "vs_5_1");
   Shaders["shadowOpaquePS"] = DXUtils::CompileShader(SHADER_DIR L"/shadow.hlsl",
-                                                     nullptr, "PS", "ps_5_1");
+                                                     defines, "PS", "ps_5_1");
   Shaders["shadowAlphaPS"] = DXUtils::CompileShader(SHADER_DIR L"/shadow.hlsl",
-                                                    nullptr, "PS", "ps_5_1");
-
-  inputLayout = {
-      {"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-      {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 12,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-      {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 24,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-      {"TANGENT", 0, DXGI_FORMAT_R32G32_FLOAT, 0, 32,
-       D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0},
-  };
+                                                    defines, "PS", "ps_5_1");
+
+  auto layout = Vertex::InputLayout();
+  inputLayout.assign(layout.begin(), layout.end());
+
+  auto positionLayout = PositionVertex::InputLayout();
+  positionInputLayout.assign(positionLayout.begin(), positionLayout.end());
 }
 
 void ShadowRenderer::CreateShapeGeometry() {
@@ -275,141 +293,98 @@ void ShadowRenderer::CreateShapeGeometry() {
   GeometryGenerator::MeshData quad =
       geoGen.CreateQuad(0.0f, 0.0f, 1.0f, 1.0f, 0.0f);
 
-  //
-  // We are concatenating all the geometry into one big vertex/index buffer.  So
-  // define the regions in the buffer each submesh covers.
-  //
+  // Reorder every mesh for the post-transform cache, overdraw and vertex fetch
+  // before it is packed; both the shadow and main passes benefit.
+  std::pair<const char *, GeometryGenerator::MeshData *> meshes[] = {
+      {"box", &box},
+      {"grid", &grid},
+      {"sphere", &sphere},
+      {"cylinder", &cylinder},
+      {"quad", &quad}};
+  for (auto &[name, mesh] : meshes) {
+    auto report = MeshOptimizer::Optimize(*mesh);
+    ::OutputDebugStringA(MeshOptimizer::Describe(name, report).c_str());
+  }
 
-  // Cache the vertex offsets to each object in the concatenated vertex buffer.
-  UINT boxVertexOffset = 0;
-  UINT gridVertexOffset = (UINT)box.Vertices.size();
-  UINT sphereVertexOffset = gridVertexOffset + (UINT)grid.Vertices.size();
-  UINT cylinderVertexOffset = sphereVertexOffset + (UINT)sphere.Vertices.size();
-  UINT quadVertexOffset = cylinderVertexOffset + (UINT)cylinder.Vertices.size();
-
-  // Cache the starting index for each object in the concatenated index buffer.
-  UINT boxIndexOffset = 0;
-  UINT gridIndexOffset = (UINT)box.Indices32.size();
-  UINT sphereIndexOffset = gridIndexOffset + (UINT)grid.Indices32.size();
-  UINT cylinderIndexOffset = sphereIndexOffset + (UINT)sphere.Indices32.size();
-  UINT quadIndexOffset = cylinderIndexOffset + (UINT)cylinder.Indices32.size();
-
-  SubmeshGeometry boxSubmesh;
-  boxSubmesh.IndexCount = (UINT)box.Indices32.size();
-  boxSubmesh.StartIndexLocation = boxIndexOffset;
-  boxSubmesh.BaseVertexLocation = boxVertexOffset;
-
-  SubmeshGeometry gridSubmesh;
-  gridSubmesh.IndexCount = (UINT)grid.Indices32.size();
-  gridSubmesh.StartIndexLocation = gridIndexOffset;
-  gridSubmesh.BaseVertexLocation = gridVertexOffset;
-
-  SubmeshGeometry sphereSubmesh;
-  sphereSubmesh.IndexCount = (UINT)sphere.Indices32.size();
-  sphereSubmesh.StartIndexLocation = sphereIndexOffset;
-  sphereSubmesh.BaseVertexLocation = sphereVertexOffset;
-
-  SubmeshGeometry cylinderSubmesh;
-  cylinderSubmesh.IndexCount = (UINT)cylinder.Indices32.size();
-  cylinderSubmesh.StartIndexLocation = cylinderIndexOffset;
-  cylinderSubmesh.BaseVertexLocation = cylinderVertexOffset;
-
-  SubmeshGeometry quadSubmesh;
-  quadSubmesh.IndexCount = (UINT)quad.Indices32.size();
-  quadSubmesh.StartIndexLocation = quadIndexOffset;
-  quadSubmesh.BaseVertexLocation = quadVertexOffset;
+  // Pack every mesh into one vertex/index buffer.
+  GeometryArena arena;
+  for (auto &[name, mesh] : meshes) {
+    arena.Add(name, *mesh);
+  }
+  auto geo = arena.Build<Vertex>(
+      "shapeGeo", device.Get(), commandList.Get(),
+      [](Vertex &out, const GeometryGenerator::Vertex &in,
+         const SubmeshGeometry &submesh) {
+        VertexFormats::EncodePosition(out.Pos, in.Position,
+                                      submesh.Quantization);
+        VertexFormats::EncodeDirection(out.Normal, in.Normal);
+        VertexFormats::EncodeTexCoord(out.TexC, in.TexC);
+        VertexFormats::EncodeDirection(out.TangentU, in.TangentU);
+      });
 
   //
-  // Extract the vertex elements we are interested in and pack the
-  // vertices of all the meshes into one vertex buffer.
+  // Depth-only passes read just positions.  Weld each mesh on position alone
+  // so vertices split by UV/normal seams are fetched and shaded once.
   //
 
-  auto totalVertexCount = box.Vertices.size() + grid.Vertices.size() +
-                          sphere.Vertices.size() + cylinder.Vertices.size() +
-                          quad.Vertices.size();
-
-  std::vector<Vertex> vertices(totalVertexCount);
-
-  UINT k = 0;
-  for (size_t i = 0; i < box.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = box.Vertices[i].Position;
-    vertices[k].Normal = box.Vertices[i].Normal;
-    vertices[k].TexC = box.Vertices[i].TexC;
-    vertices[k].TangentU = box.Vertices[i].TangentU;
+  std::vector<PositionVertex> positions;
+  std::vector<std::uint32_t> positionIndices;
+  size_t largestMesh = 0;
+  for (auto &[name, mesh] : meshes) {
+    std::vector<XMFLOAT3> weldedPositions;
+    std::vector<std::uint32_t> weldedIndices;
+    MeshWelder::WeldPositions(mesh->Vertices, mesh->Indices32, weldedPositions,
+                              weldedIndices);
+
+    SubmeshGeometry submesh;
+    submesh.IndexCount = (UINT)weldedIndices.size();
+    submesh.StartIndexLocation = (UINT)positionIndices.size();
+    submesh.BaseVertexLocation = (INT)positions.size();
+    submesh.Bounds = geo->DrawArgs[name].Bounds;
+    submesh.SphereBounds = geo->DrawArgs[name].SphereBounds;
+    submesh.Quantization = geo->DrawArgs[name].Quantization;
+    geo->PositionDrawArgs[name] = submesh;
+
+    for (auto &p : weldedPositions) {
+      positions.emplace_back();
+      VertexFormats::EncodePosition(positions.back().Pos, p,
+                                    submesh.Quantization);
+    }
+    positionIndices.insert(positionIndices.end(), weldedIndices.begin(),
+                           weldedIndices.end());
+    largestMesh = std::max(largestMesh, weldedPositions.size());
   }
 
-  for (size_t i = 0; i < grid.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = grid.Vertices[i].Position;
-    vertices[k].Normal = grid.Vertices[i].Normal;
-    vertices[k].TexC = grid.Vertices[i].TexC;
-    vertices[k].TangentU = grid.Vertices[i].TangentU;
+  // As in GeometryArena, indices are relative to BaseVertexLocation, so they
+  // narrow to 16 bits whenever every welded mesh fits.
+  auto positionIndexFormat =
+      largestMesh <= 0xffff ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+  std::vector<std::uint16_t> narrowIndices;
+  const void *positionIndexData = positionIndices.data();
+  UINT positionIndexByteSize =
+      (UINT)positionIndices.size() * sizeof(std::uint32_t);
+  if (positionIndexFormat == DXGI_FORMAT_R16_UINT) {
+    narrowIndices.assign(positionIndices.begin(), positionIndices.end());
+    positionIndexData = narrowIndices.data();
+    positionIndexByteSize =
+        (UINT)narrowIndices.size() * sizeof(std::uint16_t);
   }
 
-  for (size_t i = 0; i < sphere.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = sphere.Vertices[i].Position;
-    vertices[k].Normal = sphere.Vertices[i].Normal;
-    vertices[k].TexC = sphere.Vertices[i].TexC;
-    vertices[k].TangentU = sphere.Vertices[i].TangentU;
-  }
+  const UINT positionByteSize =
+      (UINT)positions.size() * sizeof(PositionVertex);
 
-  for (size_t i = 0; i < cylinder.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = cylinder.Vertices[i].Position;
-    vertices[k].Normal = cylinder.Vertices[i].Normal;
-    vertices[k].TexC = cylinder.Vertices[i].TexC;
-    vertices[k].TangentU = cylinder.Vertices[i].TangentU;
-  }
+  geo->PositionGPUBuffer = DXUtils::CreateDefaultBuffer(
+      device.Get(), commandList.Get(), positions.data(), positionByteSize,
+      geo->PositionBufferUploader);
 
-  for (int i = 0; i < quad.Vertices.size(); ++i, ++k) {
-    vertices[k].Pos = quad.Vertices[i].Position;
-    vertices[k].Normal = quad.Vertices[i].Normal;
-    vertices[k].TexC = quad.Vertices[i].TexC;
-    vertices[k].TangentU = quad.Vertices[i].TangentU;
-  }
+  geo->PositionIndexGPUBuffer = DXUtils::CreateDefaultBuffer(
+      device.Get(), commandList.Get(), positionIndexData,
+      positionIndexByteSize, geo->PositionIndexBufferUploader);
 
-  std::vector<std::uint16_t> indices;
-  indices.insert(indices.end(), std::begin(box.GetIndices16()),
-                 std::end(box.GetIndices16()));
-  indices.insert(indices.end(), std::begin(grid.GetIndices16()),
-                 std::end(grid.GetIndices16()));
-  indices.insert(indices.end(), std::begin(sphere.GetIndices16()),
-                 std::end(sphere.GetIndices16()));
-  indices.insert(indices.end(), std::begin(cylinder.GetIndices16()),
-                 std::end(cylinder.GetIndices16()));
-  indices.insert(indices.end(), std::begin(quad.GetIndices16()),
-                 std::end(quad.GetIndices16()));
-
-  const UINT vbByteSize = (UINT)vertices.size() * sizeof(Vertex);
-  const UINT ibByteSize = (UINT)indices.size() * sizeof(std::uint16_t);
-
-  auto geo = std::make_unique<MeshGeometry>();
-  geo->Name = "shapeGeo";
-
-  ThrowIfFailed(D3DCreateBlob(vbByteSize, &geo->VertexCPUBuffer));
-  CopyMemory(geo->VertexCPUBuffer->GetBufferPointer(), vertices.data(),
-             vbByteSize);
-
-  ThrowIfFailed(D3DCreateBlob(ibByteSize, &geo->IndexCPUBuffer));
-  CopyMemory(geo->IndexCPUBuffer->GetBufferPointer(), indices.data(),
-             ibByteSize);
-
-  geo->VertexGPUBuffer = DXUtils::CreateDefaultBuffer(
-      device.Get(), commandList.Get(), vertices.data(), vbByteSize,
-      geo->VertexBufferUploader);
-
-  geo->IndexGPUBuffer = DXUtils::CreateDefaultBuffer(
-      device.Get(), commandList.Get(), indices.data(), ibByteSize,
-      geo->IndexBufferUploader);
-
-  geo->VertexByteStride = sizeof(Vertex);
-  geo->VertexBufferByteSize = vbByteSize;
-  geo->IndexFormat = DXGI_FORMAT_R16_UINT;
-  geo->IndexBufferByteSize = ibByteSize;
-
-  geo->DrawArgs["box"] = boxSubmesh;
-  geo->DrawArgs["grid"] = gridSubmesh;
-  geo->DrawArgs["sphere"] = sphereSubmesh;
-  geo->DrawArgs["cylinder"] = cylinderSubmesh;
-  geo->DrawArgs["quad"] = quadSubmesh;
+  geo->PositionByteStride = sizeof(PositionVertex);
+  geo->PositionBufferByteSize = positionByteSize;
+  geo->PositionIndexFormat = positionIndexFormat;
+  geo->PositionIndexBufferByteSize = positionIndexByteSize;
 
   Geometries[geo->Name] = std::move(geo);
 }
@@ -467,12 +442,56 @@ void ShadowRenderer::CreateMaterials() {
   Materials["sky"] = std::move(sky);
 }
 
-void ShadowRenderer::CreateRenderItems() {}
+void ShadowRenderer::CreateRenderItems() {
+  auto geo = Geometries["shapeGeo"].get();
+  auto addItem = [&](const std::string &name, const std::string &material,
+                     FXMMATRIX world, FXMMATRIX texTransform) {
+    auto item = std::make_unique<RenderItem>();
+    XMStoreFloat4x4(&item->World, world);
+    XMStoreFloat4x4(&item->TexTransform, texTransform);
+    item->ObjCBIndex = (UINT)AllRenderItems.size();
+    item->Mat = Materials[material].get();
+    item->Geo = geo;
+    item->PrimitiveType = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
+    item->IndexCount = geo->DrawArgs[name].IndexCount;
+    item->StartIndexLocation = geo->DrawArgs[name].StartIndexLocation;
+    item->BaseVertexLocation = geo->DrawArgs[name].BaseVertexLocation;
+    item->Quantization = geo->DrawArgs[name].Quantization;
+    // The depth pass draws the welded position stream, whose ranges differ
+    // from the full vertices'.
+    item->DepthIndexCount = geo->PositionDrawArgs[name].IndexCount;
+    item->DepthStartIndexLocation =
+        geo->PositionDrawArgs[name].StartIndexLocation;
+    item->DepthBaseVertexLocation =
+        geo->PositionDrawArgs[name].BaseVertexLocation;
+    LayerItems[(int)RenderLayer::Opaque].push_back(item.get());
+    AllRenderItems.push_back(std::move(item));
+  };
+
+  addItem("box", "bricks0",
+          XMMatrixScaling(2.0f, 1.0f, 2.0f) *
+              XMMatrixTranslation(0.0f, 0.5f, 0.0f),
+          XMMatrixScaling(1.0f, 0.5f, 1.0f));
+  addItem("grid", "tile0", XMMatrixIdentity(),
+          XMMatrixScaling(8.0f, 8.0f, 1.0f));
+
+  for (int i = 0; i < 5; ++i) {
+    auto z = -10.0f + i * 5.0f;
+    addItem("cylinder", "bricks0", XMMatrixTranslation(-5.0f, 1.5f, z),
+            XMMatrixScaling(1.5f, 2.0f, 1.0f));
+    addItem("cylinder", "bricks0", XMMatrixTranslation(+5.0f, 1.5f, z),
+            XMMatrixScaling(1.5f, 2.0f, 1.0f));
+    addItem("sphere", "mirror0", XMMatrixTranslation(-5.0f, 3.5f, z),
+            XMMatrixIdentity());
+    addItem("sphere", "mirror0", XMMatrixTranslation(+5.0f, 3.5f, z),
+            XMMatrixIdentity());
+  }
+}
 
 void ShadowRenderer::CreateFrameResources() {
   for (int i = 0; i < FrameResourceCount; ++i) {
     FrameResources.push_back(std::make_unique<FrameResource>(
-        device.Get(), 1, (UINT)AllRenderItems.size(), (UINT)Materials.size()));
+        device.Get(), 2, (UINT)AllRenderItems.size(), (UINT)Materials.size()));
   }
 }
 
@@ -486,6 +505,7 @@ void ShadowRenderer::CreatePSOs() {
       .SampleMask = UINT_MAX,
       .RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT),
       .DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT),
+      .InputLayout = {inputLayout.data(), (UINT)inputLayout.size()},
       .PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE,
       .NumRenderTargets = 1,
       .RTVFormats = {backBufferFormat},
@@ -504,15 +524,21 @@ void ShadowRenderer::CreatePSOs() {
       .pRootSignature = RootSignature.Get(),
       .VS = CD3DX12_SHADER_BYTECODE(Shaders["shadowVS"].Get()),
       .PS = CD3DX12_SHADER_BYTECODE(Shaders["shadowOpaquePS"].Get()),
-      .RasterizerState =
-          {
-              .DepthBias = 100000,
-              .DepthBiasClamp = 1.0f,
-              .SlopeScaledDepthBias = 1.0f,
-          },
+      .BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT),
+      .SampleMask = UINT_MAX,
+      .RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT),
+      .DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT),
+      .InputLayout = {positionInputLayout.data(),
+                      (UINT)positionInputLayout.size()},
+      .PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE,
       .NumRenderTargets = 0,
       .RTVFormats = {DXGI_FORMAT_UNKNOWN},
+      .DSVFormat = DXGI_FORMAT_D24_UNORM_S8_UINT,
+      .SampleDesc = {.Count = 1, .Quality = 0},
   };
+  samplePsoDesc.RasterizerState.DepthBias = 100000;
+  samplePsoDesc.RasterizerState.DepthBiasClamp = 1.0f;
+  samplePsoDesc.RasterizerState.SlopeScaledDepthBias = 1.0f;
   ThrowIfFailed(device->CreateGraphicsPipelineState(
       &samplePsoDesc, IID_PPV_ARGS(&PSOs["shadowOpaque"])));
 }
@@ -540,6 +566,36 @@ void ShadowRenderer::DrawRenderItems(
   }
 }
 
+void ShadowRenderer::DrawRenderItemsDepthOnly(
+    ID3D12GraphicsCommandList *cmdList,
+    const std::vector<RenderItem *> &renderItems) {
+  UINT objCBByteSize = DXUtils::CalcConstantBufferSize(sizeof(ObjectConstants));
+
+  auto objectCB = CurrentFrameResource->ObjectConstantsBuffer->Resource();
+
+  for (auto &item : renderItems) {
+    // The depth-only PSOs read the position stream layout; geometry without
+    // one cannot be bound to them.
+    if (!item->Geo->HasPositionStream()) {
+      continue;
+    }
+
+    auto positionBufferView = item->Geo->PositionBufferView();
+    auto indexBufferView = item->Geo->PositionIndexBufferView();
+    cmdList->IASetVertexBuffers(0, 1, &positionBufferView);
+    cmdList->IASetIndexBuffer(&indexBufferView);
+    cmdList->IASetPrimitiveTopology(item->PrimitiveType);
+    D3D12_GPU_VIRTUAL_ADDRESS objCBAddress =
+        objectCB->GetGPUVirtualAddress() + item->ObjCBIndex * objCBByteSize;
+
+    cmdList->SetGraphicsRootConstantBufferView(0, objCBAddress);
+
+    cmdList->DrawIndexedInstanced(item->DepthIndexCount, 1,
+                                  item->DepthStartIndexLocation,
+                                  item->DepthBaseVertexLocation, 0);
+  }
+}
+
 void ShadowRenderer::DrawSceneToShadowMap() {
   auto shadowViewport = shadowMap->Viewport();
   auto shadowScissorRect = shadowMap->ScissorRect();
@@ -568,7 +624,8 @@ void ShadowRenderer::DrawSceneToShadowMap() {
 
   commandList->SetPipelineState(PSOs["shadowOpaque"].Get());
 
-  DrawRenderItems(commandList.Get(), LayerItems[(int)RenderLayer::Opaque]);
+  DrawRenderItemsDepthOnly(commandList.Get(),
+                           LayerItems[(int)RenderLayer::Opaque]);
 
   // Change to GENERIC_READ
   barrier = CD3DX12_RESOURCE_BARRIER::Transition(
@@ -588,6 +645,8 @@ void ShadowRenderer::UpdateObjectCBs(const GameTimer &timer) {
       XMStoreFloat4x4(&objConstants.World, XMMatrixTranspose(world));
       XMStoreFloat4x4(&objConstants.TexTransform,
                       XMMatrixTranspose(texTransform));
+      objConstants.PositionMin = i->Quantization.Min;
+      objConstants.PositionExtent = i->Quantization.Extent;
       objConstants.MaterialIndex = i->Mat->MatCBIndex;
 
       currenObjecttCB->CopyData(i->ObjCBIndex, objConstants);
@@ -619,7 +678,35 @@ void ShadowRenderer::UpdateMaterialBuffer(const GameTimer &timer) {
   }
 }
 
-void ShadowRenderer::UpdateShadowTransform(const GameTimer &timer) {}
+void ShadowRenderer::UpdateShadowTransform(const GameTimer &timer) {
+  // Only the first light casts shadows; fit its orthographic frustum around
+  // the scene bounds.
+  XMVECTOR lightDir = XMLoadFloat3(&LightDirections[0]);
+  XMVECTOR targetPos = XMLoadFloat3(&SceneBounds.Center);
+  XMVECTOR lightPos = -2.0f * SceneBounds.Radius * lightDir + targetPos;
+  XMVECTOR lightUp = XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  XMMATRIX view = XMMatrixLookAtLH(lightPos, targetPos, lightUp);
+
+  XMStoreFloat3(&LightPosW, lightPos);
+
+  XMFLOAT3 center;
+  XMStoreFloat3(&center, XMVector3TransformCoord(targetPos, view));
+  auto radius = SceneBounds.Radius;
+  LightNearZ = center.z - radius;
+  LightFarZ = center.z + radius;
+  XMMATRIX proj =
+      XMMatrixOrthographicOffCenterLH(center.x - radius, center.x + radius,
+                                      center.y - radius, center.y + radius,
+                                      LightNearZ, LightFarZ);
+
+  // NDC space [-1, 1]^2 to texture space [0, 1]^2.
+  XMMATRIX toTexture(0.5f, 0.0f, 0.0f, 0.0f, 0.0f, -0.5f, 0.0f, 0.0f, 0.0f,
+                     0.0f, 1.0f, 0.0f, 0.5f, 0.5f, 0.0f, 1.0f);
+
+  XMStoreFloat4x4(&LightView, view);
+  XMStoreFloat4x4(&LightProj, proj);
+  XMStoreFloat4x4(&ShadowTransform, view * proj * toTexture);
+}
 
 void ShadowRenderer::UpdateMainPassCB(const GameTimer &timer) {
   XMMATRIX view = camera.GetView();
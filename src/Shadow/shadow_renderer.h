@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "../asset_loader.h"
 #include "../camera.h"
 #include "../renderer.h"
 #include "frame_resource.h"
@@ -36,6 +37,12 @@ struct RenderItem {
   UINT IndexCount = 0;
   UINT StartIndexLocation = 0;
   int BaseVertexLocation = 0;
+  PositionQuantization Quantization;
+
+  // Draw arguments into the geometry's position-only stream.
+  UINT DepthIndexCount = 0;
+  UINT DepthStartIndexLocation = 0;
+  int DepthBaseVertexLocation = 0;
 };
 
 class ShadowRenderer : public Renderer {
@@ -47,6 +54,8 @@ public:
 
 private:
   void LoadTextures();
+  void PublishTextures();
+  void WriteTextureSrv(size_t slot, ID3D12Resource *texture);
   void CreateRootSignature();
   void CreateDescriptorHeaps();
   void CreateShadersAndInputLayout();
@@ -59,6 +68,9 @@ private:
   void DrawRenderItems(
     ID3D12GraphicsCommandList *cmdList,
     const std::vector<RenderItem*> &renderItems);
+  void DrawRenderItemsDepthOnly(
+    ID3D12GraphicsCommandList *cmdList,
+    const std::vector<RenderItem*> &renderItems);
   void DrawSceneToShadowMap();
 
   void UpdateObjectCBs(const GameTimer &timer);
@@ -74,7 +86,12 @@ private:
   PassConstants ShadowPassCB;
 
   DirectX::XMFLOAT4X4 ShadowTransform = MathHelper::Identity4x4();
-  DirectX::XMFLOAT3 LightDirections[3];
+  DirectX::XMFLOAT3 LightDirections[3] = {{0.57735f, -0.57735f, 0.57735f},
+                                          {-0.57735f, -0.57735f, 0.57735f},
+                                          {0.0f, -0.707f, -0.707f}};
+  // Encloses the grid, so the shadow map covers the whole floor.
+  DirectX::BoundingSphere SceneBounds = {{0.0f, 0.0f, 0.0f},
+                                         sqrtf(10.0f * 10.0f + 15.0f * 15.0f)};
 
   DirectX::XMFLOAT4X4 LightView = MathHelper::Identity4x4();
   DirectX::XMFLOAT4X4 LightProj = MathHelper::Identity4x4();
@@ -97,9 +114,19 @@ private:
   std::vector<RenderItem*> LayerItems[(int)RenderLayer::Count];
 
   std::vector<D3D12_INPUT_ELEMENT_DESC> inputLayout;
+  std::vector<D3D12_INPUT_ELEMENT_DESC> positionInputLayout;
   std::unique_ptr<ShadowMap> shadowMap = nullptr;
   std::unordered_map<std::string, ComPtr<ID3DBlob>> Shaders;
   std::unordered_map<std::string, ComPtr<ID3D12PipelineState>> PSOs;
   std::unordered_map<std::string, std::unique_ptr<MeshGeometry>> Geometries;
   std::unordered_map<std::string, std::unique_ptr<Material>> Materials;
+
+  // Textures in descriptor heap order, and whether each slot holds its SRV
+  // yet.
+  std::vector<AssetLoader::Handle<Texture>> Textures;
+  std::vector<bool> TexturePublished;
+
+  // Last, so it is destroyed first and its workers never outlive what they
+  // load into.
+  std::unique_ptr<AssetLoader> Assets;
 };
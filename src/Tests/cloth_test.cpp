@@ -0,0 +1,150 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "../cpu_cloth.h"
+#include "../geometry_generator.h"
+#include "../simd.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <utility>
+#include <vector>
+
+using namespace DirectX;
+
+namespace {
+constexpr std::uint32_t GridSize = 16;
+constexpr int Steps = 120;
+constexpr float StepTime = 1.0f / 60.0f;
+constexpr float Gravity = 9.8f;
+
+// Joules the hanging cloth may gain over its starting energy, which damping
+// and the constraints can only take away.
+constexpr double EnergySlack = 1e-3;
+// Largest stretch or compression of an edge, relative to its rest length.
+constexpr float MaxStrain = 0.1f;
+
+int Failures = 0;
+
+void Check(bool passed, const char *what) {
+  std::printf("%-48s %s\n", what, passed ? "ok" : "FAILED");
+  Failures += passed ? 0 : 1;
+}
+
+// A grid hanging from the two corners of its first row.
+struct HangingCloth {
+  GeometryGenerator::MeshData Grid;
+  CpuCloth Cloth;
+
+  explicit HangingCloth(CpuCloth::Kernel kernels)
+      : Grid(GeometryGenerator().CreateGrid(1.0f, 1.0f, GridSize, GridSize)),
+        Cloth(Positions(Grid), Grid.Indices32, Settings(kernels)) {
+    Cloth.SetInverseMass(0, 0.0f);
+    Cloth.SetInverseMass(GridSize - 1, 0.0f);
+  }
+
+  static std::vector<XMFLOAT3>
+  Positions(const GeometryGenerator::MeshData &grid) {
+    std::vector<XMFLOAT3> positions;
+    for (auto &vertex : grid.Vertices) {
+      positions.push_back(vertex.Position);
+    }
+    return positions;
+  }
+
+  static CpuCloth::Settings Settings(CpuCloth::Kernel kernels) {
+    CpuCloth::Settings settings;
+    settings.Gravity = {0.0f, -Gravity, 0.0f};
+    settings.Substeps = 8;
+    settings.Kernels = kernels;
+    return settings;
+  }
+};
+
+bool Identical(const CpuCloth &a, const CpuCloth &b) {
+  for (size_t p = 0; p < a.ParticleCount(); p++) {
+    auto pa = a.Position(p), pb = b.Position(p);
+    if (pa.x != pb.x || pa.y != pb.y || pa.z != pb.z) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Kinetic plus gravitational energy, taking each particle's velocity over
+// the last step.  The grid starts at rest at height 0, so at energy 0.
+double Energy(const CpuCloth &cloth, const std::vector<XMFLOAT3> &previous,
+              float mass) {
+  double energy = 0.0;
+  for (size_t p = 0; p < cloth.ParticleCount(); p++) {
+    auto position = cloth.Position(p);
+    XMVECTOR v = (XMLoadFloat3(&position) - XMLoadFloat3(&previous[p])) /
+                 StepTime;
+    auto speed2 = XMVectorGetX(XMVector3LengthSq(v));
+    energy += mass * (0.5 * speed2 + Gravity * position.y);
+  }
+  return energy;
+}
+
+// Largest |length / rest length - 1| over the grid's edges.
+float Strain(const HangingCloth &hanging) {
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> edges;
+  auto &indices = hanging.Grid.Indices32;
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    for (int k = 0; k < 3; k++) {
+      edges.push_back({indices[t + k], indices[t + (k + 1) % 3]});
+    }
+  }
+
+  float strain = 0.0f;
+  for (auto [a, b] : edges) {
+    auto pa = hanging.Cloth.Position(a), pb = hanging.Cloth.Position(b);
+    auto &ra = hanging.Grid.Vertices[a].Position;
+    auto &rb = hanging.Grid.Vertices[b].Position;
+    auto length =
+        XMVectorGetX(XMVector3Length(XMLoadFloat3(&pb) - XMLoadFloat3(&pa)));
+    auto rest =
+        XMVectorGetX(XMVector3Length(XMLoadFloat3(&rb) - XMLoadFloat3(&ra)));
+    strain = std::max(strain, std::abs(length / rest - 1.0f));
+  }
+  return strain;
+}
+} // namespace
+
+// Hangs the cloth for two seconds and checks the SIMD and parallel kernels
+// against the scalar reference, that no step adds energy, and that the
+// constraints hold.  Returns non-zero if any check fails.
+int main() {
+  std::printf("simd width %zu\n", Simd::Width);
+  auto &pool = ThreadPool::Shared();
+
+  HangingCloth scalar(CpuCloth::Kernel::Scalar);
+  HangingCloth simd(CpuCloth::Kernel::Simd);
+  HangingCloth parallel(CpuCloth::Kernel::Simd);
+
+  auto particleMass = scalar.Cloth.Parameters().Mass /
+                      (float)scalar.Cloth.ParticleCount();
+  std::vector<XMFLOAT3> previous(scalar.Cloth.ParticleCount());
+  bool simdMatches = true, parallelMatches = true;
+  double maxEnergy = 0.0;
+  for (int s = 0; s < Steps; s++) {
+    scalar.Cloth.Output({previous.data(), sizeof(XMFLOAT3)});
+    scalar.Cloth.Execute(StepTime);
+    simd.Cloth.Execute(StepTime);
+    parallel.Cloth.Execute(StepTime, &pool);
+
+    simdMatches &= Identical(scalar.Cloth, simd.Cloth);
+    parallelMatches &= Identical(simd.Cloth, parallel.Cloth);
+    maxEnergy =
+        std::max(maxEnergy, Energy(scalar.Cloth, previous, particleMass));
+  }
+  auto strain = Strain(scalar);
+  std::printf("max energy %.6f J, max strain %.4f\n", maxEnergy, strain);
+
+  Check(simdMatches, "simd kernels match the scalar kernels");
+  Check(parallelMatches, "parallel steps match serial steps");
+  Check(maxEnergy <= EnergySlack, "energy never exceeds the starting energy");
+  Check(strain <= MaxStrain, "edges stay within 10% of their rest length");
+  return Failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,189 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "asset_loader.h"
+#include <DDSTextureLoader.h>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+AssetLoader::AssetLoader(ID3D12Device *device, ID3D12CommandQueue *queue,
+                         ThreadPool &pool)
+    : Device(device), Queue(queue), Pool(pool) {
+  ThrowIfFailed(Device->CreateFence(0, D3D12_FENCE_FLAG_NONE,
+                                    IID_PPV_ARGS(Fence.GetAddressOf())));
+}
+
+AssetLoader::~AssetLoader() {
+  std::unique_lock lock(Mutex);
+  DecodeDone.wait(lock, [this]() { return Decoding == 0; });
+  lock.unlock();
+  WaitForFence(FenceValue);
+}
+
+AssetLoader::Handle<Texture>
+AssetLoader::LoadTexture(const std::string &name,
+                         const std::wstring &fileName) {
+  // The subresources point into the file contents, which therefore travel
+  // with the texture until its upload is recorded.
+  struct DecodedTexture {
+    std::unique_ptr<Texture> Tex;
+    std::vector<std::uint8_t> File;
+    std::vector<D3D12_SUBRESOURCE_DATA> Subresources;
+  };
+
+  auto decode = [device = Device, name, fileName]() {
+    DecodedTexture decoded;
+    decoded.Tex = std::make_unique<Texture>();
+    decoded.Tex->Name = name;
+    decoded.Tex->FileName = fileName;
+
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file) {
+      throw std::runtime_error("LoadTexture: cannot open " + name);
+    }
+    decoded.File.assign(std::istreambuf_iterator<char>(file),
+                        std::istreambuf_iterator<char>());
+
+    // Creates the texture in COPY_DEST and fills the subresource table;
+    // creating resources is free-threaded, so this stays off the render
+    // thread.
+    ThrowIfFailed(DirectX::LoadDDSTextureFromMemory(
+        device.Get(), decoded.File.data(), decoded.File.size(),
+        decoded.Tex->Resource.GetAddressOf(), decoded.Subresources));
+    return decoded;
+  };
+
+  auto upload = [](DecodedTexture &decoded, UploadContext &context) {
+    auto resource = decoded.Tex->Resource.Get();
+    auto subresourceCount = (UINT)decoded.Subresources.size();
+    auto uploadSize =
+        GetRequiredIntermediateSize(resource, 0, subresourceCount);
+
+    auto heapProps = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+    auto bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(uploadSize);
+    ComPtr<ID3D12Resource> uploadBuffer;
+    ThrowIfFailed(context.Device->CreateCommittedResource(
+        &heapProps, D3D12_HEAP_FLAG_NONE, &bufferDesc,
+        D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+        IID_PPV_ARGS(uploadBuffer.GetAddressOf())));
+
+    UpdateSubresources(context.CommandList, resource, uploadBuffer.Get(), 0, 0,
+                       subresourceCount, decoded.Subresources.data());
+    auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+        resource, D3D12_RESOURCE_STATE_COPY_DEST,
+        D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+    context.CommandList->ResourceBarrier(1, &barrier);
+
+    context.KeepAlive(std::move(uploadBuffer));
+    return std::move(decoded.Tex);
+  };
+
+  return Load<Texture>(decode, upload);
+}
+
+size_t AssetLoader::Pump() {
+  // Publish the batches the GPU is done with.
+  size_t published = 0;
+  auto completed = Fence->GetCompletedValue();
+  while (!InFlight.empty() && InFlight.front().FenceValue <= completed) {
+    auto &batch = InFlight.front();
+    for (auto &job : batch.Jobs) {
+      job.Publish();
+      published++;
+    }
+    FreeAllocators.push_back(std::move(batch.Allocator));
+    InFlight.pop_front();
+  }
+
+  std::vector<Job> jobs;
+  {
+    std::lock_guard lock(Mutex);
+    jobs.swap(DecodedJobs);
+  }
+  if (jobs.empty()) {
+    return published;
+  }
+
+  // Everything decoded since the last call goes out in one submission.
+  Batch batch;
+  if (FreeAllocators.empty()) {
+    ThrowIfFailed(Device->CreateCommandAllocator(
+        D3D12_COMMAND_LIST_TYPE_DIRECT,
+        IID_PPV_ARGS(batch.Allocator.GetAddressOf())));
+  } else {
+    batch.Allocator = std::move(FreeAllocators.back());
+    FreeAllocators.pop_back();
+    ThrowIfFailed(batch.Allocator->Reset());
+  }
+
+  if (CommandList) {
+    ThrowIfFailed(CommandList->Reset(batch.Allocator.Get(), nullptr));
+  } else {
+    ThrowIfFailed(Device->CreateCommandList(
+        0, D3D12_COMMAND_LIST_TYPE_DIRECT, batch.Allocator.Get(), nullptr,
+        IID_PPV_ARGS(CommandList.GetAddressOf())));
+  }
+
+  UploadContext context(Device.Get(), CommandList.Get(), batch.Resources);
+  for (auto &job : jobs) {
+    try {
+      job.Upload(context);
+      batch.Jobs.push_back(std::move(job));
+    } catch (...) {
+      job.Fail(Describe(std::current_exception()));
+    }
+  }
+
+  ThrowIfFailed(CommandList->Close());
+  ID3D12CommandList *commandLists[] = {CommandList.Get()};
+  Queue->ExecuteCommandLists(_countof(commandLists), commandLists);
+
+  batch.FenceValue = ++FenceValue;
+  ThrowIfFailed(Queue->Signal(Fence.Get(), FenceValue));
+  InFlight.push_back(std::move(batch));
+  return published;
+}
+
+void AssetLoader::Finish() {
+  {
+    std::unique_lock lock(Mutex);
+    DecodeDone.wait(lock, [this]() { return Decoding == 0; });
+  }
+  Pump();
+  WaitForFence(FenceValue);
+  Pump();
+}
+
+std::string AssetLoader::Describe(std::exception_ptr error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const std::exception &e) {
+    return e.what();
+  } catch (...) {
+    return "unknown error";
+  }
+}
+
+void AssetLoader::Enqueue(Job job) {
+  std::lock_guard lock(Mutex);
+  DecodedJobs.push_back(std::move(job));
+}
+
+void AssetLoader::DecodeFinished() {
+  std::lock_guard lock(Mutex);
+  if (--Decoding == 0) {
+    DecodeDone.notify_all();
+  }
+}
+
+void AssetLoader::WaitForFence(UINT64 value) {
+  if (Fence->GetCompletedValue() >= value) {
+    return;
+  }
+  HANDLE eventHandle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
+  ThrowIfFailed(Fence->SetEventOnCompletion(value, eventHandle));
+  WaitForSingleObject(eventHandle, INFINITE);
+  CloseHandle(eventHandle);
+}
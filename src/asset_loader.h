@@ -0,0 +1,177 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "dx_utils.h"
+#include "thread_pool.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Loads assets without blocking the render thread.  The CPU side of an asset
+// (file I/O, parsing, decoding, writing upload memory) runs on the thread
+// pool.  Pump, called once per frame, records the GPU copies of everything
+// decoded since the last call into one command list, submits it, and
+// publishes the assets whose copies the GPU has finished.  Renderers keep a
+// Handle per asset and draw a placeholder until it is Ready.
+//
+//   Brick = Assets->LoadTexture("brick", TEXTURE_DIR L"/bricks.dds");
+//   ...
+//   Assets->Pump();
+//   auto srv = Brick.Ready() ? BrickSrv : NullSrv;
+class AssetLoader {
+public:
+  enum class State { Loading, Ready, Failed };
+
+  template <typename T> class Handle {
+  public:
+    State GetState() const {
+      return Slot ? Slot->Status.load(std::memory_order_acquire)
+                  : State::Failed;
+    }
+    bool Ready() const { return GetState() == State::Ready; }
+
+    // The asset once Ready, nullptr before.
+    T *Get() const { return Ready() ? Slot->Asset.get() : nullptr; }
+
+    // Why loading failed, once the state is Failed.  A handle no load was
+    // ever requested for is Failed as "not loaded".
+    const std::string &Error() const {
+      static const std::string notLoaded = "not loaded";
+      return Slot ? Slot->Error : notLoaded;
+    }
+
+  private:
+    friend class AssetLoader;
+
+    struct Shared {
+      std::atomic<State> Status = State::Loading;
+      std::unique_ptr<T> Asset;
+      std::string Error;
+    };
+    std::shared_ptr<Shared> Slot;
+  };
+
+  // What an asset's upload step records into.
+  class UploadContext {
+  public:
+    ID3D12Device *Device;
+    ID3D12GraphicsCommandList *CommandList;
+
+    // Keeps a resource, typically an upload buffer, alive until the GPU has
+    // executed the batch.
+    void KeepAlive(ComPtr<ID3D12Resource> resource) {
+      Resources.push_back(std::move(resource));
+    }
+
+  private:
+    friend class AssetLoader;
+    UploadContext(ID3D12Device *device, ID3D12GraphicsCommandList *commandList,
+                  std::vector<ComPtr<ID3D12Resource>> &resources)
+        : Device(device), CommandList(commandList), Resources(resources) {}
+
+    std::vector<ComPtr<ID3D12Resource>> &Resources;
+  };
+
+  // Uploads are submitted to queue, which must accept copy commands and
+  // resource transitions for pixel shaders, i.e. a direct queue.
+  AssetLoader(ID3D12Device *device, ID3D12CommandQueue *queue,
+              ThreadPool &pool = ThreadPool::Shared());
+  AssetLoader(const AssetLoader &rhs) = delete;
+  AssetLoader &operator=(const AssetLoader &rhs) = delete;
+  // Waits for the loads in flight, so their callbacks never outlive it.
+  ~AssetLoader();
+
+  // decode() runs on a worker and returns whatever the upload needs.
+  // upload(decoded, context) runs inside Pump and returns the finished asset
+  // as a std::unique_ptr<T>.  An exception thrown by either fails the asset.
+  template <typename T, typename Decode, typename Upload>
+  Handle<T> Load(Decode decode, Upload upload);
+
+  // A DDS texture, decoded on a worker and left in PIXEL_SHADER_RESOURCE.
+  Handle<Texture> LoadTexture(const std::string &name,
+                              const std::wstring &fileName);
+
+  // Submits the uploads of the assets decoded since the last call and
+  // publishes those the GPU has finished.  Returns how many became Ready.
+  size_t Pump();
+
+  // Blocks until every asset requested so far is Ready or Failed.
+  void Finish();
+
+private:
+  struct Job {
+    std::function<void(UploadContext &)> Upload;
+    std::function<void()> Publish;
+    std::function<void(const std::string &)> Fail;
+  };
+
+  struct Batch {
+    ComPtr<ID3D12CommandAllocator> Allocator;
+    std::vector<Job> Jobs;
+    std::vector<ComPtr<ID3D12Resource>> Resources;
+    UINT64 FenceValue = 0;
+  };
+
+  static std::string Describe(std::exception_ptr error);
+  void Enqueue(Job job);
+  void DecodeFinished();
+  void WaitForFence(UINT64 value);
+
+  ComPtr<ID3D12Device> Device;
+  ComPtr<ID3D12CommandQueue> Queue;
+  ThreadPool &Pool;
+
+  ComPtr<ID3D12GraphicsCommandList> CommandList;
+  std::vector<ComPtr<ID3D12CommandAllocator>> FreeAllocators;
+  std::deque<Batch> InFlight;
+  ComPtr<ID3D12Fence> Fence;
+  UINT64 FenceValue = 0;
+
+  // Shared with the workers.
+  std::mutex Mutex;
+  std::condition_variable DecodeDone;
+  std::vector<Job> DecodedJobs;
+  size_t Decoding = 0;
+};
+
+template <typename T, typename Decode, typename Upload>
+AssetLoader::Handle<T> AssetLoader::Load(Decode decode, Upload upload) {
+  using Staged = decltype(decode());
+
+  Handle<T> handle;
+  handle.Slot = std::make_shared<typename Handle<T>::Shared>();
+  auto slot = handle.Slot;
+  auto fail = [slot](const std::string &error) {
+    slot->Error = error;
+    slot->Status.store(State::Failed, std::memory_order_release);
+  };
+
+  {
+    std::lock_guard lock(Mutex);
+    Decoding++;
+  }
+  Pool.Submit([this, slot, fail, decode = std::move(decode),
+               upload = std::move(upload)]() {
+    try {
+      auto staged = std::make_shared<Staged>(decode());
+      auto uploadStaged = [slot, staged, upload](UploadContext &context) {
+        slot->Asset = upload(*staged, context);
+      };
+      auto publish = [slot]() {
+        slot->Status.store(State::Ready, std::memory_order_release);
+      };
+      Enqueue({uploadStaged, publish, fail});
+    } catch (...) {
+      fail(Describe(std::current_exception()));
+    }
+    DecodeFinished();
+  });
+  return handle;
+}
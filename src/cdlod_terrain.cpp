@@ -0,0 +1,125 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "cdlod_terrain.h"
+#include <cassert>
+
+using namespace DirectX;
+
+CdlodTerrain::CdlodTerrain(const Settings &settings)
+    : TerrainSettings(settings) {
+  assert(settings.LodCount > 0);
+  assert(settings.PatchResolution % 2 == 0);
+
+  float range = settings.FinestRange;
+  for (uint32 level = 0; level < settings.LodCount; level++) {
+    Ranges.push_back(range);
+    range *= 2.0f;
+  }
+}
+
+GeometryGenerator::MeshData CdlodTerrain::CreatePatch(uint32 resolution) {
+  assert(resolution % 2 == 0);
+
+  GeometryGenerator geoGen;
+  auto patch = geoGen.CreateGrid(1.0f, 1.0f, resolution + 1, resolution + 1);
+
+  // The grid lists its quads row by row, with z decreasing from row to row.
+  // Move them into four runs, one per quadrant, keeping their order.
+  auto half = resolution / 2;
+  std::vector<uint32> indices;
+  indices.reserve(patch.Indices32.size());
+  for (int quadrant = 0; quadrant < 4; quadrant++) {
+    bool highX = quadrant & 1;
+    bool highZ = quadrant & 2;
+    for (uint32 i = 0; i < resolution; i++) {
+      if ((i < half) != highZ) {
+        continue;
+      }
+      for (uint32 j = 0; j < resolution; j++) {
+        if ((j >= half) != highX) {
+          continue;
+        }
+        auto quad = patch.Indices32.begin() + (i * resolution + j) * 6;
+        indices.insert(indices.end(), quad, quad + 6);
+      }
+    }
+  }
+  patch.Indices32 = std::move(indices);
+  return patch;
+}
+
+void CdlodTerrain::PatchRange(const SubmeshGeometry &patch, int quadrant,
+                              UINT &startIndexLocation, UINT &indexCount) {
+  if (quadrant < 0) {
+    startIndexLocation = patch.StartIndexLocation;
+    indexCount = patch.IndexCount;
+    return;
+  }
+  indexCount = patch.IndexCount / 4;
+  startIndexLocation = patch.StartIndexLocation + quadrant * indexCount;
+}
+
+void CdlodTerrain::Select(const XMFLOAT3 &eye, const XMFLOAT4 planes[6],
+                          std::vector<Chunk> &chunks) const {
+  chunks.clear();
+  float size = TerrainSettings.Size;
+  SelectNode({-0.5f * size, -0.5f * size}, size, TerrainSettings.LodCount - 1,
+             true, eye, planes, chunks);
+}
+
+XMFLOAT2 CdlodTerrain::MorphRange(uint32 level) const {
+  float previous = level > 0 ? Ranges[level - 1] : 0.0f;
+  float end = Ranges[level];
+  return {previous + (end - previous) * TerrainSettings.MorphRatio, end};
+}
+
+bool CdlodTerrain::SelectNode(const XMFLOAT2 &min, float size, uint32 level,
+                              bool root, const XMFLOAT3 &eye,
+                              const XMFLOAT4 planes[6],
+                              std::vector<Chunk> &chunks) const {
+  // The root always covers the whole terrain, however far away it is.
+  auto box = NodeBox(min, size);
+  if (!root && !InRange(box, eye, Ranges[level])) {
+    return false;
+  }
+  if (!MeshBounds::Intersects(box, planes)) {
+    return true;
+  }
+
+  if (level == 0 || !InRange(box, eye, Ranges[level - 1])) {
+    chunks.push_back({min, size, level, -1});
+    return true;
+  }
+
+  // Children beyond their own range are drawn as a quadrant of this node.
+  float half = 0.5f * size;
+  for (int quadrant = 0; quadrant < 4; quadrant++) {
+    XMFLOAT2 childMin = {min.x + (quadrant & 1 ? half : 0.0f),
+                         min.y + (quadrant & 2 ? half : 0.0f)};
+    if (!SelectNode(childMin, half, level - 1, false, eye, planes, chunks) &&
+        MeshBounds::Intersects(NodeBox(childMin, half), planes)) {
+      chunks.push_back({min, size, level, quadrant});
+    }
+  }
+  return true;
+}
+
+BoundingBox CdlodTerrain::NodeBox(const XMFLOAT2 &min, float size) const {
+  XMFLOAT3 low = {min.x, TerrainSettings.MinHeight, min.y};
+  XMFLOAT3 high = {min.x + size, TerrainSettings.MaxHeight, min.y + size};
+  BoundingBox box;
+  BoundingBox::CreateFromPoints(box, XMLoadFloat3(&low), XMLoadFloat3(&high));
+  return box;
+}
+
+bool CdlodTerrain::InRange(const BoundingBox &box, const XMFLOAT3 &eye,
+                           float range) {
+  // Distance from the eye to the nearest point of the box.
+  XMVECTOR center = XMLoadFloat3(&box.Center);
+  XMVECTOR extents = XMLoadFloat3(&box.Extents);
+  XMVECTOR offset = XMVectorAbs(XMLoadFloat3(&eye) - center) - extents;
+  XMVECTOR outside = XMVectorMax(offset, XMVectorZero());
+  return XMVectorGetX(XMVector3LengthSq(outside)) <= range * range;
+}
@@ -0,0 +1,95 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "dx_utils.h"
+#include "geometry_generator.h"
+
+// Chunked continuous LOD terrain (CDLOD).  A quadtree over a square area picks
+// the nodes to draw from the camera distance every frame.  Every node draws
+// the same grid patch scaled to its size, so the triangle count follows what
+// is on screen instead of the size of the terrain.  Over the last part of a
+// level's range its vertices morph onto the next coarser grid, so switching
+// levels does not pop.
+//
+//   auto patch = CdlodTerrain::CreatePatch(settings.PatchResolution);
+//   ...
+//   terrain.Select(eye, frustumPlanes, chunks);
+//   for (auto &chunk : chunks) {
+//     CdlodTerrain::PatchRange(patchSubmesh, chunk.Quadrant, start, count);
+//     ...
+//   }
+class CdlodTerrain {
+public:
+  using uint32 = GeometryGenerator::uint32;
+
+  struct Settings {
+    // Side of the square in the xz plane, centered at the origin.
+    float Size = 256.0f;
+    // Depth of the quadtree.  Level 0 is the finest.
+    uint32 LodCount = 6;
+    // Quads along each side of the patch.  Must be even.
+    uint32 PatchResolution = 32;
+    // View distance of level 0, doubled for each coarser level.  It should
+    // be at least twice the side of a level 0 node, or neighbouring chunks
+    // can end up more than one level apart and crack.
+    float FinestRange = 16.0f;
+    // Fraction of a level's range after which its vertices start morphing.
+    float MorphRatio = 0.7f;
+    // Height range of the surface, for the chunk bounds.
+    float MinHeight = 0.0f;
+    float MaxHeight = 0.0f;
+  };
+
+  // A node, or one quadrant of it, selected for drawing.
+  struct Chunk {
+    DirectX::XMFLOAT2 Min; // Corner with the smallest x and z.
+    float Size;
+    uint32 Level;
+    // -1 for the whole node, otherwise bit 0 selects the +x half and bit 1
+    // the +z half.
+    int Quadrant;
+  };
+
+  explicit CdlodTerrain(const Settings &settings);
+
+  // The shared patch: a 1x1 grid in the xz plane centered at the origin,
+  // with resolution quads per side.  Its triangles are grouped by quadrant so
+  // a quarter of it can be drawn on its own.
+  static GeometryGenerator::MeshData CreatePatch(uint32 resolution);
+
+  // Index range of the patch a chunk draws.
+  static void PatchRange(const SubmeshGeometry &patch, int quadrant,
+                         UINT &startIndexLocation, UINT &indexCount);
+
+  // Fills chunks with the nodes to draw, leaving out those outside the
+  // inward facing planes from ClusterCuller::ExtractFrustumPlanes.
+  void Select(const DirectX::XMFLOAT3 &eye, const DirectX::XMFLOAT4 planes[6],
+              std::vector<Chunk> &chunks) const;
+
+  // Distances over which the vertices of a level morph to the next one.
+  DirectX::XMFLOAT2 MorphRange(uint32 level) const;
+
+  // World size of one patch quad in a chunk.
+  float CellSize(const Chunk &chunk) const {
+    return chunk.Size / TerrainSettings.PatchResolution;
+  }
+
+  const Settings &GetSettings() const { return TerrainSettings; }
+
+private:
+  // Returns false when the node is beyond the range of its level, so the
+  // parent has to cover its area.
+  bool SelectNode(const DirectX::XMFLOAT2 &min, float size, uint32 level,
+                  bool root, const DirectX::XMFLOAT3 &eye,
+                  const DirectX::XMFLOAT4 planes[6],
+                  std::vector<Chunk> &chunks) const;
+  DirectX::BoundingBox NodeBox(const DirectX::XMFLOAT2 &min, float size) const;
+  static bool InRange(const DirectX::BoundingBox &box,
+                      const DirectX::XMFLOAT3 &eye, float range);
+
+  Settings TerrainSettings;
+  std::vector<float> Ranges;
+};
@@ -0,0 +1,383 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "cloth_colliders.h"
+#include "mesh_bounds.h"
+#include "simd.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+// Particles closer than this to a sphere or capsule axis are left where they
+// are rather than pushed out along an arbitrary direction.
+constexpr float MinDistance = 1e-6f;
+
+// The kernels are written once, over either a float or a Simd::Float, so the
+// scalar path is the SIMD arithmetic one lane at a time.  Masks are bools
+// for float.
+float Sqrt(float a) { return std::sqrt(a); }
+float Min(float a, float b) { return a < b ? a : b; }
+float Max(float a, float b) { return a > b ? a : b; }
+bool Less(float a, float b) { return a < b; }
+bool Greater(float a, float b) { return a > b; }
+bool And(bool a, bool b) { return a && b; }
+float Select(float a, float b, bool mask) { return mask ? b : a; }
+
+template <typename F> F Splat(float a);
+template <> float Splat<float>(float a) { return a; }
+template <> Simd::Float Splat<Simd::Float>(float a) { return Simd::Set(a); }
+
+template <typename F> F LoadLanes(const float *p);
+template <> float LoadLanes<float>(const float *p) { return *p; }
+template <> Simd::Float LoadLanes<Simd::Float>(const float *p) {
+  return Simd::Load(p);
+}
+
+void StoreLanes(float *p, float a) { *p = a; }
+void StoreLanes(float *p, Simd::Float a) { Simd::Store(p, a); }
+
+template <typename F> F Abs(F a) { return Max(a, Splat<F>(0.0f) - a); }
+
+template <typename F> F Dot(const F a[3], F x, F y, F z) {
+  return a[0] * x + a[1] * y + a[2] * z;
+}
+
+float Length(FXMVECTOR v) { return XMVectorGetX(XMVector3Length(v)); }
+
+bool Overlaps(const XMFLOAT3 &minA, const XMFLOAT3 &maxA,
+              const XMFLOAT3 &minB, const XMFLOAT3 &maxB) {
+  return minA.x <= maxB.x && minB.x <= maxA.x && minA.y <= maxB.y &&
+         minB.y <= maxA.y && minA.z <= maxB.z && minB.z <= maxA.z;
+}
+} // namespace
+
+void ClothColliders::Bounds::Add(FXMVECTOR min, FXMVECTOR max) {
+  Min.emplace_back();
+  Max.emplace_back();
+  XMStoreFloat3(&Min.back(), min);
+  XMStoreFloat3(&Max.back(), max);
+}
+
+void ClothColliders::AddSphere(FXMMATRIX world, float radius) {
+  float scale = std::max({Length(world.r[0]), Length(world.r[1]),
+                          Length(world.r[2])});
+  radius *= scale;
+  XMVECTOR center = world.r[3];
+  XMFLOAT3 c;
+  XMStoreFloat3(&c, center);
+  SphereData.X.push_back(c.x);
+  SphereData.Y.push_back(c.y);
+  SphereData.Z.push_back(c.z);
+  SphereData.Radius.push_back(radius);
+  XMVECTOR extent = XMVectorReplicate(radius);
+  SphereData.Box.Add(center - extent, center + extent);
+}
+
+void ClothColliders::AddCylinder(FXMMATRIX world, float bottomRadius,
+                                 float topRadius, float height) {
+  // The caps are half spheres, so the segment stops a radius short of each
+  // end.  A cylinder shorter than its caps collapses to a sphere.
+  float bottom = -0.5f * height + bottomRadius;
+  float top = 0.5f * height - topRadius;
+  if (bottom > top) {
+    bottom = top = 0.5f * (bottom + top);
+  }
+  float scale = std::max(Length(world.r[0]), Length(world.r[2]));
+  float radiusA = bottomRadius * scale, radiusB = topRadius * scale;
+
+  XMVECTOR a = XMVector3TransformCoord(XMVectorSet(0.0f, bottom, 0.0f, 1.0f),
+                                       world);
+  XMVECTOR b =
+      XMVector3TransformCoord(XMVectorSet(0.0f, top, 0.0f, 1.0f), world);
+  XMVECTOR d = b - a;
+  float length2 = XMVectorGetX(XMVector3LengthSq(d));
+  XMFLOAT3 pa, pd;
+  XMStoreFloat3(&pa, a);
+  XMStoreFloat3(&pd, d);
+  CapsuleData.AX.push_back(pa.x);
+  CapsuleData.AY.push_back(pa.y);
+  CapsuleData.AZ.push_back(pa.z);
+  CapsuleData.DX.push_back(pd.x);
+  CapsuleData.DY.push_back(pd.y);
+  CapsuleData.DZ.push_back(pd.z);
+  CapsuleData.InverseLength2.push_back(length2 > 0.0f ? 1.0f / length2
+                                                      : 0.0f);
+  CapsuleData.RadiusA.push_back(radiusA);
+  CapsuleData.RadiusB.push_back(radiusB);
+
+  XMVECTOR extent = XMVectorReplicate(std::max(radiusA, radiusB));
+  CapsuleData.Box.Add(XMVectorMin(a, b) - extent, XMVectorMax(a, b) + extent);
+}
+
+void ClothColliders::AddBox(FXMMATRIX world, float width, float height,
+                            float depth) {
+  float half[3] = {0.5f * width, 0.5f * height, 0.5f * depth};
+  XMFLOAT3 axes[3];
+  XMVECTOR extent = XMVectorZero();
+  for (int k = 0; k < 3; k++) {
+    float scale = Length(world.r[k]);
+    XMVECTOR axis = world.r[k] / scale;
+    XMStoreFloat3(&axes[k], axis);
+    half[k] *= scale;
+    extent += XMVectorAbs(axis) * half[k];
+  }
+  XMFLOAT3 c;
+  XMStoreFloat3(&c, world.r[3]);
+  BoxData.X.push_back(c.x);
+  BoxData.Y.push_back(c.y);
+  BoxData.Z.push_back(c.z);
+  BoxData.UX.push_back(axes[0].x);
+  BoxData.UY.push_back(axes[0].y);
+  BoxData.UZ.push_back(axes[0].z);
+  BoxData.VX.push_back(axes[1].x);
+  BoxData.VY.push_back(axes[1].y);
+  BoxData.VZ.push_back(axes[1].z);
+  BoxData.WX.push_back(axes[2].x);
+  BoxData.WY.push_back(axes[2].y);
+  BoxData.WZ.push_back(axes[2].z);
+  BoxData.HalfU.push_back(half[0]);
+  BoxData.HalfV.push_back(half[1]);
+  BoxData.HalfW.push_back(half[2]);
+  BoxData.Box.Add(world.r[3] - extent, world.r[3] + extent);
+}
+
+void ClothColliders::AddGrid(FXMMATRIX world, float width, float depth) {
+  // The grid lies in the local xz-plane, facing +y; z cross x keeps the
+  // normal defined when y is scaled to nothing.
+  float scaleU = Length(world.r[0]), scaleV = Length(world.r[2]);
+  XMVECTOR u = world.r[0] / scaleU, v = world.r[2] / scaleV;
+  XMVECTOR n = XMVector3Normalize(XMVector3Cross(world.r[2], world.r[0]));
+  float halfU = 0.5f * width * scaleU, halfV = 0.5f * depth * scaleV;
+  XMFLOAT3 c, pu, pv, pn;
+  XMStoreFloat3(&c, world.r[3]);
+  XMStoreFloat3(&pu, u);
+  XMStoreFloat3(&pv, v);
+  XMStoreFloat3(&pn, n);
+  GridData.X.push_back(c.x);
+  GridData.Y.push_back(c.y);
+  GridData.Z.push_back(c.z);
+  GridData.UX.push_back(pu.x);
+  GridData.UY.push_back(pu.y);
+  GridData.UZ.push_back(pu.z);
+  GridData.VX.push_back(pv.x);
+  GridData.VY.push_back(pv.y);
+  GridData.VZ.push_back(pv.z);
+  GridData.NX.push_back(pn.x);
+  GridData.NY.push_back(pn.y);
+  GridData.NZ.push_back(pn.z);
+  GridData.HalfU.push_back(halfU);
+  GridData.HalfV.push_back(halfV);
+  XMVECTOR extent = XMVectorAbs(u) * halfU + XMVectorAbs(v) * halfV;
+  GridData.Box.Add(world.r[3] - extent, world.r[3] + extent);
+}
+
+void ClothColliders::AddField(FXMMATRIX world, const DistanceField &field) {
+  float scale = Length(world.r[0]);
+  XMMATRIX toWorld = world;
+  toWorld.r[3] = XMVectorSet(0.0f, 0.0f, 0.0f, 1.0f);
+  FieldData.Field.push_back(&field);
+  FieldData.ToField.emplace_back();
+  XMStoreFloat4x4(&FieldData.ToField.back(),
+                  XMMatrixInverse(nullptr, world));
+  FieldData.ToWorld.emplace_back();
+  XMStoreFloat3x3(&FieldData.ToWorld.back(), toWorld / scale);
+  FieldData.Scale.push_back(scale);
+
+  auto box = MeshBounds::TransformBox(field.Bounds(), world);
+  XMVECTOR center = XMLoadFloat3(&box.Center);
+  XMVECTOR extents = XMLoadFloat3(&box.Extents);
+  FieldData.Box.Add(center - extents, center + extents);
+}
+
+void ClothColliders::Clear() { *this = ClothColliders(); }
+
+size_t ClothColliders::Count() const {
+  return SphereData.X.size() + CapsuleData.AX.size() + BoxData.X.size() +
+         GridData.X.size() + FieldData.Field.size();
+}
+
+void ClothColliders::Cull(const BoundingBox &bounds, float margin,
+                          Selection &selection) const {
+  XMVECTOR center = XMLoadFloat3(&bounds.Center);
+  XMVECTOR extents = XMLoadFloat3(&bounds.Extents) + XMVectorReplicate(margin);
+  XMFLOAT3 min, max;
+  XMStoreFloat3(&min, center - extents);
+  XMStoreFloat3(&max, center + extents);
+
+  auto select = [&](const Bounds &box, std::vector<uint32> &selected) {
+    selected.clear();
+    for (size_t i = 0; i < box.Min.size(); i++) {
+      if (Overlaps(min, max, box.Min[i], box.Max[i])) {
+        selected.push_back((uint32)i);
+      }
+    }
+  };
+  select(SphereData.Box, selection.Spheres);
+  select(CapsuleData.Box, selection.Capsules);
+  select(BoxData.Box, selection.Boxes);
+  select(GridData.Box, selection.Grids);
+  select(FieldData.Box, selection.Fields);
+}
+
+void ClothColliders::Resolve(const Selection &selection, float margin,
+                             float *x, float *y, float *z,
+                             const float *inverseMass, size_t begin,
+                             size_t end, bool simd) const {
+  if (simd) {
+    ResolveRange<Simd::Float>(selection, margin, x, y, z, inverseMass, begin,
+                              end, Simd::Width);
+  } else {
+    ResolveRange<float>(selection, margin, x, y, z, inverseMass, begin, end,
+                        1);
+  }
+}
+
+template <typename F>
+void ClothColliders::ResolveRange(const Selection &selection, float margin,
+                                  float *x, float *y, float *z,
+                                  const float *inverseMass, size_t begin,
+                                  size_t end, size_t width) const {
+  auto zero = Splat<F>(0.0f);
+  auto minDistance2 = Splat<F>(MinDistance * MinDistance);
+
+  for (size_t p = begin; p < end; p += width) {
+    // A block stays in registers while every selected collider moves it.
+    F px = LoadLanes<F>(&x[p]), py = LoadLanes<F>(&y[p]);
+    F pz = LoadLanes<F>(&z[p]);
+    auto movable = Greater(LoadLanes<F>(&inverseMass[p]), zero);
+
+    // Out to the surface along the line from the center.
+    auto pushFrom = [&](F cx, F cy, F cz, F radius) {
+      F dx = px - cx, dy = py - cy, dz = pz - cz;
+      F distance2 = dx * dx + dy * dy + dz * dz;
+      auto inside = And(And(Less(distance2, radius * radius),
+                            Greater(distance2, minDistance2)),
+                        movable);
+      F scale = radius / Sqrt(distance2);
+      px = Select(px, cx + dx * scale, inside);
+      py = Select(py, cy + dy * scale, inside);
+      pz = Select(pz, cz + dz * scale, inside);
+    };
+
+    for (auto i : selection.Spheres) {
+      auto &s = SphereData;
+      pushFrom(Splat<F>(s.X[i]), Splat<F>(s.Y[i]), Splat<F>(s.Z[i]),
+               Splat<F>(s.Radius[i] + margin));
+    }
+
+    for (auto i : selection.Capsules) {
+      // The nearest point of the segment acts as a sphere center, with the
+      // radius at that point.
+      auto &c = CapsuleData;
+      F ax = Splat<F>(c.AX[i]), ay = Splat<F>(c.AY[i]);
+      F az = Splat<F>(c.AZ[i]);
+      F d[3] = {Splat<F>(c.DX[i]), Splat<F>(c.DY[i]), Splat<F>(c.DZ[i])};
+      F t = Dot(d, px - ax, py - ay, pz - az) * Splat<F>(c.InverseLength2[i]);
+      t = Min(Max(t, zero), Splat<F>(1.0f));
+      F radius = Splat<F>(c.RadiusA[i] + margin) +
+                 Splat<F>(c.RadiusB[i] - c.RadiusA[i]) * t;
+      pushFrom(ax + d[0] * t, ay + d[1] * t, az + d[2] * t, radius);
+    }
+
+    for (auto i : selection.Boxes) {
+      // Out through the face nearest the particle, in box coordinates.
+      auto &b = BoxData;
+      F axes[3][3] = {
+          {Splat<F>(b.UX[i]), Splat<F>(b.UY[i]), Splat<F>(b.UZ[i])},
+          {Splat<F>(b.VX[i]), Splat<F>(b.VY[i]), Splat<F>(b.VZ[i])},
+          {Splat<F>(b.WX[i]), Splat<F>(b.WY[i]), Splat<F>(b.WZ[i])}};
+      float halves[3] = {b.HalfU[i] + margin, b.HalfV[i] + margin,
+                         b.HalfW[i] + margin};
+      F ox = px - Splat<F>(b.X[i]), oy = py - Splat<F>(b.Y[i]);
+      F oz = pz - Splat<F>(b.Z[i]);
+
+      F depth[3], move[3];
+      auto inside = movable;
+      for (int k = 0; k < 3; k++) {
+        F q = Dot(axes[k], ox, oy, oz);
+        F half = Splat<F>(halves[k]);
+        depth[k] = half - Abs(q);
+        move[k] = Select(half, zero - half, Less(q, zero)) - q;
+        inside = And(inside, Greater(depth[k], zero));
+      }
+      // Ties go to the earlier axis.
+      auto onV = Less(depth[1], depth[0]);
+      F least = Select(depth[0], depth[1], onV);
+      auto onW = Less(depth[2], least);
+      F mu = Select(Select(move[0], zero, onV), zero, onW);
+      F mv = Select(Select(zero, move[1], onV), zero, onW);
+      F mw = Select(zero, move[2], onW);
+
+      px = Select(px, px + axes[0][0] * mu + axes[1][0] * mv + axes[2][0] * mw,
+                  inside);
+      py = Select(py, py + axes[0][1] * mu + axes[1][1] * mv + axes[2][1] * mw,
+                  inside);
+      pz = Select(pz, pz + axes[0][2] * mu + axes[1][2] * mv + axes[2][2] * mw,
+                  inside);
+    }
+
+    for (auto i : selection.Grids) {
+      // Up along the normal, over the grid's rectangle only.
+      auto &g = GridData;
+      F u[3] = {Splat<F>(g.UX[i]), Splat<F>(g.UY[i]), Splat<F>(g.UZ[i])};
+      F v[3] = {Splat<F>(g.VX[i]), Splat<F>(g.VY[i]), Splat<F>(g.VZ[i])};
+      F n[3] = {Splat<F>(g.NX[i]), Splat<F>(g.NY[i]), Splat<F>(g.NZ[i])};
+      F ox = px - Splat<F>(g.X[i]), oy = py - Splat<F>(g.Y[i]);
+      F oz = pz - Splat<F>(g.Z[i]);
+      F height = Dot(n, ox, oy, oz);
+      F lift = Splat<F>(margin) - height;
+      auto inside =
+          And(And(Less(Abs(Dot(u, ox, oy, oz)), Splat<F>(g.HalfU[i])),
+                  Less(Abs(Dot(v, ox, oy, oz)), Splat<F>(g.HalfV[i]))),
+              And(Greater(lift, zero), movable));
+      px = Select(px, px + n[0] * lift, inside);
+      py = Select(py, py + n[1] * lift, inside);
+      pz = Select(pz, pz + n[2] * lift, inside);
+    }
+
+    if (!selection.Fields.empty()) {
+      // Out along the field's gradient, lane by lane.
+      float lx[Simd::Width], ly[Simd::Width], lz[Simd::Width];
+      float lm[Simd::Width];
+      StoreLanes(lx, px);
+      StoreLanes(ly, py);
+      StoreLanes(lz, pz);
+      StoreLanes(lm, LoadLanes<F>(&inverseMass[p]));
+      for (auto i : selection.Fields) {
+        auto &f = FieldData;
+        XMMATRIX toField = XMLoadFloat4x4(&f.ToField[i]);
+        XMMATRIX toWorld = XMLoadFloat3x3(&f.ToWorld[i]);
+        for (size_t lane = 0; lane < width; lane++) {
+          if (lm[lane] <= 0.0f) {
+            continue;
+          }
+          XMVECTOR local = XMVector3TransformCoord(
+              XMVectorSet(lx[lane], ly[lane], lz[lane], 1.0f), toField);
+          XMFLOAT3 q, gradient;
+          XMStoreFloat3(&q, local);
+          float depth = margin - f.Field[i]->Sample(q.x, q.y, q.z, gradient) *
+                                     f.Scale[i];
+          if (depth <= 0.0f) {
+            continue;
+          }
+          XMFLOAT3 n;
+          XMStoreFloat3(&n, XMVector3TransformNormal(XMLoadFloat3(&gradient),
+                                                     toWorld));
+          lx[lane] += n.x * depth;
+          ly[lane] += n.y * depth;
+          lz[lane] += n.z * depth;
+        }
+      }
+      px = LoadLanes<F>(lx);
+      py = LoadLanes<F>(ly);
+      pz = LoadLanes<F>(lz);
+    }
+
+    StoreLanes(&x[p], px);
+    StoreLanes(&y[p], py);
+    StoreLanes(&z[p], pz);
+  }
+}
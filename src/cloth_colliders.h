@@ -0,0 +1,133 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "distance_field.h"
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// Analytic obstacles for cloth: the sphere, cylinder, box and grid meshes of
+// GeometryGenerator, given the same dimensions and world matrix as the
+// render item drawn with them.  Each shape is stored SoA, one float array
+// per field, and Resolve tests Simd::Width particles against one collider
+// at a time.
+//
+// Any other mesh is baked into a DistanceField and added with AddField.
+// A field costs one trilinear lookup per particle, however detailed the
+// mesh; its lookups gather from scattered nodes, so they run one lane at a
+// time even in the SIMD path.
+//
+// A cloth first picks the colliders whose bounds meet its own with Cull,
+// so a scene can hold many obstacles while each cloth only pays for the few
+// it can touch.
+//
+//   colliders.AddGrid(floorWorld, 20.0f, 30.0f);
+//   colliders.AddCylinder(columnWorld, 0.5f, 0.3f, 3.0f);
+//   cloth.SetColliders(&colliders);
+class ClothColliders {
+public:
+  using uint32 = std::uint32_t;
+
+  // Indices of the colliders of each shape a cloth may touch.
+  struct Selection {
+    std::vector<uint32> Spheres, Capsules, Boxes, Grids, Fields;
+
+    bool Empty() const {
+      return Spheres.empty() && Capsules.empty() && Boxes.empty() &&
+             Grids.empty() && Fields.empty();
+    }
+    size_t Count() const {
+      return Spheres.size() + Capsules.size() + Boxes.size() + Grids.size() +
+             Fields.size();
+    }
+  };
+
+  // CreateSphere(radius, ...).  A scaled sphere takes the largest axis
+  // scale.
+  void AddSphere(DirectX::FXMMATRIX world, float radius);
+  // CreateCylinder(bottomRadius, topRadius, height, ...), as a capsule whose
+  // caps end where the cylinder does and whose radius goes from
+  // bottomRadius to topRadius.
+  void AddCylinder(DirectX::FXMMATRIX world, float bottomRadius,
+                   float topRadius, float height);
+  // CreateBox(width, height, depth, ...).  Scale may differ per axis.
+  void AddBox(DirectX::FXMMATRIX world, float width, float height,
+              float depth);
+  // CreateGrid(width, depth, ...), as a floor: particles over the grid and
+  // below its surface are lifted onto it, from above only.
+  void AddGrid(DirectX::FXMMATRIX world, float width, float depth);
+  // A field baked from any mesh, placed by the world matrix of that mesh's
+  // render item.  Scale must be uniform.  The field is not copied, so it
+  // must outlive the set.
+  void AddField(DirectX::FXMMATRIX world, const DistanceField &field);
+
+  void Clear();
+  size_t Count() const;
+
+  // The colliders whose bounds are within margin of bounds.
+  void Cull(const DirectX::BoundingBox &bounds, float margin,
+            Selection &selection) const;
+
+  // Moves particles [begin, end) with a positive inverse mass to margin
+  // outside the selected colliders, in the order of the selection.  The
+  // arrays are padded so whole vectors may be read from begin; with simd
+  // false, one particle at a time is moved with the same arithmetic.
+  void Resolve(const Selection &selection, float margin, float *x, float *y,
+               float *z, const float *inverseMass, size_t begin, size_t end,
+               bool simd) const;
+
+private:
+  // Resolve over F = Simd::Float, width lanes at a time, or F = float.
+  template <typename F>
+  void ResolveRange(const Selection &selection, float margin, float *x,
+                    float *y, float *z, const float *inverseMass,
+                    size_t begin, size_t end, size_t width) const;
+
+  struct Bounds {
+    std::vector<DirectX::XMFLOAT3> Min, Max;
+    void Add(DirectX::FXMVECTOR min, DirectX::FXMVECTOR max);
+  };
+
+  struct Spheres {
+    std::vector<float> X, Y, Z, Radius;
+    Bounds Box;
+  } SphereData;
+
+  // Segment from A to B, with the A to B offset over its squared length
+  // kept to project onto it.
+  struct Capsules {
+    std::vector<float> AX, AY, AZ, DX, DY, DZ, InverseLength2;
+    std::vector<float> RadiusA, RadiusB;
+    Bounds Box;
+  } CapsuleData;
+
+  // Unit axes U, V and W of the box, and its half extents along them.
+  struct Boxes {
+    std::vector<float> X, Y, Z;
+    std::vector<float> UX, UY, UZ, VX, VY, VZ, WX, WY, WZ;
+    std::vector<float> HalfU, HalfV, HalfW;
+    Bounds Box;
+  } BoxData;
+
+  // Unit axes U and V span the grid and N is its up direction.
+  struct Grids {
+    std::vector<float> X, Y, Z;
+    std::vector<float> UX, UY, UZ, VX, VY, VZ, NX, NY, NZ;
+    std::vector<float> HalfU, HalfV;
+    Bounds Box;
+  } GridData;
+
+  // World to field space, and back for the gradient, which is a direction
+  // and so only rotates and scales.
+  struct Fields {
+    std::vector<const DistanceField *> Field;
+    std::vector<DirectX::XMFLOAT4X4> ToField;
+    std::vector<DirectX::XMFLOAT3X3> ToWorld;
+    std::vector<float> Scale;
+    Bounds Box;
+  } FieldData;
+};
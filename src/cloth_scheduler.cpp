@@ -0,0 +1,58 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "cloth_scheduler.h"
+#include <algorithm>
+#include <chrono>
+
+using namespace DirectX;
+
+int ClothScheduler::Advance(float deltaTime, CpuCloth &cloth,
+                            ThreadPool *pool) {
+  Accumulator += std::max(deltaTime, 0.0f);
+  auto steps = (int)(Accumulator / Config.StepTime);
+  if (steps > Config.MaxStepsPerFrame) {
+    auto dropped = (double)(steps - Config.MaxStepsPerFrame) * Config.StepTime;
+    Stats.DroppedSeconds += dropped;
+    Accumulator -= dropped;
+    steps = Config.MaxStepsPerFrame;
+  }
+  Stats.Steps = steps;
+  if (steps == 0) {
+    return 0;
+  }
+
+  // Only the state before the last step is ever blended with, so earlier
+  // steps need no snapshot.
+  Previous.resize(cloth.ParticleCount());
+  auto start = std::chrono::steady_clock::now();
+  for (int s = 0; s < steps; s++) {
+    if (s == steps - 1) {
+      cloth.Output({Previous.data(), sizeof(XMFLOAT3)});
+    }
+    cloth.Execute(Config.StepTime, pool);
+  }
+  auto end = std::chrono::steady_clock::now();
+
+  Accumulator -= (double)steps * Config.StepTime;
+  Stats.StepMilliseconds =
+      std::chrono::duration<double, std::milli>(end - start).count() / steps;
+  Stats.TotalSteps += steps;
+  return steps;
+}
+
+void ClothScheduler::Interpolate(
+    const CpuCloth &cloth, MeshNormals::Stream<XMFLOAT3> positions) const {
+  if (Previous.size() != cloth.ParticleCount()) {
+    cloth.Output(positions);
+    return;
+  }
+  float alpha = Alpha();
+  for (size_t p = 0; p < Previous.size(); p++) {
+    auto current = cloth.Position(p);
+    XMStoreFloat3(&positions[p],
+                  XMVectorLerp(XMLoadFloat3(&Previous[p]),
+                               XMLoadFloat3(&current), alpha));
+  }
+}
@@ -0,0 +1,71 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "cpu_cloth.h"
+#include "mesh_normals.h"
+#include "thread_pool.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// Steps a CpuCloth at a fixed rate whatever the frame rate.  Frame time
+// accumulates and is spent in whole steps of StepTime, so a step always
+// costs the same and the cloth behaves the same at 30 Hz and at 144 Hz.
+// At most MaxStepsPerFrame run per frame: after a hitch the time beyond
+// that is dropped, slowing the cloth down for a frame rather than making the
+// next frame even slower.
+//
+// The time left over, less than a step, is how far the frame lies between
+// the cloth's last two states, and Interpolate blends them by it so the
+// motion stays smooth when frames and steps do not line up.
+//
+//   scheduler.Advance(timer.DeltaTime(), cloth, &pool);
+//   scheduler.Interpolate(cloth, {&vertices[0].Pos, sizeof(Vertex)});
+class ClothScheduler {
+public:
+  struct Settings {
+    float StepTime = 1.0f / 60.0f;
+    int MaxStepsPerFrame = 4;
+  };
+
+  struct Metrics {
+    // Steps the last Advance ran.
+    int Steps = 0;
+    // Mean wall time of the steps of the last Advance that ran any.
+    double StepMilliseconds = 0.0;
+    std::uint64_t TotalSteps = 0;
+    // Simulation time the step cap has thrown away.
+    double DroppedSeconds = 0.0;
+  };
+
+  ClothScheduler() = default;
+  explicit ClothScheduler(const Settings &settings) : Config(settings) {}
+
+  // Adds deltaTime and runs the whole steps it makes up, serially when pool
+  // is null.  A scheduler drives one cloth.  Returns the steps run.
+  int Advance(float deltaTime, CpuCloth &cloth, ThreadPool *pool = nullptr);
+
+  // How far the frame lies from the previous state to the current one, in
+  // [0, 1).
+  float Alpha() const { return (float)(Accumulator / Config.StepTime); }
+
+  // The cloth's positions at Alpha between its last two states.  Until a
+  // step has run, its current positions.
+  void Interpolate(const CpuCloth &cloth,
+                   MeshNormals::Stream<DirectX::XMFLOAT3> positions) const;
+
+  const Settings &Parameters() const { return Config; }
+  const Metrics &LastFrame() const { return Stats; }
+
+private:
+  Settings Config;
+  Metrics Stats;
+  // Seconds not yet stepped, kept in double so a long run does not lose the
+  // fraction of a step.
+  double Accumulator = 0.0;
+  // Positions before the most recent step.
+  std::vector<DirectX::XMFLOAT3> Previous;
+};
@@ -0,0 +1,77 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "cloth_state_buffers.h"
+
+void ClothStateBuffers::RecordReset(ClothCommands &commands) {
+  ClothBufferState wanted[Count] = {States[0], States[1]};
+  wanted[CurrentIndex] = ClothBufferState::CopyDest;
+  RecordTransitions(commands, wanted);
+  commands.CopyInitialState(CurrentIndex);
+}
+
+void ClothStateBuffers::RecordStep(ClothCommands &commands,
+                                   uint32 vertexCount) {
+  int source = CurrentIndex, destination = 1 - CurrentIndex;
+  ClothBufferState wanted[Count];
+  wanted[source] = ClothBufferState::ShaderResource;
+  wanted[destination] = ClothBufferState::UnorderedAccess;
+  RecordTransitions(commands, wanted);
+
+  auto groups = (vertexCount + ThreadGroupSize - 1) / ThreadGroupSize;
+  commands.Dispatch(source, destination, groups);
+  CurrentIndex = destination;
+}
+
+void ClothStateBuffers::RecordPrepareForDraw(ClothCommands &commands) {
+  ClothBufferState wanted[Count] = {States[0], States[1]};
+  wanted[CurrentIndex] = ClothBufferState::VertexBuffer;
+  RecordTransitions(commands, wanted);
+}
+
+void ClothStateBuffers::RecordTransitions(
+    ClothCommands &commands, std::span<const ClothBufferState> wanted) {
+  ClothCommands::Transition transitions[Count];
+  size_t count = 0;
+  for (int b = 0; b < Count; b++) {
+    if (States[b] != wanted[b]) {
+      transitions[count++] = {b, States[b], wanted[b]};
+      States[b] = wanted[b];
+    }
+  }
+  if (count > 0) {
+    commands.ResourceBarrier({transitions, count});
+  }
+}
+
+void RecordingClothCommands::ResourceBarrier(
+    std::span<const Transition> transitions) {
+  for (auto &transition : transitions) {
+    Consistent &= States[transition.Buffer] == transition.Before &&
+                  transition.Before != transition.After;
+    States[transition.Buffer] = transition.After;
+  }
+  auto &command = Log.emplace_back();
+  command.Type = Kind::Barrier;
+  command.Transitions.assign(transitions.begin(), transitions.end());
+}
+
+void RecordingClothCommands::CopyInitialState(int buffer) {
+  Consistent &= States[buffer] == ClothBufferState::CopyDest;
+  auto &command = Log.emplace_back();
+  command.Type = Kind::Copy;
+  command.Destination = buffer;
+}
+
+void RecordingClothCommands::Dispatch(int source, int destination,
+                                      uint32 groupCount) {
+  Consistent &= source != destination &&
+                States[source] == ClothBufferState::ShaderResource &&
+                States[destination] == ClothBufferState::UnorderedAccess;
+  auto &command = Log.emplace_back();
+  command.Type = Kind::Dispatch;
+  command.Source = source;
+  command.Destination = destination;
+  command.GroupCount = groupCount;
+}
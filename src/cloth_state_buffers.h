@@ -0,0 +1,119 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// The states the GPU cloth's buffers pass through, standing for
+// D3D12_RESOURCE_STATE_COMMON, COPY_DEST, NON_PIXEL_SHADER_RESOURCE,
+// UNORDERED_ACCESS and VERTEX_AND_CONSTANT_BUFFER.
+enum class ClothBufferState {
+  Common,
+  CopyDest,
+  ShaderResource,
+  UnorderedAccess,
+  VertexBuffer
+};
+
+// What recording the cloth's commands needs from a command list.  Cloth
+// records into a D3D12 command list; RecordingClothCommands only logs, so
+// the sequence can be checked without a device.
+class ClothCommands {
+public:
+  using uint32 = std::uint32_t;
+
+  struct Transition {
+    int Buffer;
+    ClothBufferState Before, After;
+  };
+
+  virtual ~ClothCommands() = default;
+
+  // One batch of transitions, as one ResourceBarrier call.
+  virtual void ResourceBarrier(std::span<const Transition> transitions) = 0;
+  // Copies the cloth's starting vertices into buffer.
+  virtual void CopyInitialState(int buffer) = 0;
+  // One step reading source through its SRV and writing destination
+  // through its UAV.
+  virtual void Dispatch(int source, int destination, uint32 groupCount) = 0;
+};
+
+// The cloth's state as two buffers that swap roles every step: the step
+// reads the buffer holding the latest state and writes the other, which
+// then holds the latest state.  Nothing is copied per step.  The state of
+// each buffer is tracked across steps and frames, so a step only records
+// the two transitions that swap the roles, batched into one barrier, and
+// drawing adds one more to make the latest state a vertex buffer.
+//
+//   buffers.RecordReset(commands);        // once, or to restart the cloth
+//   buffers.RecordStep(commands, vertexCount);
+//   buffers.RecordPrepareForDraw(commands);
+//   ... draw from buffer buffers.Current() ...
+class ClothStateBuffers {
+public:
+  using uint32 = std::uint32_t;
+
+  static constexpr int Count = 2;
+  static constexpr uint32 ThreadGroupSize = 64;
+
+  // Copies the starting vertices into the current buffer.
+  void RecordReset(ClothCommands &commands);
+  void RecordStep(ClothCommands &commands, uint32 vertexCount);
+  // Moves the current buffer to where the input assembler can read it.
+  // The next step moves it back.
+  void RecordPrepareForDraw(ClothCommands &commands);
+
+  // The buffer holding the latest state.
+  int Current() const { return CurrentIndex; }
+  ClothBufferState State(int buffer) const { return States[buffer]; }
+
+private:
+  // Moves each buffer with a wanted state into it, skipping those already
+  // there.
+  void RecordTransitions(ClothCommands &commands,
+                         std::span<const ClothBufferState> wanted);
+
+  // Buffers are created in COMMON.
+  std::array<ClothBufferState, Count> States = {ClothBufferState::Common,
+                                                ClothBufferState::Common};
+  int CurrentIndex = 0;
+};
+
+// ClothCommands that keeps a log and checks each transition starts from the
+// state its buffer is really in.
+class RecordingClothCommands : public ClothCommands {
+public:
+  enum class Kind { Barrier, Copy, Dispatch };
+
+  struct Command {
+    Kind Type;
+    // For Barrier.
+    std::vector<Transition> Transitions;
+    // Copy writes Destination; Dispatch reads Source and writes
+    // Destination.
+    int Source = -1, Destination = -1;
+    uint32 GroupCount = 0;
+  };
+
+  void ResourceBarrier(std::span<const Transition> transitions) override;
+  void CopyInitialState(int buffer) override;
+  void Dispatch(int source, int destination, uint32 groupCount) override;
+
+  const std::vector<Command> &Commands() const { return Log; }
+  void Clear() { Log.clear(); }
+
+  // False once a transition's Before state, a copy or a dispatch did not
+  // match the state its buffer was in.
+  bool Valid() const { return Consistent; }
+
+private:
+  std::vector<Command> Log;
+  std::array<ClothBufferState, ClothStateBuffers::Count> States = {
+      ClothBufferState::Common, ClothBufferState::Common};
+  bool Consistent = true;
+};
@@ -0,0 +1,579 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "cpu_cloth.h"
+#include "mesh_bounds.h"
+#include "simd.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <iterator>
+
+using namespace DirectX;
+
+namespace {
+template <typename Body>
+void ForRange(ThreadPool *pool, size_t count, const Body &body) {
+  if (pool && count > CpuCloth::ParallelGrainSize) {
+    pool->ParallelForRange(count, CpuCloth::ParallelGrainSize, body);
+  } else {
+    body(0, count);
+  }
+}
+
+// Shorter constraints are left alone rather than pushed apart along an
+// arbitrary direction.
+constexpr float MinLength = 1e-6f;
+
+std::uint64_t PairKey(std::uint64_t a, std::uint64_t b) {
+  return std::min(a, b) << 32 | std::max(a, b);
+}
+} // namespace
+
+CpuCloth::CpuCloth(std::span<const XMFLOAT3> positions,
+                   std::span<const uint32> indices, const Settings &settings)
+    : Config(settings), Count(positions.size()) {
+  auto padded = Simd::Padded(Count + 1);
+  for (auto array : {&PositionX, &PositionY, &PositionZ, &PreviousX,
+                     &PreviousY, &PreviousZ, &InverseMass, &DeltaX, &DeltaY,
+                     &DeltaZ}) {
+    array->assign(padded, 0.0f);
+  }
+  float inverseMass = (float)Count / Config.Mass;
+  for (size_t p = 0; p < Count; p++) {
+    PositionX[p] = PreviousX[p] = positions[p].x;
+    PositionY[p] = PreviousY[p] = positions[p].y;
+    PositionZ[p] = PreviousZ[p] = positions[p].z;
+    InverseMass[p] = inverseMass;
+  }
+  RestX.assign(PositionX.begin(), PositionX.begin() + Count);
+  RestY.assign(PositionY.begin(), PositionY.begin() + Count);
+  RestZ.assign(PositionZ.begin(), PositionZ.begin() + Count);
+
+  std::vector<Constraint> constraints;
+  BuildConstraints(indices, constraints);
+  ColorConstraints(constraints, positions);
+
+  float edgeLength = 0.0f;
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    auto a = indices[t], b = indices[t + 1], c = indices[t + 2];
+    if (a == b || b == c || c == a) {
+      continue;
+    }
+    Triangles.insert(Triangles.end(), {a, b, c});
+    for (auto [u, v] : {std::pair(a, b), std::pair(b, c), std::pair(c, a)}) {
+      XMVECTOR d = XMLoadFloat3(&positions[v]) - XMLoadFloat3(&positions[u]);
+      edgeLength += XMVectorGetX(XMVector3Length(d));
+    }
+  }
+  auto triangleCount = Triangles.size() / 3;
+  TriangleMin.resize(triangleCount);
+  TriangleMax.resize(triangleCount);
+  TrianglePlane.resize(triangleCount);
+  MeanEdgeLength = triangleCount > 0 ? edgeLength / (3 * triangleCount) : 0;
+}
+
+void CpuCloth::BuildConstraints(std::span<const uint32> indices,
+                                std::vector<Constraint> &constraints) const {
+  // Every half edge with the vertex opposite it.  Sorting brings the two
+  // sides of an interior edge together.
+  struct HalfEdge {
+    std::uint64_t Key;
+    uint32 Opposite;
+  };
+  std::vector<HalfEdge> halfEdges;
+  halfEdges.reserve(indices.size());
+  for (size_t t = 0; t + 2 < indices.size(); t += 3) {
+    for (size_t k = 0; k < 3; k++) {
+      auto a = indices[t + k], b = indices[t + (k + 1) % 3];
+      if (a != b) {
+        halfEdges.push_back({PairKey(a, b), indices[t + (k + 2) % 3]});
+      }
+    }
+  }
+  std::sort(halfEdges.begin(), halfEdges.end(),
+            [](const HalfEdge &x, const HalfEdge &y) { return x.Key < y.Key; });
+
+  std::vector<std::uint64_t> stretch, bend;
+  for (size_t i = 0; i < halfEdges.size();) {
+    auto j = i;
+    while (j < halfEdges.size() && halfEdges[j].Key == halfEdges[i].Key) {
+      j++;
+    }
+    stretch.push_back(halfEdges[i].Key);
+    // Edges with more than two triangles are not manifold and get no
+    // bending constraint.
+    if (j - i == 2 && halfEdges[i].Opposite != halfEdges[i + 1].Opposite) {
+      bend.push_back(PairKey(halfEdges[i].Opposite, halfEdges[i + 1].Opposite));
+    }
+    i = j;
+  }
+
+  // A pair found across several edges is bent once, and a pair that is an
+  // edge itself only stretches.
+  std::sort(bend.begin(), bend.end());
+  bend.erase(std::unique(bend.begin(), bend.end()), bend.end());
+  std::vector<std::uint64_t> bendOnly;
+  std::set_difference(bend.begin(), bend.end(), stretch.begin(),
+                      stretch.end(), std::back_inserter(bendOnly));
+
+  constraints.reserve(stretch.size() + bendOnly.size());
+  for (auto key : stretch) {
+    constraints.push_back(
+        {(uint32)(key >> 32), (uint32)key, Config.StretchCompliance});
+  }
+  for (auto key : bendOnly) {
+    constraints.push_back(
+        {(uint32)(key >> 32), (uint32)key, Config.BendCompliance});
+  }
+}
+
+void CpuCloth::ColorConstraints(const std::vector<Constraint> &constraints,
+                                std::span<const XMFLOAT3> positions) {
+  ConstraintCountUnpadded = constraints.size();
+
+  // Constraints of each particle, as a counting sort.
+  std::vector<uint32> offsets(Count + 1, 0);
+  for (auto &constraint : constraints) {
+    offsets[constraint.A + 1]++;
+    offsets[constraint.B + 1]++;
+  }
+  for (size_t p = 0; p < Count; p++) {
+    offsets[p + 1] += offsets[p];
+  }
+  std::vector<uint32> incident(2 * constraints.size());
+  std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+  for (size_t c = 0; c < constraints.size(); c++) {
+    incident[fill[constraints[c].A]++] = (uint32)c;
+    incident[fill[constraints[c].B]++] = (uint32)c;
+  }
+
+  // Greedy coloring: each constraint takes the lowest color none of the
+  // constraints sharing a particle with it has taken yet.  taken[k] holds
+  // the last constraint that saw color k in use.
+  constexpr uint32 Uncolored = ~0u;
+  std::vector<uint32> colors(constraints.size(), Uncolored);
+  std::vector<uint32> taken;
+  std::vector<uint32> colorSizes;
+  for (size_t c = 0; c < constraints.size(); c++) {
+    for (auto p : {constraints[c].A, constraints[c].B}) {
+      for (auto i = offsets[p]; i < offsets[p + 1]; i++) {
+        auto color = colors[incident[i]];
+        if (color != Uncolored) {
+          taken[color] = (uint32)c;
+        }
+      }
+    }
+    uint32 color = 0;
+    while (color < taken.size() && taken[color] == c) {
+      color++;
+    }
+    if (color == taken.size()) {
+      taken.push_back(Uncolored);
+      colorSizes.push_back(0);
+    }
+    colors[c] = color;
+    colorSizes[color]++;
+  }
+
+  // Lay the colors out one after another, each padded with constraints
+  // from the first padding particle to itself.
+  ColorOffsets.assign(colorSizes.size() + 1, 0);
+  for (size_t k = 0; k < colorSizes.size(); k++) {
+    ColorOffsets[k + 1] =
+        ColorOffsets[k] + (uint32)Simd::Padded(colorSizes[k]);
+  }
+  auto total = ColorOffsets.back();
+  ConstraintA.assign(total, (uint32)Count);
+  ConstraintB.assign(total, (uint32)Count);
+  RestLength.assign(total, 0.0f);
+  Compliance.assign(total, 0.0f);
+  Lambda.assign(total, 0.0f);
+
+  std::vector<uint32> next(ColorOffsets.begin(), ColorOffsets.end() - 1);
+  for (size_t c = 0; c < constraints.size(); c++) {
+    auto slot = next[colors[c]]++;
+    auto &constraint = constraints[c];
+    ConstraintA[slot] = constraint.A;
+    ConstraintB[slot] = constraint.B;
+    Compliance[slot] = constraint.Compliance;
+    XMVECTOR d = XMLoadFloat3(&positions[constraint.B]) -
+                 XMLoadFloat3(&positions[constraint.A]);
+    RestLength[slot] = XMVectorGetX(XMVector3Length(d));
+  }
+}
+
+void CpuCloth::SetInverseMass(size_t particle, float inverseMass) {
+  InverseMass[particle] = inverseMass;
+}
+
+void CpuCloth::SetPosition(size_t particle, XMFLOAT3 position) {
+  PositionX[particle] = PreviousX[particle] = position.x;
+  PositionY[particle] = PreviousY[particle] = position.y;
+  PositionZ[particle] = PreviousZ[particle] = position.z;
+}
+
+void CpuCloth::SetColliders(const ClothColliders *colliders) {
+  Colliders = colliders;
+}
+
+void CpuCloth::Execute(float deltaTime, ThreadPool *pool) {
+  // Damping is per Execute, however many substeps it takes.
+  auto substeps = std::max(Config.Substeps, 1);
+  auto substepTime = deltaTime / (float)substeps;
+  auto deltaTime2 = substepTime * substepTime;
+  auto keep = std::pow(1.0f - Config.Damping, 1.0f / (float)substeps);
+
+  for (int s = 0; s < substeps; s++) {
+    ForRange(pool, PositionX.size(), [&](size_t begin, size_t end) {
+      Integrate(begin, end, keep, deltaTime2);
+    });
+
+    // The multipliers sum a constraint's corrections over one substep.
+    std::fill(Lambda.begin(), Lambda.end(), 0.0f);
+
+    // Colors run one after another, since consecutive colors share
+    // particles.
+    for (int i = 0; i < Config.Iterations; i++) {
+      for (size_t k = 0; k < ColorCount(); k++) {
+        auto first = ColorOffsets[k];
+        ForRange(pool, ColorOffsets[k + 1] - first,
+                 [&](size_t begin, size_t end) {
+                   ProjectConstraints(first + begin, first + end,
+                                      1.0f / deltaTime2);
+                 });
+      }
+    }
+
+    if (Config.SelfCollision) {
+      CollideSelf(pool);
+    }
+    if (Colliders) {
+      CollideObstacles(pool);
+    }
+  }
+}
+
+void CpuCloth::Integrate(size_t begin, size_t end, float keep,
+                         float deltaTime2) {
+  float gravity[3] = {Config.Gravity.x * deltaTime2,
+                      Config.Gravity.y * deltaTime2,
+                      Config.Gravity.z * deltaTime2};
+  float *position[3] = {PositionX.data(), PositionY.data(), PositionZ.data()};
+  float *previous[3] = {PreviousX.data(), PreviousY.data(), PreviousZ.data()};
+
+  if (Config.Kernels == Kernel::Scalar) {
+    for (size_t p = begin; p < end; p++) {
+      if (InverseMass[p] <= 0.0f) {
+        continue;
+      }
+      for (int a = 0; a < 3; a++) {
+        float x = position[a][p];
+        float velocity = (x - previous[a][p]) * keep;
+        previous[a][p] = x;
+        position[a][p] = x + velocity + gravity[a];
+      }
+    }
+    return;
+  }
+
+  auto vkeep = Simd::Set(keep);
+  auto zero = Simd::Set(0.0f);
+  for (size_t p = begin; p < end; p += Simd::Width) {
+    auto free = Simd::Greater(Simd::Load(&InverseMass[p]), zero);
+    for (int a = 0; a < 3; a++) {
+      auto x = Simd::Load(&position[a][p]);
+      auto before = Simd::Load(&previous[a][p]);
+      auto velocity = (x - before) * vkeep;
+      auto moved = x + velocity + Simd::Set(gravity[a]);
+      Simd::Store(&previous[a][p], Simd::Select(before, x, free));
+      Simd::Store(&position[a][p], Simd::Select(x, moved, free));
+    }
+  }
+}
+
+void CpuCloth::ProjectConstraints(size_t begin, size_t end,
+                                  float inverseDeltaTime2) {
+  // The range lies within one color, so no two constraints in it touch the
+  // same particle and the SIMD kernel may scatter freely.
+  //
+  // XPBD: with C = length - rest and the compliance scaled by 1 / dt^2 to
+  // a, each iteration changes the multiplier by
+  //   dLambda = -(C + a * Lambda) / (wA + wB + a)
+  // and moves the ends by w * dLambda along the constraint gradient.  The
+  // multiplier keeps the force found so far, so the stiffness reached does
+  // not depend on the iteration count.
+  float *position[3] = {PositionX.data(), PositionY.data(), PositionZ.data()};
+
+  if (Config.Kernels == Kernel::Scalar) {
+    for (size_t c = begin; c < end; c++) {
+      auto a = ConstraintA[c], b = ConstraintB[c];
+      float d[3];
+      for (int k = 0; k < 3; k++) {
+        d[k] = position[k][b] - position[k][a];
+      }
+      float length = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+      float weight = InverseMass[a] + InverseMass[b];
+      if (length <= MinLength || weight <= 0.0f) {
+        continue;
+      }
+      float alpha = Compliance[c] * inverseDeltaTime2;
+      float deltaLambda =
+          -(length - RestLength[c] + alpha * Lambda[c]) / (weight + alpha);
+      Lambda[c] = Lambda[c] + deltaLambda;
+      // Along d = b - a, the gradient is -d / length at a and d / length
+      // at b.
+      float scale = -deltaLambda / length;
+      float scaleA = InverseMass[a] * scale, scaleB = InverseMass[b] * scale;
+      for (int k = 0; k < 3; k++) {
+        position[k][a] = position[k][a] + d[k] * scaleA;
+        position[k][b] = position[k][b] - d[k] * scaleB;
+      }
+    }
+    return;
+  }
+
+  auto minLength = Simd::Set(MinLength);
+  auto zero = Simd::Set(0.0f);
+  auto vinverseDeltaTime2 = Simd::Set(inverseDeltaTime2);
+  for (size_t c = begin; c < end; c += Simd::Width) {
+    auto a = &ConstraintA[c], b = &ConstraintB[c];
+    Simd::Float pa[3], pb[3], d[3];
+    for (int k = 0; k < 3; k++) {
+      pa[k] = Simd::Gather(position[k], a);
+      pb[k] = Simd::Gather(position[k], b);
+      d[k] = pb[k] - pa[k];
+    }
+    auto length = Simd::Sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    auto weightA = Simd::Gather(InverseMass.data(), a);
+    auto weightB = Simd::Gather(InverseMass.data(), b);
+    auto weight = weightA + weightB;
+
+    // Degenerate lanes divide by zero; Select drops what they produce.
+    auto valid = Simd::And(Simd::Greater(length, minLength),
+                           Simd::Greater(weight, zero));
+    auto alpha = Simd::Load(&Compliance[c]) * vinverseDeltaTime2;
+    auto lambda = Simd::Load(&Lambda[c]);
+    auto deltaLambda =
+        zero - (length - Simd::Load(&RestLength[c]) + alpha * lambda) /
+                   (weight + alpha);
+    deltaLambda = Simd::Select(zero, deltaLambda, valid);
+    Simd::Store(&Lambda[c], lambda + deltaLambda);
+    auto scale = Simd::Select(zero, (zero - deltaLambda) / length, valid);
+    auto scaleA = weightA * scale, scaleB = weightB * scale;
+    for (int k = 0; k < 3; k++) {
+      Simd::Scatter(position[k], a, pa[k] + d[k] * scaleA);
+      Simd::Scatter(position[k], b, pb[k] - d[k] * scaleB);
+    }
+  }
+}
+
+void CpuCloth::CollideSelf(ThreadPool *pool) {
+  // Particle contacts are within Thickness, so cells of that size keep them
+  // in the 27 cells around a particle.  Triangle cells are no smaller than
+  // a triangle, which keeps each triangle in a few cells.
+  float thickness = Config.Thickness;
+  ParticleHash.SetCellSize(thickness);
+  TriangleHash.SetCellSize(std::max<float>(thickness, MeanEdgeLength));
+  ParticleHash.BuildPoints(PositionX.data(), PositionY.data(),
+                           PositionZ.data(), Count, pool);
+
+  // Triangle boxes grown by Thickness, so a particle only needs the
+  // triangles in its own cell.  The planes let most of those be rejected
+  // before any vertex is loaded.
+  ForRange(pool, TriangleMin.size(), [&](size_t begin, size_t end) {
+    for (size_t t = begin; t < end; t++) {
+      XMVECTOR low = XMVectorReplicate(FLT_MAX);
+      XMVECTOR high = XMVectorReplicate(-FLT_MAX);
+      for (size_t k = 0; k < 3; k++) {
+        XMVECTOR p = LoadPosition(Triangles[3 * t + k]);
+        low = XMVectorMin(low, p);
+        high = XMVectorMax(high, p);
+      }
+      XMVECTOR margin = XMVectorReplicate(thickness);
+      XMStoreFloat3(&TriangleMin[t], low - margin);
+      XMStoreFloat3(&TriangleMax[t], high + margin);
+
+      XMVECTOR pa = LoadPosition(Triangles[3 * t]);
+      XMVECTOR n = XMVector3Cross(LoadPosition(Triangles[3 * t + 1]) - pa,
+                                  LoadPosition(Triangles[3 * t + 2]) - pa);
+      float area2 = XMVectorGetX(XMVector3Length(n));
+      if (area2 < MinLength * MinLength) {
+        // Collapsed: no point is ever within Thickness of the plane.
+        TrianglePlane[t] = {0.0f, 0.0f, 0.0f, FLT_MAX};
+        continue;
+      }
+      n /= area2;
+      XMStoreFloat4(&TrianglePlane[t],
+                    XMVectorSetW(n, -XMVectorGetX(XMVector3Dot(n, pa))));
+    }
+  });
+  TriangleHash.BuildBoxes(TriangleMin, TriangleMax);
+
+  ForRange(pool, PositionX.size(), [&](size_t begin, size_t end) {
+    FindSelfContacts(begin, end);
+  });
+  ForRange(pool, PositionX.size(), [&](size_t begin, size_t end) {
+    ApplyDeltas(begin, end);
+  });
+}
+
+void CpuCloth::FindSelfContacts(size_t begin, size_t end) {
+  // Each particle takes its share of every contact it is in and moves only
+  // itself, so particles never write to each other.
+  float thickness = Config.Thickness;
+  float thickness2 = thickness * thickness;
+  end = std::min(end, Count);
+  for (size_t i = begin; i < end; i++) {
+    DeltaX[i] = DeltaY[i] = DeltaZ[i] = 0.0f;
+    float wi = InverseMass[i];
+    if (wi <= 0.0f) {
+      continue;
+    }
+    XMVECTOR p = LoadPosition(i);
+    XMVECTOR rest = XMVectorSet(RestX[i], RestY[i], RestZ[i], 0.0f);
+    auto cell = ParticleHash.CellOf(PositionX[i], PositionY[i], PositionZ[i]);
+
+    // Particle against particle: both move apart, each by its share.
+    XMVECTOR delta = XMVectorZero();
+    ParticleHash.ForEachNear(cell, [&](uint32 j) {
+      if (j == i) {
+        return;
+      }
+      XMVECTOR d = p - LoadPosition(j);
+      float distance2 = XMVectorGetX(XMVector3LengthSq(d));
+      if (distance2 >= thickness2 || distance2 < MinLength * MinLength) {
+        return;
+      }
+      XMVECTOR restD = rest - XMVectorSet(RestX[j], RestY[j], RestZ[j], 0.0f);
+      if (XMVectorGetX(XMVector3LengthSq(restD)) < thickness2) {
+        return;
+      }
+      float distance = std::sqrt(distance2);
+      float share = wi / (wi + InverseMass[j]);
+      delta += d * ((thickness - distance) / distance * share);
+    });
+
+    // Particle against triangle: pushed back to the side it was on at the
+    // start of the substep, out of the deepest triangle only, so a
+    // triangle listed twice in a slot counts once.
+    float deepest = 0.0f;
+    XMVECTOR push = XMVectorZero();
+    for (auto t : TriangleHash.Items(cell)) {
+      XMVECTOR plane = XMLoadFloat4(&TrianglePlane[t]);
+      float height = XMVectorGetX(XMVector3Dot(p, plane)) + TrianglePlane[t].w;
+      if (std::abs(height) >= thickness) {
+        continue;
+      }
+      auto a = Triangles[3 * t], b = Triangles[3 * t + 1];
+      auto c = Triangles[3 * t + 2];
+      if (a == i || b == i || c == i) {
+        continue;
+      }
+
+      XMVECTOR pa = LoadPosition(a);
+      XMVECTOR e1 = LoadPosition(b) - pa;
+      XMVECTOR e2 = LoadPosition(c) - pa;
+      XMVECTOR n = XMVectorSetW(plane, 0.0f);
+      XMVECTOR offset = p - pa;
+
+      // Contacts off the face are left to the particle test.
+      XMVECTOR q = offset - n * height;
+      float d11 = XMVectorGetX(XMVector3Dot(e1, e1));
+      float d12 = XMVectorGetX(XMVector3Dot(e1, e2));
+      float d22 = XMVectorGetX(XMVector3Dot(e2, e2));
+      float dq1 = XMVectorGetX(XMVector3Dot(q, e1));
+      float dq2 = XMVectorGetX(XMVector3Dot(q, e2));
+      float det = d11 * d22 - d12 * d12;
+      float u = (d22 * dq1 - d12 * dq2) / det;
+      float v = (d11 * dq2 - d12 * dq1) / det;
+      if (u < 0.0f || v < 0.0f || u + v > 1.0f) {
+        continue;
+      }
+
+      XMVECTOR previousA = LoadPrevious(a);
+      XMVECTOR previousNormal = XMVector3Cross(LoadPrevious(b) - previousA,
+                                               LoadPrevious(c) - previousA);
+      XMVECTOR previousOffset = LoadPrevious(i) - previousA;
+      float side =
+          XMVectorGetX(XMVector3Dot(previousOffset, previousNormal)) < 0.0f
+              ? -1.0f
+              : 1.0f;
+
+      float depth = thickness - side * height;
+      if (depth > deepest) {
+        float triangleWeight =
+            (InverseMass[a] + InverseMass[b] + InverseMass[c]) / 3.0f;
+        deepest = depth;
+        push = n * (side * depth * wi / (wi + triangleWeight));
+      }
+    }
+
+    XMFLOAT3 total;
+    XMStoreFloat3(&total, delta + push);
+    DeltaX[i] = total.x;
+    DeltaY[i] = total.y;
+    DeltaZ[i] = total.z;
+  }
+}
+
+void CpuCloth::ApplyDeltas(size_t begin, size_t end) {
+  float *position[3] = {PositionX.data(), PositionY.data(), PositionZ.data()};
+  const float *delta[3] = {DeltaX.data(), DeltaY.data(), DeltaZ.data()};
+
+  if (Config.Kernels == Kernel::Scalar) {
+    for (size_t p = begin; p < end; p++) {
+      for (int k = 0; k < 3; k++) {
+        position[k][p] = position[k][p] + delta[k][p];
+      }
+    }
+    return;
+  }
+
+  for (size_t p = begin; p < end; p += Simd::Width) {
+    for (int k = 0; k < 3; k++) {
+      Simd::Store(&position[k][p], Simd::Load(&position[k][p]) +
+                                       Simd::Load(&delta[k][p]));
+    }
+  }
+}
+
+void CpuCloth::CollideObstacles(ThreadPool *pool) {
+  BoundingBox bounds;
+  BoundingSphere sphere;
+  MeshBounds::Compute(PositionX.data(), PositionY.data(), PositionZ.data(),
+                      Count, bounds, sphere);
+  float margin = 0.5f * Config.Thickness;
+  Colliders->Cull(bounds, margin, NearbyColliders);
+  auto &nearby = NearbyColliders;
+  if (nearby.Empty()) {
+    return;
+  }
+
+  ForRange(pool, PositionX.size(), [&](size_t begin, size_t end) {
+    Colliders->Resolve(nearby, margin, PositionX.data(), PositionY.data(),
+                       PositionZ.data(), InverseMass.data(), begin, end,
+                       Config.Kernels == Kernel::Simd);
+  });
+}
+
+XMVECTOR CpuCloth::LoadPosition(size_t particle) const {
+  return XMVectorSet(PositionX[particle], PositionY[particle],
+                     PositionZ[particle], 0.0f);
+}
+
+XMVECTOR CpuCloth::LoadPrevious(size_t particle) const {
+  return XMVectorSet(PreviousX[particle], PreviousY[particle],
+                     PreviousZ[particle], 0.0f);
+}
+
+XMFLOAT3 CpuCloth::Position(size_t particle) const {
+  return {PositionX[particle], PositionY[particle], PositionZ[particle]};
+}
+
+void CpuCloth::Output(MeshNormals::Stream<XMFLOAT3> positions) const {
+  for (size_t p = 0; p < Count; p++) {
+    positions[p] = Position(p);
+  }
+}
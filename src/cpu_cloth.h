@@ -0,0 +1,172 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "cloth_colliders.h"
+#include "mesh_normals.h"
+#include "spatial_hash.h"
+#include "thread_pool.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Cloth simulated on the CPU, for machines without a usable GPU and for
+// checking the simulation headless.  It takes the cloth mesh the renderer
+// uploads and gives back positions in the same vertex order, like Cloth
+// does on the GPU.
+//
+// Particles are stored as SoA float arrays (positions, previous positions,
+// inverse masses) padded to whole SIMD vectors.  Every mesh edge is a
+// stretch constraint, and the two vertices opposite each interior edge are
+// held apart by a bending constraint.  Each step integrates with damped
+// Verlet and then projects the constraints Gauss-Seidel style, as XPBD:
+// stiffness is given physically, as compliance, and each constraint
+// accumulates its Lagrange multiplier over the step, so the stiffness does
+// not change with the iteration count.  What few iterations leave is
+// convergence error, which splitting the step into substeps removes far
+// more cheaply than iterating: 8 substeps of 1 iteration stretch less than
+// 1 step of 32.
+//
+// The constraints are split once, by greedy graph coloring, into colors in
+// which no two share a particle.  Colors are projected one after another;
+// the constraints of a color are independent, so they are projected
+// Simd::Width at a time and spread over the thread pool without atomics or
+// locks.  The result does not depend on the thread count.
+//
+// With self collision on, every substep ends by keeping particles at least
+// Thickness away from each other and from the triangles they are not part
+// of.  Particles and triangles are put in spatial hashes rebuilt each
+// substep; each particle then finds its own contacts and computes its own
+// correction, in parallel, before any particle moves.
+//
+// Obstacles come from a ClothColliders set, checked against the cloth's
+// bounds every substep and resolved last, after self collision, so nothing
+// is left inside them.
+//
+//   CpuCloth cloth(positions, indices, {});
+//   cloth.SetInverseMass(0, 0.0f);
+//   ...
+//   cloth.Execute(timer.DeltaTime(), &ThreadPool::Shared());
+//   cloth.Output({&vertices[0].Pos, sizeof(Vertex)});
+class CpuCloth {
+public:
+  using uint32 = std::uint32_t;
+
+  enum class Kernel { Scalar, Simd };
+
+  struct Settings {
+    DirectX::XMFLOAT3 Gravity;
+    // Fraction of the velocity lost per Execute.
+    float Damping;
+    // Kilograms, shared equally by the particles.
+    float Mass;
+    // Inverse stiffness in metres per newton; 0 is rigid.
+    float StretchCompliance;
+    float BendCompliance;
+    // Each Execute runs Substeps steps of Iterations iterations.
+    int Substeps;
+    int Iterations;
+    bool SelfCollision;
+    // Metres the cloth keeps between its layers, and twice what it keeps
+    // off colliders.  Particles closer than this at rest do not collide
+    // with each other.
+    float Thickness;
+    // Scalar is the reference the SIMD kernels must match.
+    Kernel Kernels;
+
+    Settings()
+        : Gravity(0.0f, -9.8f, 0.0f), Damping(0.01f), Mass(0.2f),
+          StretchCompliance(1e-6f), BendCompliance(1e-3f), Substeps(4),
+          Iterations(2), SelfCollision(false), Thickness(0.01f),
+          Kernels(Kernel::Simd) {}
+  };
+
+  // Every particle starts with an equal share of Settings::Mass.
+  CpuCloth(std::span<const DirectX::XMFLOAT3> positions,
+           std::span<const uint32> indices, const Settings &settings);
+
+  size_t ParticleCount() const { return Count; }
+  size_t ConstraintCount() const { return ConstraintCountUnpadded; }
+  size_t ColorCount() const { return ColorOffsets.size() - 1; }
+
+  // Mass and compliances are baked into the particles and constraints when
+  // the cloth is built; the other settings may change between steps.
+  Settings &Parameters() { return Config; }
+
+  // Per kilogram; 0 pins the particle in place.
+  void SetInverseMass(size_t particle, float inverseMass);
+
+  // Moves a particle without giving it velocity.  Its rest shape stays the
+  // one the cloth was built with.
+  void SetPosition(size_t particle, DirectX::XMFLOAT3 position);
+
+  // Obstacles for the cloth to rest on, or null.  The set is not copied, so
+  // it must outlive the cloth or be replaced first.
+  void SetColliders(const ClothColliders *colliders);
+
+  // Advances the cloth by deltaTime, serially when pool is null.
+  void Execute(float deltaTime, ThreadPool *pool = nullptr);
+
+  DirectX::XMFLOAT3 Position(size_t particle) const;
+  void Output(MeshNormals::Stream<DirectX::XMFLOAT3> positions) const;
+
+  // Multiple of Simd::Width, so parallel ranges stay whole vectors.
+  static constexpr size_t ParallelGrainSize = 1024;
+
+private:
+  struct Constraint {
+    uint32 A, B;
+    float Compliance;
+  };
+
+  void BuildConstraints(std::span<const uint32> indices,
+                        std::vector<Constraint> &constraints) const;
+  void ColorConstraints(const std::vector<Constraint> &constraints,
+                        std::span<const DirectX::XMFLOAT3> positions);
+  void Integrate(size_t begin, size_t end, float keep, float deltaTime2);
+  void ProjectConstraints(size_t begin, size_t end, float inverseDeltaTime2);
+  void CollideSelf(ThreadPool *pool);
+  void FindSelfContacts(size_t begin, size_t end);
+  void ApplyDeltas(size_t begin, size_t end);
+  void CollideObstacles(ThreadPool *pool);
+  DirectX::XMVECTOR LoadPosition(size_t particle) const;
+  DirectX::XMVECTOR LoadPrevious(size_t particle) const;
+
+  Settings Config;
+  size_t Count = 0;
+  size_t ConstraintCountUnpadded = 0;
+
+  // Per particle, padded with pinned particles.  The first padding
+  // particle, at index Count, is always present: padding constraints
+  // connect it to itself.
+  std::vector<float> PositionX, PositionY, PositionZ;
+  std::vector<float> PreviousX, PreviousY, PreviousZ;
+  std::vector<float> InverseMass;
+  // Corrections of the current collision pass.
+  std::vector<float> DeltaX, DeltaY, DeltaZ;
+  // Where the particles started, to tell neighbors from contacts.
+  std::vector<float> RestX, RestY, RestZ;
+
+  // Self collision.  Triangles with repeated vertices are left out.
+  std::vector<uint32> Triangles;
+  std::vector<DirectX::XMFLOAT3> TriangleMin, TriangleMax;
+  // Unit normal and offset, for the current positions.
+  std::vector<DirectX::XMFLOAT4> TrianglePlane;
+  SpatialHash ParticleHash, TriangleHash;
+  float MeanEdgeLength = 0.0f;
+
+  const ClothColliders *Colliders = nullptr;
+  ClothColliders::Selection NearbyColliders;
+
+  // Per constraint, grouped by color.  The constraints of color k are
+  // [ColorOffsets[k], ColorOffsets[k + 1]), padded to whole vectors.
+  std::vector<uint32> ConstraintA, ConstraintB;
+  std::vector<float> RestLength;
+  std::vector<float> Compliance;
+  // Accumulated over the current substep.
+  std::vector<float> Lambda;
+  std::vector<uint32> ColorOffsets;
+};
@@ -0,0 +1,387 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "distance_field.h"
+#include "mesh_bounds.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using namespace DirectX;
+
+namespace {
+// Nodes around a triangle that get its exact distance before sweeping.
+constexpr int ExactBand = 1;
+constexpr int SweepPasses = 2;
+
+// Distance from p to triangle abc, from the closest point of Ericson's
+// "Real-Time Collision Detection", 5.1.5.
+float TriangleDistance(FXMVECTOR p, FXMVECTOR a, FXMVECTOR b, GXMVECTOR c) {
+  auto dot = [](FXMVECTOR u, FXMVECTOR v) {
+    return XMVectorGetX(XMVector3Dot(u, v));
+  };
+  auto distance = [&](FXMVECTOR q) {
+    return XMVectorGetX(XMVector3Length(p - q));
+  };
+
+  XMVECTOR ab = b - a, ac = c - a, ap = p - a;
+  float d1 = dot(ab, ap), d2 = dot(ac, ap);
+  if (d1 <= 0.0f && d2 <= 0.0f) {
+    return distance(a);
+  }
+  XMVECTOR bp = p - b;
+  float d3 = dot(ab, bp), d4 = dot(ac, bp);
+  if (d3 >= 0.0f && d4 <= d3) {
+    return distance(b);
+  }
+  float vc = d1 * d4 - d3 * d2;
+  if (vc <= 0.0f && d1 >= 0.0f && d3 <= 0.0f) {
+    return distance(a + ab * (d1 / (d1 - d3)));
+  }
+  XMVECTOR cp = p - c;
+  float d5 = dot(ab, cp), d6 = dot(ac, cp);
+  if (d6 >= 0.0f && d5 <= d6) {
+    return distance(c);
+  }
+  float vb = d5 * d2 - d1 * d6;
+  if (vb <= 0.0f && d2 >= 0.0f && d6 <= 0.0f) {
+    return distance(a + ac * (d2 / (d2 - d6)));
+  }
+  float va = d3 * d6 - d5 * d4;
+  if (va <= 0.0f && d4 - d3 >= 0.0f && d5 - d6 >= 0.0f) {
+    return distance(b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+  }
+  float denominator = 1.0f / (va + vb + vc);
+  return distance(a + ab * (vb * denominator) + ac * (vc * denominator));
+}
+
+// Sign of the turn from (x1, y1) to (x2, y2), with ties broken the same way
+// for every triangle sharing an edge, so a row through the edge crosses
+// exactly one of them.  area receives twice the signed area.
+int Orientation(double x1, double y1, double x2, double y2, double &area) {
+  area = y1 * x2 - x1 * y2;
+  if (area > 0.0) {
+    return 1;
+  }
+  if (area < 0.0) {
+    return -1;
+  }
+  if (y2 > y1) {
+    return 1;
+  }
+  if (y2 < y1) {
+    return -1;
+  }
+  if (x1 > x2) {
+    return 1;
+  }
+  if (x1 < x2) {
+    return -1;
+  }
+  return 0;
+}
+
+// Whether (x0, y0) lies in the 2D triangle of the other three points, and
+// its barycentric coordinates a, b, c if so.
+bool InTriangle(double x0, double y0, double x1, double y1, double x2,
+                double y2, double x3, double y3, double &a, double &b,
+                double &c) {
+  x1 -= x0, x2 -= x0, x3 -= x0;
+  y1 -= y0, y2 -= y0, y3 -= y0;
+  int signA = Orientation(x2, y2, x3, y3, a);
+  if (signA == 0) {
+    return false;
+  }
+  if (Orientation(x3, y3, x1, y1, b) != signA ||
+      Orientation(x1, y1, x2, y2, c) != signA) {
+    return false;
+  }
+  double sum = a + b + c;
+  a /= sum, b /= sum, c /= sum;
+  return true;
+}
+} // namespace
+
+DistanceField DistanceField::Bake(const XMFLOAT3 *positions,
+                                  size_t vertexCount, size_t positionStride,
+                                  const std::vector<uint32> &indices,
+                                  float cellSize, ThreadPool *pool) {
+  DistanceField field;
+  if (vertexCount == 0 || indices.size() < 3) {
+    return field;
+  }
+  auto bytes = reinterpret_cast<const std::byte *>(positions);
+  auto position = [&](uint32 v) {
+    return XMLoadFloat3(
+        reinterpret_cast<const XMFLOAT3 *>(bytes + v * positionStride));
+  };
+
+  XMFLOAT3 min, max;
+  MeshBounds::ComputeRange(positions, vertexCount, positionStride, min, max);
+  field.Cell = cellSize;
+  field.InverseCell = 1.0f / cellSize;
+  field.Origin = {min.x - Padding * cellSize, min.y - Padding * cellSize,
+                  min.z - Padding * cellSize};
+  auto nodes = [&](float extent) {
+    return (int)std::ceil(extent * field.InverseCell) + 2 * Padding + 1;
+  };
+  int ni = field.NodesX = nodes(max.x - min.x);
+  int nj = field.NodesY = nodes(max.y - min.y);
+  int nk = field.NodesZ = nodes(max.z - min.z);
+  size_t nodeCount = (size_t)ni * nj * nk;
+
+  // Each triangle's vertices in grid coordinates, where node (i, j, k) is at
+  // (i, j, k).
+  size_t triangleCount = indices.size() / 3;
+  XMVECTOR origin = XMLoadFloat3(&field.Origin);
+  std::vector<XMFLOAT3> corners(3 * triangleCount);
+  for (size_t c = 0; c < corners.size(); c++) {
+    XMStoreFloat3(&corners[c],
+                  (position(indices[c]) - origin) * field.InverseCell);
+  }
+
+  // Triangles by the slices of nodes their band reaches, counting sorted so
+  // slice k's are sliceTriangles[sliceStart[k]..sliceStart[k + 1]).
+  auto clamp = [](int a, int n) { return std::clamp(a, 0, n - 1); };
+  auto sliceRange = [&](size_t t, int &k0, int &k1) {
+    auto &p = corners[3 * t], &q = corners[3 * t + 1];
+    auto &r = corners[3 * t + 2];
+    k0 = clamp((int)std::min({p.z, q.z, r.z}) - ExactBand, nk);
+    k1 = clamp((int)std::max({p.z, q.z, r.z}) + ExactBand + 1, nk);
+  };
+  std::vector<uint32> sliceStart(nk + 1, 0);
+  for (size_t t = 0; t < triangleCount; t++) {
+    int k0, k1;
+    sliceRange(t, k0, k1);
+    for (int k = k0; k <= k1; k++) {
+      sliceStart[k + 1]++;
+    }
+  }
+  std::partial_sum(sliceStart.begin(), sliceStart.end(), sliceStart.begin());
+  std::vector<uint32> sliceTriangles(sliceStart[nk]);
+  {
+    auto next = sliceStart;
+    for (size_t t = 0; t < triangleCount; t++) {
+      int k0, k1;
+      sliceRange(t, k0, k1);
+      for (int k = k0; k <= k1; k++) {
+        sliceTriangles[next[k]++] = (uint32)t;
+      }
+    }
+  }
+
+  // Anything farther than the whole grid is as good as unset.
+  float unset = (float)(ni + nj + nk) * cellSize;
+  field.Distances.assign(nodeCount, unset);
+  std::vector<int> closest(nodeCount, -1);
+  std::vector<uint32> crossings(nodeCount, 0);
+  auto triangleDistance = [&](int i, int j, int k, int t) {
+    XMVECTOR p = origin + XMVectorSet((float)i, (float)j, (float)k, 0.0f) *
+                              cellSize;
+    return TriangleDistance(p, position(indices[3 * t]),
+                            position(indices[3 * t + 1]),
+                            position(indices[3 * t + 2]));
+  };
+
+  // A slice only writes its own nodes, so slices run in parallel.
+  auto bakeSlice = [&](size_t k) {
+    for (auto e = sliceStart[k]; e < sliceStart[k + 1]; e++) {
+      auto t = sliceTriangles[e];
+      auto &p = corners[3 * t], &q = corners[3 * t + 1];
+      auto &r = corners[3 * t + 2];
+
+      int i0 = clamp((int)std::min({p.x, q.x, r.x}) - ExactBand, ni);
+      int i1 = clamp((int)std::max({p.x, q.x, r.x}) + ExactBand + 1, ni);
+      int j0 = clamp((int)std::min({p.y, q.y, r.y}) - ExactBand, nj);
+      int j1 = clamp((int)std::max({p.y, q.y, r.y}) + ExactBand + 1, nj);
+      for (int j = j0; j <= j1; j++) {
+        for (int i = i0; i <= i1; i++) {
+          auto node = field.NodeIndex(i, j, (int)k);
+          float d = triangleDistance(i, j, (int)k, (int)t);
+          if (d < field.Distances[node]) {
+            field.Distances[node] = d;
+            closest[node] = (int)t;
+          }
+        }
+      }
+
+      // Where the row of nodes along x through (j, k) crosses the triangle.
+      // A crossing at x counts for the first node past it; rows leaving
+      // the grid on the low side count at node 0.
+      if ((float)k < std::min({p.z, q.z, r.z}) ||
+          (float)k > std::max({p.z, q.z, r.z})) {
+        continue;
+      }
+      j0 = clamp((int)std::ceil(std::min({p.y, q.y, r.y})), nj);
+      j1 = clamp((int)std::floor(std::max({p.y, q.y, r.y})), nj);
+      for (int j = j0; j <= j1; j++) {
+        double a, b, c;
+        if (InTriangle(j, (double)k, p.y, p.z, q.y, q.z, r.y, r.z, a, b, c)) {
+          auto i = (int)std::ceil(a * p.x + b * q.x + c * r.x);
+          if (i < ni) {
+            crossings[field.NodeIndex(std::max(i, 0), j, (int)k)]++;
+          }
+        }
+      }
+    }
+  };
+  if (pool) {
+    pool->ParallelFor((size_t)nk, bakeSlice);
+  } else {
+    for (int k = 0; k < nk; k++) {
+      bakeSlice(k);
+    }
+  }
+
+  // Sweeps in all eight diagonal directions offer each node its upwind
+  // neighbours' closest triangles.  Each node depends on the ones just
+  // swept, so this part is serial.
+  auto offer = [&](int i, int j, int k, int ni1, int nj1, int nk1) {
+    auto node = field.NodeIndex(i, j, k);
+    auto t = closest[field.NodeIndex(ni1, nj1, nk1)];
+    if (t < 0 || t == closest[node]) {
+      return;
+    }
+    float d = triangleDistance(i, j, k, t);
+    if (d < field.Distances[node]) {
+      field.Distances[node] = d;
+      closest[node] = t;
+    }
+  };
+  auto sweep = [&](int di, int dj, int dk) {
+    int i0 = di > 0 ? 1 : ni - 2, i1 = di > 0 ? ni : -1;
+    int j0 = dj > 0 ? 1 : nj - 2, j1 = dj > 0 ? nj : -1;
+    int k0 = dk > 0 ? 1 : nk - 2, k1 = dk > 0 ? nk : -1;
+    for (int k = k0; k != k1; k += dk) {
+      for (int j = j0; j != j1; j += dj) {
+        for (int i = i0; i != i1; i += di) {
+          offer(i, j, k, i - di, j, k);
+          offer(i, j, k, i, j - dj, k);
+          offer(i, j, k, i - di, j - dj, k);
+          offer(i, j, k, i, j, k - dk);
+          offer(i, j, k, i - di, j, k - dk);
+          offer(i, j, k, i, j - dj, k - dk);
+          offer(i, j, k, i - di, j - dj, k - dk);
+        }
+      }
+    }
+  };
+  for (int pass = 0; pass < SweepPasses; pass++) {
+    sweep(+1, +1, +1);
+    sweep(-1, -1, -1);
+    sweep(+1, +1, -1);
+    sweep(-1, -1, +1);
+    sweep(+1, -1, +1);
+    sweep(-1, +1, -1);
+    sweep(+1, -1, -1);
+    sweep(-1, +1, +1);
+  }
+
+  // Inside after an odd number of crossings.  The gradient comes after
+  // every sign is known, by central differences, one-sided on the grid's
+  // faces.
+  auto applySign = [&](size_t k) {
+    for (int j = 0; j < nj; j++) {
+      uint32 total = 0;
+      for (int i = 0; i < ni; i++) {
+        auto node = field.NodeIndex(i, j, (int)k);
+        total += crossings[node];
+        if (total % 2 == 1) {
+          field.Distances[node] = -field.Distances[node];
+        }
+      }
+    }
+  };
+  auto differentiate = [&](size_t slice) {
+    auto k = (int)slice;
+    auto at = [&](int i, int j, int k) {
+      return field.Distances[field.NodeIndex(i, j, k)];
+    };
+    int k0 = std::max(k - 1, 0), k1 = std::min(k + 1, nk - 1);
+    for (int j = 0; j < nj; j++) {
+      int j0 = std::max(j - 1, 0), j1 = std::min(j + 1, nj - 1);
+      for (int i = 0; i < ni; i++) {
+        int i0 = std::max(i - 1, 0), i1 = std::min(i + 1, ni - 1);
+        XMVECTOR g = XMVector3Normalize(XMVectorSet(
+            (at(i1, j, k) - at(i0, j, k)) / (float)(i1 - i0),
+            (at(i, j1, k) - at(i, j0, k)) / (float)(j1 - j0),
+            (at(i, j, k1) - at(i, j, k0)) / (float)(k1 - k0), 0.0f));
+        auto node = field.NodeIndex(i, j, k);
+        field.GradientX[node] = XMVectorGetX(g);
+        field.GradientY[node] = XMVectorGetY(g);
+        field.GradientZ[node] = XMVectorGetZ(g);
+      }
+    }
+  };
+  field.GradientX.resize(nodeCount);
+  field.GradientY.resize(nodeCount);
+  field.GradientZ.resize(nodeCount);
+  if (pool) {
+    pool->ParallelFor((size_t)nk, applySign);
+    pool->ParallelFor((size_t)nk, differentiate);
+  } else {
+    for (int k = 0; k < nk; k++) {
+      applySign(k);
+    }
+    for (int k = 0; k < nk; k++) {
+      differentiate(k);
+    }
+  }
+  return field;
+}
+
+DistanceField DistanceField::Bake(const ObjParser::Result &obj,
+                                  float cellSize, ThreadPool *pool) {
+  std::vector<uint32> indices;
+  indices.reserve(obj.Indices.size());
+  for (auto &index : obj.Indices) {
+    indices.push_back((uint32)index.VertexIndex);
+  }
+  return Bake(reinterpret_cast<const XMFLOAT3 *>(obj.Vertices.data()),
+              obj.Vertices.size() / 3, sizeof(XMFLOAT3), indices, cellSize,
+              pool);
+}
+
+BoundingBox DistanceField::Bounds() const {
+  XMVECTOR min = XMLoadFloat3(&Origin);
+  XMVECTOR max = min + XMVectorSet((float)(NodesX - 1), (float)(NodesY - 1),
+                                   (float)(NodesZ - 1), 0.0f) *
+                           Cell;
+  BoundingBox box;
+  BoundingBox::CreateFromPoints(box, min, max);
+  return box;
+}
+
+float DistanceField::Sample(float x, float y, float z,
+                            XMFLOAT3 &gradient) const {
+  // Clamp onto the nodes, remembering how far that moved the point.
+  float f[3] = {(x - Origin.x) * InverseCell, (y - Origin.y) * InverseCell,
+                (z - Origin.z) * InverseCell};
+  const int n[3] = {NodesX, NodesY, NodesZ};
+  int cell[3];
+  float t[3], outside2 = 0.0f;
+  for (int a = 0; a < 3; a++) {
+    float clamped = std::clamp(f[a], 0.0f, (float)(n[a] - 1));
+    outside2 += (f[a] - clamped) * (f[a] - clamped);
+    cell[a] = std::min((int)clamped, n[a] - 2);
+    t[a] = clamped - (float)cell[a];
+  }
+
+  float distance = 0.0f, gx = 0.0f, gy = 0.0f, gz = 0.0f;
+  for (int corner = 0; corner < 8; corner++) {
+    int di = corner & 1, dj = corner >> 1 & 1, dk = corner >> 2;
+    float weight = (di ? t[0] : 1.0f - t[0]) * (dj ? t[1] : 1.0f - t[1]) *
+                   (dk ? t[2] : 1.0f - t[2]);
+    auto node = NodeIndex(cell[0] + di, cell[1] + dj, cell[2] + dk);
+    distance += weight * Distances[node];
+    gx += weight * GradientX[node];
+    gy += weight * GradientY[node];
+    gz += weight * GradientZ[node];
+  }
+
+  float length = std::sqrt(gx * gx + gy * gy + gz * gz);
+  float scale = length > 0.0f ? 1.0f / length : 0.0f;
+  gradient = {gx * scale, gy * scale, gz * scale};
+  return distance + std::sqrt(outside2) * Cell;
+}
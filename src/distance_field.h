@@ -0,0 +1,88 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "obj_parser.h"
+#include "thread_pool.h"
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Signed distance to a closed triangle mesh, sampled on a dense grid of
+// nodes around it: negative inside, positive outside.  Each node also keeps
+// the unit gradient of the distance, so a lookup returns both the distance
+// and the direction out of the mesh in one trilinear blend of its eight
+// surrounding nodes, whatever the mesh's triangle count.
+//
+// Baking follows Bridson's makelevelset3: exact distances to the nearby
+// triangles in a band of nodes around the surface, fast sweeping to carry
+// the closest triangle out to the rest of the grid, and the sign from the
+// parity of the surface crossings along each row of nodes.  The band and
+// the crossings run in parallel over slabs of the grid.
+//
+//   auto field = DistanceField::Bake(mesh.Vertices, mesh.Indices32, 0.02f,
+//                                    &ThreadPool::Shared());
+//   colliders.AddField(world, field);
+class DistanceField {
+public:
+  using uint32 = std::uint32_t;
+
+  // Nodes of padding around the mesh's bounds, so the field reaches a
+  // little past the surface on every side.
+  static constexpr int Padding = 3;
+
+  // Nodes cellSize apart over the mesh's bounds.  The mesh must be closed
+  // for the sign to be meaningful; a hole lets the inside leak out along
+  // the rows through it.
+  static DistanceField Bake(const DirectX::XMFLOAT3 *positions,
+                            size_t vertexCount, size_t positionStride,
+                            const std::vector<uint32> &indices,
+                            float cellSize, ThreadPool *pool = nullptr);
+
+  // V must start with its XMFLOAT3 position.
+  template <typename V>
+  static DistanceField Bake(const std::vector<V> &vertices,
+                            const std::vector<uint32> &indices,
+                            float cellSize, ThreadPool *pool = nullptr) {
+    static_assert(std::is_standard_layout_v<V>,
+                  "Vertex must be standard layout with position first");
+    return Bake(reinterpret_cast<const DirectX::XMFLOAT3 *>(vertices.data()),
+                vertices.size(), sizeof(V), indices, cellSize, pool);
+  }
+
+  // The v records and triangle corners of an imported OBJ.
+  static DistanceField Bake(const ObjParser::Result &obj, float cellSize,
+                            ThreadPool *pool = nullptr);
+
+  bool Empty() const { return Distances.empty(); }
+  int SizeX() const { return NodesX; }
+  int SizeY() const { return NodesY; }
+  int SizeZ() const { return NodesZ; }
+  float CellSize() const { return Cell; }
+
+  // The box the nodes span, in the mesh's space.
+  DirectX::BoundingBox Bounds() const;
+
+  // Distance at (x, y, z), and the unit direction it grows in.  Outside the
+  // nodes the point is clamped onto them and its distance to them added, so
+  // the result only ever errs on the far side.
+  float Sample(float x, float y, float z, DirectX::XMFLOAT3 &gradient) const;
+
+private:
+  size_t NodeIndex(int i, int j, int k) const {
+    return ((size_t)k * NodesY + j) * NodesX + i;
+  }
+
+  DirectX::XMFLOAT3 Origin = {0.0f, 0.0f, 0.0f};
+  float Cell = 1.0f;
+  float InverseCell = 1.0f;
+  int NodesX = 0, NodesY = 0, NodesZ = 0;
+
+  // One entry per node, x fastest.
+  std::vector<float> Distances;
+  std::vector<float> GradientX, GradientY, GradientZ;
+};
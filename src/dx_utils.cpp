@@ -93,7 +93,25 @@ D3D12_INDEX_BUFFER_VIEW MeshGeometry::IndexBufferView() const {
   };
 }
 
+D3D12_VERTEX_BUFFER_VIEW MeshGeometry::PositionBufferView() const {
+  return D3D12_VERTEX_BUFFER_VIEW{
+      .BufferLocation = PositionGPUBuffer->GetGPUVirtualAddress(),
+      .SizeInBytes = PositionBufferByteSize,
+      .StrideInBytes = PositionByteStride,
+  };
+}
+
+D3D12_INDEX_BUFFER_VIEW MeshGeometry::PositionIndexBufferView() const {
+  return {
+      .BufferLocation = PositionIndexGPUBuffer->GetGPUVirtualAddress(),
+      .SizeInBytes = PositionIndexBufferByteSize,
+      .Format = PositionIndexFormat,
+  };
+}
+
 void MeshGeometry::DisposeUploaders() {
   VertexBufferUploader.Reset();
   IndexBufferUploader.Reset();
+  PositionBufferUploader.Reset();
+  PositionIndexBufferUploader.Reset();
 }
@@ -4,7 +4,10 @@
 
 #pragma once
 #include "math_helper.h"
+#include "mesh_bounds.h"
+#include "meshlet.h"
 #include "stdafx.h"
+#include "vertex_formats.h"
 
 class DXUtils {
 public:
@@ -24,7 +27,16 @@ struct SubmeshGeometry {
   UINT IndexCount = 0;
   UINT StartIndexLocation = 0;
   INT BaseVertexLocation = 0;
+  // Local-space bounds of the vertices the submesh draws from.  Simplified
+  // levels share them with their full-detail submesh.
   DirectX::BoundingBox Bounds;
+  DirectX::BoundingSphere SphereBounds;
+
+  // Geometric error of a simplified level in mesh units, 0 for full detail.
+  float LodError = 0.0f;
+
+  // Bounds the submesh's positions are quantized to with PACKED_VERTICES.
+  PositionQuantization Quantization;
 };
 
 struct MeshGeometry {
@@ -45,8 +57,29 @@ struct MeshGeometry {
 
   std::unordered_map<std::string, SubmeshGeometry> DrawArgs;
 
+  // Optional position-only stream for depth-only passes: tightly packed
+  // positions and an index buffer welded on position alone, with its own
+  // draw arguments.
+  ComPtr<ID3D12Resource> PositionGPUBuffer = nullptr;
+  ComPtr<ID3D12Resource> PositionIndexGPUBuffer = nullptr;
+  ComPtr<ID3D12Resource> PositionBufferUploader = nullptr;
+  ComPtr<ID3D12Resource> PositionIndexBufferUploader = nullptr;
+
+  UINT PositionByteStride = 0;
+  UINT PositionBufferByteSize = 0;
+  DXGI_FORMAT PositionIndexFormat = DXGI_FORMAT_R16_UINT;
+  UINT PositionIndexBufferByteSize = 0;
+
+  std::unordered_map<std::string, SubmeshGeometry> PositionDrawArgs;
+
+  // Meshlets of each DrawArgs entry, used for CPU cluster culling.
+  std::unordered_map<std::string, std::vector<Meshlet>> Meshlets;
+
   D3D12_VERTEX_BUFFER_VIEW VertexBufferView() const;
   D3D12_INDEX_BUFFER_VIEW IndexBufferView() const;
+  D3D12_VERTEX_BUFFER_VIEW PositionBufferView() const;
+  D3D12_INDEX_BUFFER_VIEW PositionIndexBufferView() const;
+  bool HasPositionStream() const { return PositionGPUBuffer != nullptr; }
   void DisposeUploaders();
 };
 
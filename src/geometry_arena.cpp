@@ -0,0 +1,146 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "geometry_arena.h"
+
+using namespace DirectX;
+
+void GeometryArena::Add(const std::string &name,
+                        const GeometryGenerator::MeshData &mesh) {
+  Entry entry{.Name = name, .Kind = Shape::Mesh, .Mesh = &mesh};
+  entry.Size = {(uint32)mesh.Vertices.size(), (uint32)mesh.Indices32.size()};
+  if (!mesh.Vertices.empty()) {
+    auto positions = &mesh.Vertices[0].Position;
+    auto stride = sizeof(GeometryGenerator::Vertex);
+    XMFLOAT3 min, max;
+    MeshBounds::ComputeRange(positions, mesh.Vertices.size(), stride, min,
+                             max);
+    SetRange(entry.Submesh, min, max);
+
+    auto &sphere = entry.Submesh.SphereBounds;
+    sphere.Center = entry.Submesh.Bounds.Center;
+    sphere.Radius = MeshBounds::ComputeRadius(positions, mesh.Vertices.size(),
+                                              stride, sphere.Center);
+  }
+  Entries.push_back(std::move(entry));
+}
+
+void GeometryArena::AddGrid(const std::string &name, float width, float depth,
+                            uint32 m, uint32 n) {
+  AddShape({.Name = name,
+            .Kind = Shape::Grid,
+            .Dimensions = {width, depth},
+            .Divisions = {m, n},
+            .Size = GeometryGenerator::GridSize(m, n)},
+           {-0.5f * width, 0.0f, -0.5f * depth},
+           {0.5f * width, 0.0f, 0.5f * depth});
+}
+
+void GeometryArena::AddSphere(const std::string &name, float radius,
+                              uint32 sliceCount, uint32 stackCount) {
+  AddShape({.Name = name,
+            .Kind = Shape::Sphere,
+            .Dimensions = {radius},
+            .Divisions = {sliceCount, stackCount},
+            .Size = GeometryGenerator::SphereSize(sliceCount, stackCount)},
+           {-radius, -radius, -radius}, {radius, radius, radius});
+}
+
+void GeometryArena::AddCylinder(const std::string &name, float bottomRadius,
+                                float topRadius, float height,
+                                uint32 sliceCount, uint32 stackCount) {
+  auto radius = std::max<float>(bottomRadius, topRadius);
+  AddShape({.Name = name,
+            .Kind = Shape::Cylinder,
+            .Dimensions = {bottomRadius, topRadius, height},
+            .Divisions = {sliceCount, stackCount},
+            .Size = GeometryGenerator::CylinderSize(sliceCount, stackCount)},
+           {-radius, -0.5f * height, -radius},
+           {radius, 0.5f * height, radius});
+}
+
+void GeometryArena::AddShape(Entry entry, const XMFLOAT3 &min,
+                             const XMFLOAT3 &max) {
+  // Procedural vertices do not exist before Build, so the bounds and the
+  // quantization range come from the shape's analytic extent.
+  SetRange(entry.Submesh, min, max);
+  BoundingSphere::CreateFromBoundingBox(entry.Submesh.SphereBounds,
+                                        entry.Submesh.Bounds);
+  Entries.push_back(std::move(entry));
+}
+
+void GeometryArena::SetRange(SubmeshGeometry &submesh, const XMFLOAT3 &min,
+                             const XMFLOAT3 &max) {
+  BoundingBox::CreateFromPoints(submesh.Bounds, XMLoadFloat3(&min),
+                                XMLoadFloat3(&max));
+  submesh.Quantization.Min = min;
+  submesh.Quantization.Extent = {max.x - min.x, max.y - min.y, max.z - min.z};
+}
+
+std::unique_ptr<MeshGeometry>
+GeometryArena::Allocate(const std::string &name, UINT vertexByteStride) {
+  size_t vertexCount = 0;
+  size_t indexCount = 0;
+  size_t largestMesh = 0;
+  for (auto &entry : Entries) {
+    auto &submesh = entry.Submesh;
+    submesh.IndexCount = entry.Size.IndexCount;
+    submesh.StartIndexLocation = (UINT)indexCount;
+    submesh.BaseVertexLocation = (INT)vertexCount;
+
+    vertexCount += entry.Size.VertexCount;
+    indexCount += entry.Size.IndexCount;
+    largestMesh = std::max<size_t>(largestMesh, entry.Size.VertexCount);
+  }
+
+  // Indices are relative to BaseVertexLocation, so 16 bits are enough as long
+  // as every single mesh fits, whatever the total.
+  auto geo = std::make_unique<MeshGeometry>();
+  geo->Name = name;
+  geo->IndexFormat =
+      largestMesh <= 0xffff ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+  auto indexSize = geo->IndexFormat == DXGI_FORMAT_R16_UINT
+                       ? sizeof(std::uint16_t)
+                       : sizeof(std::uint32_t);
+
+  geo->VertexByteStride = vertexByteStride;
+  geo->VertexBufferByteSize = (UINT)(vertexCount * vertexByteStride);
+  geo->IndexBufferByteSize = (UINT)(indexCount * indexSize);
+
+  for (auto &entry : Entries) {
+    geo->DrawArgs[entry.Name] = entry.Submesh;
+  }
+  return geo;
+}
+
+std::vector<GeometryArena::Task> GeometryArena::SplitTasks() const {
+  std::vector<Task> tasks;
+  for (size_t e = 0; e < Entries.size(); e++) {
+    auto count = (size_t)Entries[e].Size.VertexCount;
+    if (Entries[e].Kind != Shape::Mesh) {
+      tasks.push_back({e, 0, count});
+      continue;
+    }
+    for (size_t begin = 0; begin < count; begin += VertexGrainSize) {
+      tasks.push_back(
+          {e, begin, std::min<size_t>(begin + VertexGrainSize, count)});
+    }
+  }
+  return tasks;
+}
+
+void GeometryArena::WriteIndices(const Entry &entry, void *indices,
+                                 bool is16Bit) const {
+  auto &source = entry.Mesh->Indices32;
+  auto start = entry.Submesh.StartIndexLocation;
+  if (is16Bit) {
+    auto out = static_cast<std::uint16_t *>(indices) + start;
+    for (size_t i = 0; i < source.size(); i++) {
+      out[i] = (std::uint16_t)source[i];
+    }
+  } else {
+    std::copy(source.begin(), source.end(),
+              static_cast<std::uint32_t *>(indices) + start);
+  }
+}
@@ -0,0 +1,170 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "dx_utils.h"
+#include "geometry_generator.h"
+#include "mapped_upload_buffer.h"
+#include "thread_pool.h"
+
+// Packs several meshes into one MeshGeometry.  Offsets, the index format and
+// the DrawArgs entries are worked out once, then vertices and indices are
+// written in parallel straight into a mapped upload buffer and copied to the
+// default heap buffers; nothing is staged on the CPU in between.
+//
+//   GeometryArena arena;
+//   arena.Add("box", box);
+//   arena.AddGrid("grid", 20.0f, 30.0f, 60, 40);
+//   auto geo = arena.Build<Vertex>("shapeGeo", device, commandList,
+//                                  [](Vertex &out, const auto &in,
+//                                     const SubmeshGeometry &submesh) {...});
+class GeometryArena {
+public:
+  using uint32 = GeometryGenerator::uint32;
+
+  // The mesh is referenced, not copied, and must outlive Build.
+  void Add(const std::string &name, const GeometryGenerator::MeshData &mesh);
+
+  // Procedural meshes, generated by Build directly into the upload buffer so
+  // they never exist as MeshData.
+  void AddGrid(const std::string &name, float width, float depth, uint32 m,
+               uint32 n);
+  void AddSphere(const std::string &name, float radius, uint32 sliceCount,
+                 uint32 stackCount);
+  void AddCylinder(const std::string &name, float bottomRadius,
+                   float topRadius, float height, uint32 sliceCount,
+                   uint32 stackCount);
+
+  // convert(V &out, const GeometryGenerator::Vertex &in,
+  //         const SubmeshGeometry &submesh) is called once per vertex, from
+  // several threads at once.  The returned geometry keeps the upload buffer
+  // alive until DisposeUploaders.
+  template <typename V, typename Convert>
+  std::unique_ptr<MeshGeometry>
+  Build(const std::string &name, ID3D12Device *device,
+        ID3D12GraphicsCommandList *commandList, Convert convert);
+
+private:
+  static constexpr size_t VertexGrainSize = 4096;
+
+  enum class Shape { Mesh, Grid, Sphere, Cylinder };
+
+  struct Entry {
+    std::string Name;
+    Shape Kind = Shape::Mesh;
+    const GeometryGenerator::MeshData *Mesh = nullptr;
+    // Shape parameters in the order the generator takes them.
+    float Dimensions[3] = {};
+    uint32 Divisions[2] = {};
+    GeometryGenerator::MeshSize Size;
+    SubmeshGeometry Submesh;
+  };
+
+  // A run of vertices converted, or a whole procedural mesh generated, by a
+  // single task.  Procedural meshes split their rows over the pool again.
+  struct Task {
+    size_t Entry;
+    size_t Begin;
+    size_t End;
+  };
+
+  void AddShape(Entry entry, const DirectX::XMFLOAT3 &min,
+                const DirectX::XMFLOAT3 &max);
+  // Sets the bounding box and quantization range of a submesh.
+  static void SetRange(SubmeshGeometry &submesh, const DirectX::XMFLOAT3 &min,
+                       const DirectX::XMFLOAT3 &max);
+
+  // Sizes the buffers, fills in the submeshes and picks the index format.
+  std::unique_ptr<MeshGeometry> Allocate(const std::string &name,
+                                         UINT vertexByteStride);
+  std::vector<Task> SplitTasks() const;
+  void WriteIndices(const Entry &entry, void *indices, bool is16Bit) const;
+  template <typename V, typename I, typename Convert>
+  void Generate(const Entry &entry, std::span<V> vertices, I *indices,
+                Convert &convert) const;
+
+  std::vector<Entry> Entries;
+};
+
+template <typename V, typename Convert>
+std::unique_ptr<MeshGeometry>
+GeometryArena::Build(const std::string &name, ID3D12Device *device,
+                     ID3D12GraphicsCommandList *commandList, Convert convert) {
+  auto geo = Allocate(name, sizeof(V));
+  auto is16Bit = geo->IndexFormat == DXGI_FORMAT_R16_UINT;
+
+  MappedUploadBuffer upload(device, geo->VertexBufferByteSize +
+                                        geo->IndexBufferByteSize + 16);
+  auto vertexAllocation = upload.Allocate(geo->VertexBufferByteSize);
+  auto indexAllocation = upload.Allocate(geo->IndexBufferByteSize);
+  auto vertices = vertexAllocation.As<V>();
+  auto indices = indexAllocation.Data;
+
+  auto tasks = SplitTasks();
+  ThreadPool::Shared().ParallelFor(tasks.size(), [&](size_t t) {
+    auto &task = tasks[t];
+    auto &entry = Entries[task.Entry];
+    auto out = vertices.subspan(entry.Submesh.BaseVertexLocation,
+                                entry.Size.VertexCount);
+
+    if (entry.Kind != Shape::Mesh) {
+      auto indexSize = is16Bit ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+      auto first = indices + entry.Submesh.StartIndexLocation * indexSize;
+      if (is16Bit) {
+        Generate(entry, out, reinterpret_cast<std::uint16_t *>(first),
+                 convert);
+      } else {
+        Generate(entry, out, reinterpret_cast<std::uint32_t *>(first),
+                 convert);
+      }
+      return;
+    }
+
+    // Meshes are split into vertex runs; the first run of each also copies
+    // the mesh's indices.
+    for (auto i = task.Begin; i < task.End; i++) {
+      convert(out[i], entry.Mesh->Vertices[i], entry.Submesh);
+    }
+    if (task.Begin == 0) {
+      WriteIndices(entry, indices, is16Bit);
+    }
+  });
+
+  geo->VertexGPUBuffer =
+      upload.CreateDefaultBuffer(device, commandList, vertexAllocation);
+  geo->IndexGPUBuffer =
+      upload.CreateDefaultBuffer(device, commandList, indexAllocation);
+  geo->VertexBufferUploader = upload.Resource();
+  geo->IndexBufferUploader = upload.Resource();
+  return geo;
+}
+
+template <typename V, typename I, typename Convert>
+void GeometryArena::Generate(const Entry &entry, std::span<V> vertices,
+                             I *indices, Convert &convert) const {
+  auto store = [&](V &out, const GeometryGenerator::Vertex &in) {
+    convert(out, in, entry.Submesh);
+  };
+  std::span<I> out(indices, entry.Size.IndexCount);
+  auto &d = entry.Dimensions;
+  auto &n = entry.Divisions;
+
+  GeometryGenerator geoGen;
+  auto pool = &ThreadPool::Shared();
+  switch (entry.Kind) {
+  case Shape::Grid:
+    geoGen.CreateGrid(d[0], d[1], n[0], n[1], vertices, out, store, pool);
+    break;
+  case Shape::Sphere:
+    geoGen.CreateSphere(d[0], n[0], n[1], vertices, out, store, pool);
+    break;
+  case Shape::Cylinder:
+    geoGen.CreateCylinder(d[0], d[1], d[2], n[0], n[1], vertices, out, store,
+                          pool);
+    break;
+  case Shape::Mesh:
+    break;
+  }
+}
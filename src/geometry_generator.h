@@ -14,9 +14,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cstdint>
 #include <DirectXMath.h>
+#include <span>
 #include <vector>
+#include "thread_pool.h"
 
 class GeometryGenerator
 {
@@ -110,10 +114,436 @@ public:
 	///</summary>
     MeshData CreateQuad(float x, float y, float w, float h, float depth);
 
+	///<summary>
+	/// Parallel versions of the above.  Rows, stack rings or vertices are split
+	/// across the pool and written at closed-form offsets into preallocated
+	/// buffers, so the output is bit-identical to the serial versions.
+	///</summary>
+    MeshData CreateSphere(float radius, uint32 sliceCount, uint32 stackCount, ThreadPool& pool);
+    MeshData CreateGeosphere(float radius, uint32 numSubdivisions, ThreadPool& pool);
+    MeshData CreateCylinder(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount, ThreadPool& pool);
+    MeshData CreateGrid(float width, float depth, uint32 m, uint32 n, ThreadPool& pool);
+
+	struct MeshSize
+	{
+		uint32 VertexCount = 0;
+		uint32 IndexCount = 0;
+	};
+
+	///<summary>
+	/// Vertex and index counts of a grid, sphere or cylinder, so callers can
+	/// size their storage before generating into it.
+	///</summary>
+	static MeshSize GridSize(uint32 m, uint32 n);
+	static MeshSize SphereSize(uint32 sliceCount, uint32 stackCount);
+	static MeshSize CylinderSize(uint32 sliceCount, uint32 stackCount);
+
+	// Stores a generated vertex unchanged.
+	struct CopyVertex
+	{
+		void operator()(Vertex& out, const Vertex& in) const { out = in; }
+	};
+
+	///<summary>
+	/// The same meshes written straight into caller-provided storage, such as
+	/// a mapped upload buffer, instead of a MeshData.  The spans must hold the
+	/// counts given by the matching *Size function.  convert(V&, const Vertex&)
+	/// stores each vertex in the caller's format; indices are narrowed to I.
+	/// With a pool the rows are generated in parallel and convert is called
+	/// from several threads at once.
+	///</summary>
+	template<typename V, typename I, typename Convert = CopyVertex>
+	void CreateGrid(float width, float depth, uint32 m, uint32 n,
+		std::span<V> vertices, std::span<I> indices, Convert convert = {}, ThreadPool* pool = nullptr);
+
+	template<typename V, typename I, typename Convert = CopyVertex>
+	void CreateSphere(float radius, uint32 sliceCount, uint32 stackCount,
+		std::span<V> vertices, std::span<I> indices, Convert convert = {}, ThreadPool* pool = nullptr);
+
+	template<typename V, typename I, typename Convert = CopyVertex>
+	void CreateCylinder(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount,
+		std::span<V> vertices, std::span<I> indices, Convert convert = {}, ThreadPool* pool = nullptr);
+
 private:
-	void Subdivide(MeshData& meshData);
+	// Roughly how many vertices one parallel task generates.
+	static constexpr uint32 ParallelGrainSize = 4096;
+
+	// Calls body(begin, end) over [0, count): in chunks of grainSize on the
+	// pool, or all at once on this thread when there is no pool.
+	template<typename Body>
+	static void ForRange(ThreadPool* pool, uint32 count, uint32 grainSize, const Body& body);
+
+	MeshData BuildGeosphere(float radius, uint32 numSubdivisions, ThreadPool* pool);
+	void Subdivide(MeshData& meshData, ThreadPool* pool = nullptr);
+	uint32 FindEdge(uint32 a, uint32 b) const;
     Vertex MidPoint(const Vertex& v0, const Vertex& v1);
-    void BuildCylinderTopCap(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount, MeshData& meshData);
-    void BuildCylinderBottomCap(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount, MeshData& meshData);
+
+	// Writes a cylinder cap ring, its center and its triangles starting at
+	// baseVertex/baseIndex.  The top cap faces +y, the bottom one -y.
+	template<typename V, typename I, typename Convert>
+	static void WriteCylinderCap(float radius, float y, float height, uint32 sliceCount, bool top,
+		uint32 baseVertex, uint32 baseIndex, std::span<V> vertices, std::span<I> indices, Convert& convert);
+
+	// Open-addressed edge -> midpoint table used by Subdivide.  Kept as members
+	// so the buckets are reused from one subdivision level to the next.
+	std::vector<std::uint64_t> mEdgeKeys;
+	std::vector<uint32> mEdgeMidpoints;
+	// Input triangles of a parallel Subdivide, which cannot rewrite in place.
+	std::vector<uint32> mSubdivideIndices;
 };
 
+template<typename Body>
+void GeometryGenerator::ForRange(ThreadPool* pool, uint32 count, uint32 grainSize, const Body& body)
+{
+	if(pool == nullptr || count <= grainSize)
+	{
+		body(0u, count);
+		return;
+	}
+
+	pool->ParallelForRange(count, grainSize, [&](std::size_t begin, std::size_t end)
+	{
+		body((uint32)begin, (uint32)end);
+	});
+}
+
+template<typename V, typename I, typename Convert>
+void GeometryGenerator::CreateGrid(float width, float depth, uint32 m, uint32 n,
+	std::span<V> vertices, std::span<I> indices, Convert convert, ThreadPool* pool)
+{
+	assert(vertices.size() == GridSize(m, n).VertexCount);
+	assert(indices.size() == GridSize(m, n).IndexCount);
+
+	//
+	// Create the vertices.
+	//
+
+	float halfWidth = 0.5f*width;
+	float halfDepth = 0.5f*depth;
+
+	float dx = width / (n-1);
+	float dz = depth / (m-1);
+
+	float du = 1.0f / (n-1);
+	float dv = 1.0f / (m-1);
+
+	// Row i writes its vertices and the quads joining it to row i+1, both at
+	// offsets that follow from i alone, so rows can be generated in any order.
+	auto createRows = [&](uint32 begin, uint32 end)
+	{
+		for(uint32 i = begin; i < end; ++i)
+		{
+			float z = halfDepth - i*dz;
+			for(uint32 j = 0; j < n; ++j)
+			{
+				float x = -halfWidth + j*dx;
+
+				// Stretch texture over grid.
+				Vertex v(x, 0.0f, z, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f, 0.0f, j*du, i*dv);
+				convert(vertices[i*n+j], v);
+			}
+
+			//
+			// Create the indices.
+			//
+
+			if(i == m-1)
+				continue;
+
+			// Iterate over each quad and compute indices.
+			uint32 k = i*(n-1)*6;
+			for(uint32 j = 0; j < n-1; ++j)
+			{
+				indices[k]   = static_cast<I>(i*n+j);
+				indices[k+1] = static_cast<I>(i*n+j+1);
+				indices[k+2] = static_cast<I>((i+1)*n+j);
+
+				indices[k+3] = static_cast<I>((i+1)*n+j);
+				indices[k+4] = static_cast<I>(i*n+j+1);
+				indices[k+5] = static_cast<I>((i+1)*n+j+1);
+
+				k += 6; // next quad
+			}
+		}
+	};
+	ForRange(pool, m, std::max<uint32>(ParallelGrainSize/n, 1u), createRows);
+}
+
+template<typename V, typename I, typename Convert>
+void GeometryGenerator::CreateSphere(float radius, uint32 sliceCount, uint32 stackCount,
+	std::span<V> vertices, std::span<I> indices, Convert convert, ThreadPool* pool)
+{
+	using namespace DirectX;
+
+	assert(vertices.size() == SphereSize(sliceCount, stackCount).VertexCount);
+	assert(indices.size() == SphereSize(sliceCount, stackCount).IndexCount);
+
+	//
+	// Compute the vertices stating at the top pole and moving down the stacks.
+	//
+
+	// Poles: note that there will be texture coordinate distortion as there is
+	// not a unique point on the texture map to assign to the pole when mapping
+	// a rectangular texture onto a sphere.
+	Vertex topVertex(0.0f, +radius, 0.0f, 0.0f, +1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+	Vertex bottomVertex(0.0f, -radius, 0.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+	convert(vertices[0], topVertex);
+
+	float phiStep   = XM_PI/stackCount;
+	float thetaStep = 2.0f*XM_PI/sliceCount;
+
+	// Offset the indices to the index of the first vertex in the first ring.
+	// This is just skipping the top pole vertex.
+	uint32 baseIndex = 1;
+	uint32 ringVertexCount = sliceCount + 1;
+
+	// The top stack fan comes first in the index buffer.
+	uint32 topStackIndexCount = 3*sliceCount;
+
+	// Compute vertices for each stack ring (do not count the poles as rings).
+	// Ring r also writes the inner stack joining it to ring r+1.
+	auto createRings = [&](uint32 begin, uint32 end)
+	{
+		for(uint32 r = begin; r < end; ++r)
+		{
+			uint32 i = r + 1;
+			float phi = i*phiStep;
+
+			// Vertices of ring.
+			uint32 vertex = baseIndex + r*ringVertexCount;
+			for(uint32 j = 0; j <= sliceCount; ++j)
+			{
+				float theta = j*thetaStep;
+
+				Vertex v;
+
+				// spherical to cartesian
+				v.Position.x = radius*sinf(phi)*cosf(theta);
+				v.Position.y = radius*cosf(phi);
+				v.Position.z = radius*sinf(phi)*sinf(theta);
+
+				// Partial derivative of P with respect to theta
+				v.TangentU.x = -radius*sinf(phi)*sinf(theta);
+				v.TangentU.y = 0.0f;
+				v.TangentU.z = +radius*sinf(phi)*cosf(theta);
+
+				XMVECTOR T = XMLoadFloat3(&v.TangentU);
+				XMStoreFloat3(&v.TangentU, XMVector3Normalize(T));
+
+				XMVECTOR p = XMLoadFloat3(&v.Position);
+				XMStoreFloat3(&v.Normal, XMVector3Normalize(p));
+
+				v.TexC.x = theta / XM_2PI;
+				v.TexC.y = phi / XM_PI;
+
+				convert(vertices[vertex++], v);
+			}
+
+			//
+			// Compute indices for inner stacks (not connected to poles).
+			//
+
+			if(r == stackCount-2)
+				continue;
+
+			uint32 k = topStackIndexCount + r*sliceCount*6;
+			for(uint32 j = 0; j < sliceCount; ++j)
+			{
+				indices[k++] = static_cast<I>(baseIndex + r*ringVertexCount + j);
+				indices[k++] = static_cast<I>(baseIndex + r*ringVertexCount + j+1);
+				indices[k++] = static_cast<I>(baseIndex + (r+1)*ringVertexCount + j);
+
+				indices[k++] = static_cast<I>(baseIndex + (r+1)*ringVertexCount + j);
+				indices[k++] = static_cast<I>(baseIndex + r*ringVertexCount + j+1);
+				indices[k++] = static_cast<I>(baseIndex + (r+1)*ringVertexCount + j+1);
+			}
+		}
+	};
+	ForRange(pool, stackCount-1, std::max<uint32>(ParallelGrainSize/ringVertexCount, 1u), createRings);
+
+	// South pole vertex was added last.
+	uint32 southPoleIndex = (uint32)vertices.size() - 1;
+	convert(vertices[southPoleIndex], bottomVertex);
+
+	//
+	// Compute indices for top stack.  The top stack was written first to the vertex buffer
+	// and connects the top pole to the first ring.
+	//
+
+	uint32 k = 0;
+	for(uint32 i = 1; i <= sliceCount; ++i)
+	{
+		indices[k++] = static_cast<I>(0);
+		indices[k++] = static_cast<I>(i+1);
+		indices[k++] = static_cast<I>(i);
+	}
+
+	//
+	// Compute indices for bottom stack.  The bottom stack was written last to the vertex buffer
+	// and connects the bottom pole to the bottom ring.
+	//
+
+	// Skip the inner stacks.
+	k = (uint32)indices.size() - 3*sliceCount;
+
+	// Offset the indices to the index of the first vertex in the last ring.
+	baseIndex = southPoleIndex - ringVertexCount;
+
+	for(uint32 i = 0; i < sliceCount; ++i)
+	{
+		indices[k++] = static_cast<I>(southPoleIndex);
+		indices[k++] = static_cast<I>(baseIndex+i);
+		indices[k++] = static_cast<I>(baseIndex+i+1);
+	}
+}
+
+template<typename V, typename I, typename Convert>
+void GeometryGenerator::CreateCylinder(float bottomRadius, float topRadius, float height, uint32 sliceCount, uint32 stackCount,
+	std::span<V> vertices, std::span<I> indices, Convert convert, ThreadPool* pool)
+{
+	using namespace DirectX;
+
+	assert(vertices.size() == CylinderSize(sliceCount, stackCount).VertexCount);
+	assert(indices.size() == CylinderSize(sliceCount, stackCount).IndexCount);
+
+	//
+	// Build Stacks.
+	//
+
+	float stackHeight = height / stackCount;
+
+	// Amount to increment radius as we move up each stack level from bottom to top.
+	float radiusStep = (topRadius - bottomRadius) / stackCount;
+
+	uint32 ringCount = stackCount+1;
+
+	// Add one because we duplicate the first and last vertex per ring
+	// since the texture coordinates are different.
+	uint32 ringVertexCount = sliceCount+1;
+
+	float dTheta = 2.0f*XM_PI/sliceCount;
+
+	// Compute vertices for each stack ring starting at the bottom and moving up.
+	// Ring i also writes the indices of the stack joining it to ring i+1.
+	auto createRings = [&](uint32 begin, uint32 end)
+	{
+		for(uint32 i = begin; i < end; ++i)
+		{
+			float y = -0.5f*height + i*stackHeight;
+			float r = bottomRadius + i*radiusStep;
+
+			// vertices of ring
+			uint32 vertex = i*ringVertexCount;
+			for(uint32 j = 0; j <= sliceCount; ++j)
+			{
+				Vertex v;
+
+				// The last vertex closes the ring on the first, bit for bit,
+				// so the seam leaves no crack.
+				float c = cosf((j % sliceCount)*dTheta);
+				float s = sinf((j % sliceCount)*dTheta);
+
+				v.Position = XMFLOAT3(r*c, y, r*s);
+
+				v.TexC.x = (float)j/sliceCount;
+				v.TexC.y = 1.0f - (float)i/stackCount;
+
+				// Cylinder can be parameterized as follows, where we introduce v
+				// parameter that goes in the same direction as the v tex-coord
+				// so that the bitangent goes in the same direction as the v tex-coord.
+				//   Let r0 be the bottom radius and let r1 be the top radius.
+				//   y(v) = h - hv for v in [0,1].
+				//   r(v) = r1 + (r0-r1)v
+				//
+				//   x(t, v) = r(v)*cos(t)
+				//   y(t, v) = h - hv
+				//   z(t, v) = r(v)*sin(t)
+				//
+				//  dx/dt = -r(v)*sin(t)
+				//  dy/dt = 0
+				//  dz/dt = +r(v)*cos(t)
+				//
+				//  dx/dv = (r0-r1)*cos(t)
+				//  dy/dv = -h
+				//  dz/dv = (r0-r1)*sin(t)
+
+				// This is unit length.
+				v.TangentU = XMFLOAT3(-s, 0.0f, c);
+
+				float dr = bottomRadius-topRadius;
+				XMFLOAT3 bitangent(dr*c, -height, dr*s);
+
+				XMVECTOR T = XMLoadFloat3(&v.TangentU);
+				XMVECTOR B = XMLoadFloat3(&bitangent);
+				XMVECTOR N = XMVector3Normalize(XMVector3Cross(T, B));
+				XMStoreFloat3(&v.Normal, N);
+
+				convert(vertices[vertex++], v);
+			}
+
+			// Compute indices for each stack.
+			if(i == stackCount)
+				continue;
+
+			uint32 k = i*sliceCount*6;
+			for(uint32 j = 0; j < sliceCount; ++j)
+			{
+				indices[k++] = static_cast<I>(i*ringVertexCount + j);
+				indices[k++] = static_cast<I>((i+1)*ringVertexCount + j);
+				indices[k++] = static_cast<I>((i+1)*ringVertexCount + j+1);
+
+				indices[k++] = static_cast<I>(i*ringVertexCount + j);
+				indices[k++] = static_cast<I>((i+1)*ringVertexCount + j+1);
+				indices[k++] = static_cast<I>(i*ringVertexCount + j+1);
+			}
+		}
+	};
+	ForRange(pool, ringCount, std::max<uint32>(ParallelGrainSize/ringVertexCount, 1u), createRings);
+
+	uint32 vertex = ringCount*ringVertexCount;
+	uint32 k = stackCount*sliceCount*6;
+
+	// Each cap adds a duplicated ring plus its center vertex.
+	uint32 capVertexCount = sliceCount + 2;
+	uint32 capIndexCount = 3*sliceCount;
+	WriteCylinderCap(topRadius, 0.5f*height, height, sliceCount, true,
+		vertex, k, vertices, indices, convert);
+	WriteCylinderCap(bottomRadius, -0.5f*height, height, sliceCount, false,
+		vertex + capVertexCount, k + capIndexCount, vertices, indices, convert);
+}
+
+template<typename V, typename I, typename Convert>
+void GeometryGenerator::WriteCylinderCap(float radius, float y, float height, uint32 sliceCount, bool top,
+	uint32 baseVertex, uint32 baseIndex, std::span<V> vertices, std::span<I> indices, Convert& convert)
+{
+	float ny = top ? 1.0f : -1.0f;
+	float dTheta = 2.0f*DirectX::XM_PI/sliceCount;
+
+	// Duplicate cap ring vertices because the texture coordinates and normals differ.
+	for(uint32 i = 0; i <= sliceCount; ++i)
+	{
+		float x = radius*cosf((i % sliceCount)*dTheta);
+		float z = radius*sinf((i % sliceCount)*dTheta);
+
+		// Scale down by the height to try and make top cap texture coord area
+		// proportional to base.
+		float u = x/height + 0.5f;
+		float v = z/height + 0.5f;
+
+		convert(vertices[baseVertex + i], Vertex(x, y, z, 0.0f, ny, 0.0f, 1.0f, 0.0f, 0.0f, u, v));
+	}
+
+	// Cap center vertex.
+	uint32 centerIndex = baseVertex + sliceCount + 1;
+	convert(vertices[centerIndex], Vertex(0.0f, y, 0.0f, 0.0f, ny, 0.0f, 1.0f, 0.0f, 0.0f, 0.5f, 0.5f));
+
+	// The caps wind in opposite directions so both face outward.
+	uint32 k = baseIndex;
+	for(uint32 i = 0; i < sliceCount; ++i)
+	{
+		indices[k++] = static_cast<I>(centerIndex);
+		indices[k++] = static_cast<I>(top ? baseVertex + i+1 : baseVertex + i);
+		indices[k++] = static_cast<I>(top ? baseVertex + i : baseVertex + i+1);
+	}
+}
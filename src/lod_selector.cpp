@@ -0,0 +1,84 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "lod_selector.h"
+#include <DirectXMath.h>
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+// Halves the counts until they reach their minimum, stopping early once a
+// level would repeat the previous one.
+template <typename Error>
+std::vector<LodSelector::TessellationLevel>
+BuildLadder(LodSelector::uint32 sliceCount, LodSelector::uint32 stackCount,
+            LodSelector::uint32 minSliceCount,
+            LodSelector::uint32 minStackCount, LodSelector::uint32 levelCount,
+            Error error) {
+  std::vector<LodSelector::TessellationLevel> levels;
+  for (LodSelector::uint32 i = 0; i < levelCount; i++) {
+    if (!levels.empty() && levels.back().SliceCount == sliceCount &&
+        levels.back().StackCount == stackCount) {
+      break;
+    }
+    levels.push_back({sliceCount, stackCount, error(sliceCount, stackCount)});
+    sliceCount = std::max<LodSelector::uint32>(sliceCount / 2, minSliceCount);
+    stackCount = std::max<LodSelector::uint32>(stackCount / 2, minStackCount);
+  }
+  return levels;
+}
+} // namespace
+
+std::vector<LodSelector::TessellationLevel>
+LodSelector::SphereLadder(float radius, uint32 sliceCount, uint32 stackCount,
+                          uint32 levelCount) {
+  // The center of a facet spanning dTheta by dPhi sits
+  // radius * (1 - cos(dTheta / 2) * cos(dPhi / 2)) below the sphere.
+  return BuildLadder(sliceCount, stackCount, 3, 2, levelCount,
+                     [&](uint32 slices, uint32 stacks) {
+                       return radius * (1.0f - std::cos(XM_PI / slices) *
+                                                   std::cos(0.5f * XM_PI /
+                                                            stacks));
+                     });
+}
+
+std::vector<LodSelector::TessellationLevel>
+LodSelector::CylinderLadder(float bottomRadius, float topRadius,
+                            uint32 sliceCount, uint32 stackCount,
+                            uint32 levelCount) {
+  // The sides are straight along the axis, so only the slices add error.
+  auto radius = std::max<float>(bottomRadius, topRadius);
+  return BuildLadder(sliceCount, stackCount, 3, 1, levelCount,
+                     [&](uint32 slices, uint32 /*stacks*/) {
+                       return radius * (1.0f - std::cos(XM_PI / slices));
+                     });
+}
+
+LodSelector::LodSelector(std::vector<float> errors)
+    : Errors(std::move(errors)) {}
+
+size_t LodSelector::Update(float pixelsPerUnit, float maxPixelError,
+                           float hysteresis) {
+  if (Errors.empty()) {
+    return 0;
+  }
+  auto fits = [&](size_t level, float threshold) {
+    return Errors[level] * pixelsPerUnit <= threshold;
+  };
+
+  if (!fits(Current, maxPixelError)) {
+    while (Current > 0 && !fits(Current, maxPixelError)) {
+      Current--;
+    }
+    return Current;
+  }
+
+  auto coarsenThreshold = maxPixelError * (1.0f - hysteresis);
+  while (Current + 1 < Errors.size() && fits(Current + 1, coarsenThreshold)) {
+    Current++;
+  }
+  return Current;
+}
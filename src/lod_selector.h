@@ -0,0 +1,52 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Picks a level of a LOD chain from its projected screen-space error and
+// remembers it between frames.  A finer level is taken as soon as the
+// current one is visibly too coarse, but a coarser one only once its error
+// is comfortably below the threshold, so an object sitting right at a switch
+// distance does not flicker between two levels.
+class LodSelector {
+public:
+  using uint32 = std::uint32_t;
+
+  // One step of a procedural tessellation ladder and its geometric error:
+  // the largest distance between the tessellated and the true surface.
+  struct TessellationLevel {
+    uint32 SliceCount;
+    uint32 StackCount;
+    float Error;
+  };
+
+  // Up to levelCount tessellations of a sphere or cylinder, starting at the
+  // given counts and halving them at every level.
+  static std::vector<TessellationLevel>
+  SphereLadder(float radius, uint32 sliceCount, uint32 stackCount,
+               uint32 levelCount);
+  static std::vector<TessellationLevel>
+  CylinderLadder(float bottomRadius, float topRadius, uint32 sliceCount,
+                 uint32 stackCount, uint32 levelCount);
+
+  LodSelector() = default;
+  // Errors of the levels in mesh units, finest first and never decreasing.
+  explicit LodSelector(std::vector<float> errors);
+
+  bool Empty() const { return Errors.empty(); }
+  size_t Level() const { return Current; }
+
+  // pixelsPerUnit is the size on screen of one mesh unit at the object's
+  // distance.  Coarsens only while the next level stays below
+  // (1 - hysteresis) * maxPixelError.  Returns the selected level.
+  size_t Update(float pixelsPerUnit, float maxPixelError, float hysteresis);
+
+private:
+  std::vector<float> Errors;
+  size_t Current = 0;
+};
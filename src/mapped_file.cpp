@@ -0,0 +1,76 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mapped_file.h"
+#include "stdafx.h"
+#include <utility>
+
+MappedFile::MappedFile(MappedFile &&rhs) noexcept { *this = std::move(rhs); }
+
+MappedFile &MappedFile::operator=(MappedFile &&rhs) noexcept {
+  if (this != &rhs) {
+    Close();
+    FileHandle = std::exchange(rhs.FileHandle, nullptr);
+    MappingHandle = std::exchange(rhs.MappingHandle, nullptr);
+    View = std::exchange(rhs.View, nullptr);
+    ByteSize = std::exchange(rhs.ByteSize, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { Close(); }
+
+bool MappedFile::Open(const std::string &path) {
+  Close();
+
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  FileHandle = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    Close();
+    return false;
+  }
+  ByteSize = (size_t)size.QuadPart;
+
+  // Empty files cannot be mapped; they simply have no data.
+  if (ByteSize == 0) {
+    return true;
+  }
+
+  MappingHandle =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (MappingHandle == nullptr) {
+    Close();
+    return false;
+  }
+  View = static_cast<const std::byte *>(
+      MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0));
+  if (View == nullptr) {
+    Close();
+    return false;
+  }
+  return true;
+}
+
+void MappedFile::Close() {
+  if (View != nullptr) {
+    UnmapViewOfFile(View);
+  }
+  if (MappingHandle != nullptr) {
+    CloseHandle(MappingHandle);
+  }
+  if (FileHandle != nullptr) {
+    CloseHandle(FileHandle);
+  }
+  FileHandle = MappingHandle = nullptr;
+  View = nullptr;
+  ByteSize = 0;
+}
@@ -0,0 +1,37 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <string>
+
+// Read-only memory mapping of a whole file.  Pages are read in by the OS as
+// they are touched, so opening even a large file costs next to nothing.
+class MappedFile {
+public:
+  MappedFile() = default;
+  MappedFile(const MappedFile &rhs) = delete;
+  MappedFile &operator=(const MappedFile &rhs) = delete;
+  MappedFile(MappedFile &&rhs) noexcept;
+  MappedFile &operator=(MappedFile &&rhs) noexcept;
+  ~MappedFile();
+
+  // Maps path, closing any previous file first.  Returns false when the
+  // file cannot be opened.  An empty file opens with no data.
+  bool Open(const std::string &path);
+  void Close();
+
+  bool IsOpen() const { return FileHandle != nullptr; }
+  const std::byte *Data() const { return View; }
+  size_t Size() const { return ByteSize; }
+  std::span<const std::byte> Bytes() const { return {View, ByteSize}; }
+
+private:
+  void *FileHandle = nullptr;
+  void *MappingHandle = nullptr;
+  const std::byte *View = nullptr;
+  size_t ByteSize = 0;
+};
@@ -0,0 +1,65 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mapped_upload_buffer.h"
+#include <stdexcept>
+
+MappedUploadBuffer::MappedUploadBuffer(ID3D12Device *device, UINT64 byteSize)
+    : byteSize(byteSize) {
+  auto heapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
+  auto resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(byteSize);
+  ThrowIfFailed(device->CreateCommittedResource(
+      &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+      D3D12_RESOURCE_STATE_GENERIC_READ, nullptr, IID_PPV_ARGS(&uploadBuffer)));
+
+  // Upload heaps are write-combined: the CPU only ever writes here, never
+  // reads back.
+  CD3DX12_RANGE readRange(0, 0);
+  ThrowIfFailed(uploadBuffer->Map(0, &readRange,
+                                  reinterpret_cast<void **>(&mappedData)));
+}
+
+MappedUploadBuffer::~MappedUploadBuffer() {
+  if (uploadBuffer != nullptr) {
+    uploadBuffer->Unmap(0, nullptr);
+  }
+  mappedData = nullptr;
+}
+
+ID3D12Resource *MappedUploadBuffer::Resource() { return uploadBuffer.Get(); }
+
+MappedUploadBuffer::Allocation MappedUploadBuffer::Allocate(UINT64 size,
+                                                            UINT64 alignment) {
+  auto offset = (usedByteSize + alignment - 1) / alignment * alignment;
+  if (offset + size > byteSize) {
+    throw std::runtime_error("MappedUploadBuffer: out of space");
+  }
+
+  usedByteSize = offset + size;
+  return {.Data = mappedData + offset, .Offset = offset, .ByteSize = size};
+}
+
+ComPtr<ID3D12Resource>
+MappedUploadBuffer::CreateDefaultBuffer(ID3D12Device *device,
+                                        ID3D12GraphicsCommandList *commandList,
+                                        const Allocation &allocation) {
+  ComPtr<ID3D12Resource> defaultBuffer;
+
+  auto heapProperties = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT);
+  auto resourceDesc = CD3DX12_RESOURCE_DESC::Buffer(allocation.ByteSize);
+  ThrowIfFailed(device->CreateCommittedResource(
+      &heapProperties, D3D12_HEAP_FLAG_NONE, &resourceDesc,
+      D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+      IID_PPV_ARGS(defaultBuffer.GetAddressOf())));
+
+  commandList->CopyBufferRegion(defaultBuffer.Get(), 0, uploadBuffer.Get(),
+                                allocation.Offset, allocation.ByteSize);
+
+  auto barrier = CD3DX12_RESOURCE_BARRIER::Transition(
+      defaultBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST,
+      D3D12_RESOURCE_STATE_GENERIC_READ);
+  commandList->ResourceBarrier(1, &barrier);
+
+  return defaultBuffer;
+}
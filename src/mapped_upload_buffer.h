@@ -0,0 +1,48 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "stdafx.h"
+#include <span>
+
+// Upload heap buffer that stays mapped for its whole life and hands out
+// suballocations, so geometry can be written straight into the memory the GPU
+// copies from instead of being staged in CPU side vectors first.
+class MappedUploadBuffer {
+public:
+  struct Allocation {
+    BYTE *Data = nullptr;
+    UINT64 Offset = 0;
+    UINT64 ByteSize = 0;
+
+    template <typename T> std::span<T> As() const {
+      return {reinterpret_cast<T *>(Data), (size_t)(ByteSize / sizeof(T))};
+    }
+  };
+
+  MappedUploadBuffer(ID3D12Device *device, UINT64 byteSize);
+  ~MappedUploadBuffer();
+  MappedUploadBuffer(const MappedUploadBuffer &) = delete;
+  MappedUploadBuffer &operator=(const MappedUploadBuffer &) = delete;
+
+  ID3D12Resource *Resource();
+
+  // Throws std::runtime_error when the buffer has no room left.
+  Allocation Allocate(UINT64 byteSize, UINT64 alignment = 16);
+
+  // Creates a default heap buffer and records the copy of allocation into it,
+  // leaving it in GENERIC_READ.  The upload buffer must stay alive until the
+  // command list has executed.
+  ComPtr<ID3D12Resource>
+  CreateDefaultBuffer(ID3D12Device *device,
+                      ID3D12GraphicsCommandList *commandList,
+                      const Allocation &allocation);
+
+private:
+  ComPtr<ID3D12Resource> uploadBuffer;
+  BYTE *mappedData = nullptr;
+  UINT64 byteSize = 0;
+  UINT64 usedByteSize = 0;
+};
@@ -0,0 +1,225 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_bounds.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace {
+// Independent accumulators per loop; enough to hide the min/max latency.
+constexpr size_t Lanes = 4;
+
+float HorizontalMin(FXMVECTOR v) {
+  XMFLOAT4 f;
+  XMStoreFloat4(&f, v);
+  return std::min<float>(std::min<float>(f.x, f.y), std::min<float>(f.z, f.w));
+}
+
+float HorizontalMax(FXMVECTOR v) {
+  XMFLOAT4 f;
+  XMStoreFloat4(&f, v);
+  return std::max<float>(std::max<float>(f.x, f.y), std::max<float>(f.z, f.w));
+}
+
+BoundingBox BoxFromRange(const XMFLOAT3 &min, const XMFLOAT3 &max) {
+  BoundingBox box;
+  BoundingBox::CreateFromPoints(box, XMLoadFloat3(&min), XMLoadFloat3(&max));
+  return box;
+}
+} // namespace
+
+void MeshBounds::ComputeRange(const XMFLOAT3 *positions, size_t count,
+                              size_t positionStride, XMFLOAT3 &min,
+                              XMFLOAT3 &max) {
+  if (count == 0) {
+    min = max = {0.0f, 0.0f, 0.0f};
+    return;
+  }
+
+  auto bytes = reinterpret_cast<const std::uint8_t *>(positions);
+  auto load = [&](size_t i) {
+    return XMLoadFloat3(
+        reinterpret_cast<const XMFLOAT3 *>(bytes + i * positionStride));
+  };
+
+  XMVECTOR vMin[Lanes], vMax[Lanes];
+  for (size_t k = 0; k < Lanes; k++) {
+    vMin[k] = vMax[k] = load(0);
+  }
+
+  size_t i = 0;
+  for (; i + Lanes <= count; i += Lanes) {
+    for (size_t k = 0; k < Lanes; k++) {
+      XMVECTOR p = load(i + k);
+      vMin[k] = XMVectorMin(vMin[k], p);
+      vMax[k] = XMVectorMax(vMax[k], p);
+    }
+  }
+  for (; i < count; i++) {
+    XMVECTOR p = load(i);
+    vMin[0] = XMVectorMin(vMin[0], p);
+    vMax[0] = XMVectorMax(vMax[0], p);
+  }
+
+  for (size_t k = 1; k < Lanes; k++) {
+    vMin[0] = XMVectorMin(vMin[0], vMin[k]);
+    vMax[0] = XMVectorMax(vMax[0], vMax[k]);
+  }
+  XMStoreFloat3(&min, vMin[0]);
+  XMStoreFloat3(&max, vMax[0]);
+}
+
+float MeshBounds::ComputeRadius(const XMFLOAT3 *positions, size_t count,
+                               size_t positionStride, const XMFLOAT3 &center) {
+  auto bytes = reinterpret_cast<const std::uint8_t *>(positions);
+  XMVECTOR c = XMLoadFloat3(&center);
+  XMVECTOR distance[Lanes];
+  for (size_t k = 0; k < Lanes; k++) {
+    distance[k] = XMVectorZero();
+  }
+
+  // Track the largest squared distance and take one square root at the end.
+  for (size_t i = 0; i < count; i++) {
+    XMVECTOR p = XMLoadFloat3(
+        reinterpret_cast<const XMFLOAT3 *>(bytes + i * positionStride));
+    auto &d = distance[i % Lanes];
+    d = XMVectorMax(d, XMVector3LengthSq(p - c));
+  }
+  for (size_t k = 1; k < Lanes; k++) {
+    distance[0] = XMVectorMax(distance[0], distance[k]);
+  }
+  return std::sqrt(XMVectorGetX(distance[0]));
+}
+
+void MeshBounds::Compute(const XMFLOAT3 *positions, size_t count,
+                         size_t positionStride, BoundingBox &box,
+                         BoundingSphere &sphere) {
+  XMFLOAT3 min, max;
+  ComputeRange(positions, count, positionStride, min, max);
+  box = BoxFromRange(min, max);
+
+  sphere.Center = box.Center;
+  sphere.Radius =
+      ComputeRadius(positions, count, positionStride, box.Center);
+}
+
+void MeshBounds::Compute(const float *x, const float *y, const float *z,
+                         size_t count, BoundingBox &box,
+                         BoundingSphere &sphere) {
+  if (count == 0) {
+    box = BoxFromRange({0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.0f});
+    sphere = BoundingSphere({0.0f, 0.0f, 0.0f}, 0.0f);
+    return;
+  }
+
+  // Each lane of the accumulators tracks every fourth position.
+  auto load = [](const float *stream, size_t i) {
+    return XMLoadFloat4(reinterpret_cast<const XMFLOAT4 *>(stream + i));
+  };
+  XMVECTOR minX = XMVectorReplicate(x[0]), maxX = minX;
+  XMVECTOR minY = XMVectorReplicate(y[0]), maxY = minY;
+  XMVECTOR minZ = XMVectorReplicate(z[0]), maxZ = minZ;
+
+  size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    XMVECTOR px = load(x, i), py = load(y, i), pz = load(z, i);
+    minX = XMVectorMin(minX, px);
+    maxX = XMVectorMax(maxX, px);
+    minY = XMVectorMin(minY, py);
+    maxY = XMVectorMax(maxY, py);
+    minZ = XMVectorMin(minZ, pz);
+    maxZ = XMVectorMax(maxZ, pz);
+  }
+  for (size_t j = i; j < count; j++) {
+    minX = XMVectorMin(minX, XMVectorReplicate(x[j]));
+    maxX = XMVectorMax(maxX, XMVectorReplicate(x[j]));
+    minY = XMVectorMin(minY, XMVectorReplicate(y[j]));
+    maxY = XMVectorMax(maxY, XMVectorReplicate(y[j]));
+    minZ = XMVectorMin(minZ, XMVectorReplicate(z[j]));
+    maxZ = XMVectorMax(maxZ, XMVectorReplicate(z[j]));
+  }
+
+  box = BoxFromRange(
+      {HorizontalMin(minX), HorizontalMin(minY), HorizontalMin(minZ)},
+      {HorizontalMax(maxX), HorizontalMax(maxY), HorizontalMax(maxZ)});
+
+  XMVECTOR cx = XMVectorReplicate(box.Center.x);
+  XMVECTOR cy = XMVectorReplicate(box.Center.y);
+  XMVECTOR cz = XMVectorReplicate(box.Center.z);
+  auto distanceSq = [&](FXMVECTOR px, FXMVECTOR py, FXMVECTOR pz) {
+    XMVECTOR dx = px - cx, dy = py - cy, dz = pz - cz;
+    return XMVectorMultiplyAdd(dz, dz,
+                               XMVectorMultiplyAdd(dy, dy, dx * dx));
+  };
+
+  XMVECTOR distance = XMVectorZero();
+  for (i = 0; i + 4 <= count; i += 4) {
+    distance = XMVectorMax(distance,
+                           distanceSq(load(x, i), load(y, i), load(z, i)));
+  }
+  for (; i < count; i++) {
+    distance = XMVectorMax(distance, distanceSq(XMVectorReplicate(x[i]),
+                                                XMVectorReplicate(y[i]),
+                                                XMVectorReplicate(z[i])));
+  }
+
+  sphere.Center = box.Center;
+  sphere.Radius = std::sqrt(HorizontalMax(distance));
+}
+
+BoundingBox MeshBounds::TransformBox(const BoundingBox &box, FXMMATRIX world) {
+  // Each world axis extent is the sum of the local extents projected onto it.
+  XMVECTOR extents = XMLoadFloat3(&box.Extents);
+  XMVECTOR worldExtents =
+      XMVectorAbs(world.r[0]) * XMVectorSplatX(extents) +
+      XMVectorAbs(world.r[1]) * XMVectorSplatY(extents) +
+      XMVectorAbs(world.r[2]) * XMVectorSplatZ(extents);
+
+  BoundingBox result;
+  XMStoreFloat3(&result.Center,
+                XMVector3TransformCoord(XMLoadFloat3(&box.Center), world));
+  XMStoreFloat3(&result.Extents, worldExtents);
+  return result;
+}
+
+bool MeshBounds::Intersects(const BoundingBox &box, const XMFLOAT4 planes[6]) {
+  XMVECTOR center = XMLoadFloat3(&box.Center);
+  XMVECTOR extents = XMLoadFloat3(&box.Extents);
+  for (int i = 0; i < 6; i++) {
+    XMVECTOR plane = XMLoadFloat4(&planes[i]);
+    float distance = XMVectorGetX(XMVector3Dot(plane, center)) + planes[i].w;
+    float radius = XMVectorGetX(XMVector3Dot(XMVectorAbs(plane), extents));
+    if (distance < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool WorldBoundsCache::Update(const XMFLOAT4X4 &world,
+                              const BoundingBox &localBox,
+                              const BoundingSphere &localSphere) {
+  if (Valid && std::memcmp(&World, &world, sizeof(World)) == 0) {
+    return false;
+  }
+  World = world;
+  Valid = true;
+
+  XMMATRIX m = XMLoadFloat4x4(&world);
+  WorldScale = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    WorldScale =
+        std::max<float>(WorldScale, XMVectorGetX(XMVector3Length(m.r[i])));
+  }
+
+  WorldBox = MeshBounds::TransformBox(localBox, m);
+  XMStoreFloat3(&WorldSphere.Center,
+                XMVector3TransformCoord(XMLoadFloat3(&localSphere.Center), m));
+  WorldSphere.Radius = localSphere.Radius * WorldScale;
+  return true;
+}
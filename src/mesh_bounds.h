@@ -0,0 +1,71 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <DirectXCollision.h>
+#include <DirectXMath.h>
+
+// Bounding volumes of position data.  The loops keep several independent
+// SIMD accumulators so long streams are not serialized on one min/max chain.
+class MeshBounds {
+public:
+  // Component-wise min and max of interleaved positions, e.g. the Position
+  // member of a vertex array.  Both are 0 for an empty range.
+  static void ComputeRange(const DirectX::XMFLOAT3 *positions, size_t count,
+                           size_t positionStride, DirectX::XMFLOAT3 &min,
+                           DirectX::XMFLOAT3 &max);
+
+  // Distance from center to the farthest position.
+  static float ComputeRadius(const DirectX::XMFLOAT3 *positions, size_t count,
+                             size_t positionStride,
+                             const DirectX::XMFLOAT3 &center);
+
+  // Box from ComputeRange, and the sphere around the box center that encloses
+  // every position.
+  static void Compute(const DirectX::XMFLOAT3 *positions, size_t count,
+                      size_t positionStride, DirectX::BoundingBox &box,
+                      DirectX::BoundingSphere &sphere);
+
+  // The same for positions stored as separate x, y and z streams, four lanes
+  // at a time.
+  static void Compute(const float *x, const float *y, const float *z,
+                      size_t count, DirectX::BoundingBox &box,
+                      DirectX::BoundingSphere &sphere);
+
+  // Smallest world-space box around a transformed local box.
+  static DirectX::BoundingBox TransformBox(const DirectX::BoundingBox &box,
+                                           DirectX::FXMMATRIX world);
+
+  // False when the box lies entirely outside one of the inward facing planes
+  // from ClusterCuller::ExtractFrustumPlanes.
+  static bool Intersects(const DirectX::BoundingBox &box,
+                         const DirectX::XMFLOAT4 planes[6]);
+};
+
+// World-space bounds of one object.  Update is cheap to call every frame: the
+// bounds are only recomputed when the world matrix differs from last time.
+class WorldBoundsCache {
+public:
+  // Returns true when the bounds were recomputed.
+  bool Update(const DirectX::XMFLOAT4X4 &world,
+              const DirectX::BoundingBox &localBox,
+              const DirectX::BoundingSphere &localSphere);
+
+  // Forces the next Update to recompute, e.g. after the local bounds changed.
+  void Invalidate() { Valid = false; }
+
+  const DirectX::BoundingBox &Box() const { return WorldBox; }
+  const DirectX::BoundingSphere &Sphere() const { return WorldSphere; }
+
+  // Largest axis scale of the world matrix.
+  float Scale() const { return WorldScale; }
+
+private:
+  DirectX::XMFLOAT4X4 World;
+  DirectX::BoundingBox WorldBox;
+  DirectX::BoundingSphere WorldSphere;
+  float WorldScale = 1.0f;
+  bool Valid = false;
+};
@@ -0,0 +1,158 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_cache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+using namespace DirectX;
+
+namespace {
+constexpr char Magic[4] = {'M', 'E', 'S', 'H'};
+
+// Every stream starts on this boundary, which keeps them aligned for their
+// element type since the mapping itself is page aligned.
+constexpr std::uint64_t StreamAlignment = 16;
+
+struct FileHeader {
+  char Magic[4];
+  std::uint32_t Version;
+  std::uint64_t SourceHash;
+
+  std::uint32_t VertexStride;
+  std::uint32_t VertexCount;
+  std::uint32_t IndexCount;
+  std::uint32_t SubmeshCount;
+
+  XMFLOAT3 BoundsCenter;
+  XMFLOAT3 BoundsExtents;
+  XMFLOAT3 SphereCenter;
+  float SphereRadius;
+
+  std::uint64_t VertexOffset;
+  std::uint64_t IndexOffset;
+  std::uint64_t SubmeshOffset;
+};
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+static_assert(std::is_trivially_copyable_v<MeshCache::Submesh>);
+
+std::uint64_t Align(std::uint64_t offset) {
+  return (offset + StreamAlignment - 1) / StreamAlignment * StreamAlignment;
+}
+} // namespace
+
+MeshCache::uint64 MeshCache::Hash(std::span<const std::byte> bytes) {
+  // FNV-1a over 8-byte words, then over the tail, so hashing runs at memory
+  // speed rather than a byte at a time.
+  constexpr uint64 prime = 0x100000001b3ull;
+  uint64 hash = 0xcbf29ce484222325ull;
+
+  size_t i = 0;
+  for (; i + sizeof(uint64) <= bytes.size(); i += sizeof(uint64)) {
+    uint64 word;
+    std::memcpy(&word, bytes.data() + i, sizeof(word));
+    hash = (hash ^ word) * prime;
+  }
+  for (; i < bytes.size(); i++) {
+    hash = (hash ^ (uint64)bytes[i]) * prime;
+  }
+  return hash ^ bytes.size();
+}
+
+bool MeshCache::Load(const std::string &path, uint64 sourceHash,
+                     uint32 vertexStride) {
+  CachedMesh = {};
+  if (!File.Open(path) || File.Size() < sizeof(FileHeader)) {
+    File.Close();
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, File.Data(), sizeof(header));
+
+  auto fits = [&](uint64 offset, uint64 count, uint64 elementSize) {
+    return offset % StreamAlignment == 0 && offset <= File.Size() &&
+           count <= (File.Size() - offset) / elementSize;
+  };
+  bool valid =
+      std::memcmp(header.Magic, Magic, sizeof(Magic)) == 0 &&
+      header.Version == Version && header.SourceHash == sourceHash &&
+      header.VertexStride == vertexStride && vertexStride != 0 &&
+      fits(header.VertexOffset, header.VertexCount, header.VertexStride) &&
+      fits(header.IndexOffset, header.IndexCount, sizeof(uint32)) &&
+      fits(header.SubmeshOffset, header.SubmeshCount, sizeof(Submesh));
+  if (!valid) {
+    File.Close();
+    return false;
+  }
+
+  auto data = File.Data();
+  CachedMesh.Vertices = {data + header.VertexOffset,
+                         (size_t)header.VertexCount * header.VertexStride};
+  CachedMesh.VertexStride = header.VertexStride;
+  CachedMesh.Indices = {
+      reinterpret_cast<const uint32 *>(data + header.IndexOffset),
+      header.IndexCount};
+  CachedMesh.Submeshes = {
+      reinterpret_cast<const Submesh *>(data + header.SubmeshOffset),
+      header.SubmeshCount};
+  CachedMesh.Bounds = BoundingBox(header.BoundsCenter, header.BoundsExtents);
+  CachedMesh.SphereBounds =
+      BoundingSphere(header.SphereCenter, header.SphereRadius);
+  return true;
+}
+
+bool MeshCache::Write(const std::string &path, uint64 sourceHash,
+                      const Mesh &mesh) {
+  FileHeader header = {};
+  std::memcpy(header.Magic, Magic, sizeof(Magic));
+  header.Version = Version;
+  header.SourceHash = sourceHash;
+  header.VertexStride = mesh.VertexStride;
+  header.VertexCount = (uint32)mesh.VertexCount();
+  header.IndexCount = (uint32)mesh.Indices.size();
+  header.SubmeshCount = (uint32)mesh.Submeshes.size();
+  header.BoundsCenter = mesh.Bounds.Center;
+  header.BoundsExtents = mesh.Bounds.Extents;
+  header.SphereCenter = mesh.SphereBounds.Center;
+  header.SphereRadius = mesh.SphereBounds.Radius;
+  header.VertexOffset = Align(sizeof(FileHeader));
+  header.IndexOffset = Align(header.VertexOffset + mesh.Vertices.size());
+  header.SubmeshOffset =
+      Align(header.IndexOffset + mesh.Indices.size_bytes());
+
+  auto temporaryPath = path + ".tmp";
+  {
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    // The gaps are written out as zeros rather than seeked over: a seek
+    // past the end does not grow the file, so an empty last stream would
+    // leave its offset beyond the end and Load would reject the file.
+    uint64 written = 0;
+    auto writeAt = [&](uint64 offset, const void *data, size_t byteSize) {
+      static constexpr char zeros[StreamAlignment] = {};
+      file.write(zeros, (std::streamsize)(offset - written));
+      file.write(static_cast<const char *>(data), (std::streamsize)byteSize);
+      written = offset + byteSize;
+    };
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.VertexOffset, mesh.Vertices.data(), mesh.Vertices.size());
+    writeAt(header.IndexOffset, mesh.Indices.data(),
+            mesh.Indices.size_bytes());
+    writeAt(header.SubmeshOffset, mesh.Submeshes.data(),
+            mesh.Submeshes.size_bytes());
+    if (!file) {
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(temporaryPath, path, error);
+  if (error) {
+    std::filesystem::remove(temporaryPath, error);
+    return false;
+  }
+  return true;
+}
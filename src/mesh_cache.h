@@ -0,0 +1,77 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "mapped_file.h"
+#include <DirectXCollision.h>
+#include <cstdint>
+#include <span>
+#include <string>
+
+// Versioned binary mesh file written after an asset is first imported.  It
+// holds the vertex and index streams exactly as they are uploaded, the
+// submesh table, bounds, and the hash of the source file it was built from.
+// Loading maps the file and points straight into it: there is no parsing and
+// no per-vertex copy.
+//
+//   MeshCache cache;
+//   auto sourceHash = MeshCache::Hash(source.Bytes());
+//   if (!cache.Load(cachePath, sourceHash, sizeof(Vertex))) {
+//     ... import the source ...
+//     MeshCache::Write(cachePath, sourceHash, mesh);
+//   }
+class MeshCache {
+public:
+  using uint32 = std::uint32_t;
+  using uint64 = std::uint64_t;
+
+  // Bumped whenever the layout below or the meaning of a field changes.
+  static constexpr uint32 Version = 1;
+
+  struct Submesh {
+    uint32 IndexCount = 0;
+    uint32 StartIndexLocation = 0;
+    std::int32_t BaseVertexLocation = 0;
+    float LodError = 0.0f;
+  };
+
+  // A mesh as views into a loaded cache file, or into memory owned by the
+  // caller when writing one.
+  struct Mesh {
+    std::span<const std::byte> Vertices;
+    uint32 VertexStride = 0;
+    std::span<const uint32> Indices;
+    std::span<const Submesh> Submeshes;
+    DirectX::BoundingBox Bounds;
+    DirectX::BoundingSphere SphereBounds;
+
+    size_t VertexCount() const {
+      return VertexStride == 0 ? 0 : Vertices.size() / VertexStride;
+    }
+    template <typename V> std::span<const V> VerticesAs() const {
+      return {reinterpret_cast<const V *>(Vertices.data()), VertexCount()};
+    }
+  };
+
+  // 64-bit hash of a source file's content.
+  static uint64 Hash(std::span<const std::byte> bytes);
+
+  // Maps the cache at path.  Returns false, keeping nothing mapped, when it
+  // is missing, truncated, from another version, built from a source with a
+  // different hash, or stores vertices of another size.
+  bool Load(const std::string &path, uint64 sourceHash, uint32 vertexStride);
+
+  // The loaded mesh.  Its views stay valid as long as this cache does.
+  const Mesh &Get() const { return CachedMesh; }
+
+  // Writes mesh to path through a temporary file, so a reader never sees a
+  // half-written cache.  Returns false when the file cannot be written.
+  static bool Write(const std::string &path, uint64 sourceHash,
+                    const Mesh &mesh);
+
+private:
+  MappedFile File;
+  Mesh CachedMesh;
+};
@@ -0,0 +1,181 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_normals.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+template <typename Body>
+void ForRange(ThreadPool *pool, size_t count, const Body &body) {
+  if (pool && count > MeshNormals::ParallelGrainSize) {
+    pool->ParallelForRange(count, MeshNormals::ParallelGrainSize, body);
+  } else {
+    body(0, count);
+  }
+}
+
+// Any unit vector orthogonal to n, for tangents without usable UVs.
+XMVECTOR Orthogonal(FXMVECTOR n) {
+  XMVECTOR axis = std::abs(XMVectorGetX(n)) < 0.9f
+                      ? XMVectorSet(1.0f, 0.0f, 0.0f, 0.0f)
+                      : XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  return XMVector3Normalize(XMVector3Cross(n, axis));
+}
+
+bool IsZero(FXMVECTOR v) {
+  return XMVectorGetX(XMVector3LengthSq(v)) <= 1e-24f;
+}
+} // namespace
+
+MeshNormals::MeshNormals(const std::vector<uint32> &indices,
+                         size_t vertexCount)
+    : Indices(indices), CornerOffsets(vertexCount + 1, 0),
+      Corners(indices.size()), AffectedEpoch(vertexCount, 0) {
+  // Counting sort of the corners by vertex, keeping corner order within each
+  // vertex so sums are always taken in the same order.
+  for (auto v : Indices) {
+    CornerOffsets[v + 1]++;
+  }
+  for (size_t v = 0; v < vertexCount; v++) {
+    CornerOffsets[v + 1] += CornerOffsets[v];
+  }
+  std::vector<uint32> fill(CornerOffsets.begin(), CornerOffsets.end() - 1);
+  for (size_t c = 0; c < Indices.size(); c++) {
+    Corners[fill[Indices[c]]++] = (uint32)c;
+  }
+}
+
+XMVECTOR MeshNormals::VertexNormal(uint32 vertex,
+                                   Stream<const XMFLOAT3> positions) const {
+  XMVECTOR sum = XMVectorZero();
+  XMVECTOR p = XMLoadFloat3(&positions[vertex]);
+  for (auto c = CornerOffsets[vertex]; c < CornerOffsets[vertex + 1]; c++) {
+    auto corner = Corners[c];
+    auto triangle = corner - corner % 3;
+    XMVECTOR next =
+        XMLoadFloat3(&positions[Indices[triangle + (corner + 1) % 3]]);
+    XMVECTOR previous =
+        XMLoadFloat3(&positions[Indices[triangle + (corner + 2) % 3]]);
+
+    // The cross product's length is twice the area, so it already carries
+    // the area weight.
+    XMVECTOR e1 = next - p;
+    XMVECTOR e2 = previous - p;
+    if (IsZero(e1) || IsZero(e2)) {
+      continue;
+    }
+    sum += XMVector3Cross(e1, e2) * XMVector3AngleBetweenVectors(e1, e2);
+  }
+
+  if (IsZero(sum)) {
+    return XMVectorSet(0.0f, 1.0f, 0.0f, 0.0f);
+  }
+  return XMVector3Normalize(sum);
+}
+
+void MeshNormals::ComputeNormals(Stream<const XMFLOAT3> positions,
+                                 Stream<XMFLOAT3> normals,
+                                 ThreadPool *pool) const {
+  ForRange(pool, VertexCount(), [&](size_t begin, size_t end) {
+    for (auto v = begin; v < end; v++) {
+      XMStoreFloat3(&normals[v], VertexNormal((uint32)v, positions));
+    }
+  });
+}
+
+void MeshNormals::UpdateNormals(std::span<const uint32> touched,
+                                Stream<const XMFLOAT3> positions,
+                                Stream<XMFLOAT3> normals, ThreadPool *pool) {
+  if (++Epoch == 0) {
+    std::fill(AffectedEpoch.begin(), AffectedEpoch.end(), 0);
+    Epoch = 1;
+  }
+
+  // A moved vertex changes the normal and corner angles of its triangles,
+  // so every vertex of those triangles is redone.
+  Affected.clear();
+  for (auto v : touched) {
+    for (auto c = CornerOffsets[v]; c < CornerOffsets[v + 1]; c++) {
+      auto triangle = Corners[c] - Corners[c] % 3;
+      for (uint32 k = 0; k < 3; k++) {
+        auto w = Indices[triangle + k];
+        if (AffectedEpoch[w] != Epoch) {
+          AffectedEpoch[w] = Epoch;
+          Affected.push_back(w);
+        }
+      }
+    }
+  }
+
+  ForRange(pool, Affected.size(), [&](size_t begin, size_t end) {
+    for (auto i = begin; i < end; i++) {
+      auto v = Affected[i];
+      XMStoreFloat3(&normals[v], VertexNormal(v, positions));
+    }
+  });
+}
+
+void MeshNormals::ComputeTangents(Stream<const XMFLOAT3> positions,
+                                  Stream<const XMFLOAT3> normals,
+                                  Stream<const XMFLOAT2> texcoords,
+                                  Stream<XMFLOAT3> tangents,
+                                  Stream<float> handedness,
+                                  ThreadPool *pool) const {
+  ForRange(pool, VertexCount(), [&](size_t begin, size_t end) {
+    for (auto v = begin; v < end; v++) {
+      XMVECTOR n = XMLoadFloat3(&normals[v]);
+      XMVECTOR p = XMLoadFloat3(&positions[v]);
+      XMFLOAT2 uv = texcoords[v];
+
+      XMVECTOR tangentSum = XMVectorZero();
+      XMVECTOR bitangentSum = XMVectorZero();
+      for (auto c = CornerOffsets[v]; c < CornerOffsets[v + 1]; c++) {
+        auto corner = Corners[c];
+        auto triangle = corner - corner % 3;
+        auto next = Indices[triangle + (corner + 1) % 3];
+        auto previous = Indices[triangle + (corner + 2) % 3];
+
+        XMVECTOR e1 = XMLoadFloat3(&positions[next]) - p;
+        XMVECTOR e2 = XMLoadFloat3(&positions[previous]) - p;
+        float du1 = texcoords[next].x - uv.x, dv1 = texcoords[next].y - uv.y;
+        float du2 = texcoords[previous].x - uv.x;
+        float dv2 = texcoords[previous].y - uv.y;
+
+        // Position derivatives along u and v.  Only their directions are
+        // used, so the common 1 / det factor reduces to its sign.
+        float det = du1 * dv2 - du2 * dv1;
+        if (det == 0.0f || IsZero(e1) || IsZero(e2)) {
+          continue;
+        }
+        float sign = det > 0.0f ? 1.0f : -1.0f;
+        XMVECTOR t = (e1 * dv2 - e2 * dv1) * sign;
+        XMVECTOR b = (e2 * du1 - e1 * du2) * sign;
+
+        // Projected onto the normal plane and normalized before weighting,
+        // as MikkTSpace does, so large triangles do not dominate.
+        t -= n * XMVector3Dot(n, t);
+        b -= n * XMVector3Dot(n, b);
+        XMVECTOR angle = XMVector3AngleBetweenVectors(e1, e2);
+        if (!IsZero(t)) {
+          tangentSum += XMVector3Normalize(t) * angle;
+        }
+        if (!IsZero(b)) {
+          bitangentSum += XMVector3Normalize(b) * angle;
+        }
+      }
+
+      XMVECTOR tangent =
+          IsZero(tangentSum) ? Orthogonal(n) : XMVector3Normalize(tangentSum);
+      XMStoreFloat3(&tangents[v], tangent);
+      if (handedness.First) {
+        XMVECTOR expected = XMVector3Cross(n, tangent);
+        float dot = XMVectorGetX(XMVector3Dot(expected, bitangentSum));
+        handedness[v] = dot < 0.0f ? -1.0f : 1.0f;
+      }
+    }
+  });
+}
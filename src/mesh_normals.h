@@ -0,0 +1,94 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "thread_pool.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Smooth normals and tangents of an indexed triangle list.  The vertex to
+// triangle adjacency is built once per topology; after that every vertex
+// gathers from its own triangles, so vertices are computed in parallel
+// without atomics and the result does not depend on the thread count.
+//
+// Normals weight each triangle by its area and by the angle it spans at the
+// vertex.  Tangents follow MikkTSpace's per-vertex rule: each triangle's UV
+// tangent is projected onto the normal plane and weighted by its corner
+// angle, with the handedness of the bitangent kept separately.  Vertices
+// are expected to be split along UV seams already.
+//
+//   MeshNormals normals(indices, vertices.size());
+//   normals.ComputeNormals({&vertices[0].Pos, sizeof(Vertex)},
+//                          {&vertices[0].Normal, sizeof(Vertex)}, &pool);
+//   ...
+//   // After moving the vertices listed in moved:
+//   normals.UpdateNormals(moved, positions, normalStream, &pool);
+class MeshNormals {
+public:
+  using uint32 = std::uint32_t;
+
+  // Strided view of one vertex member, e.g. {&vertices[0].Normal,
+  // sizeof(Vertex)}.
+  template <typename T> struct Stream {
+    T *First;
+    size_t Stride;
+
+    T &operator[](size_t i) const {
+      using Byte = std::conditional_t<std::is_const_v<T>, const std::uint8_t,
+                                      std::uint8_t>;
+      return *reinterpret_cast<T *>(reinterpret_cast<Byte *>(First) +
+                                    i * Stride);
+    }
+  };
+
+  MeshNormals(const std::vector<uint32> &indices, size_t vertexCount);
+
+  size_t VertexCount() const { return CornerOffsets.size() - 1; }
+
+  // Normals of every vertex, serially when pool is null.  Vertices no
+  // triangle uses get (0, 1, 0).
+  void ComputeNormals(Stream<const DirectX::XMFLOAT3> positions,
+                      Stream<DirectX::XMFLOAT3> normals,
+                      ThreadPool *pool = nullptr) const;
+
+  // Recomputes only the normals that moving the touched vertices changes:
+  // those of every vertex sharing a triangle with one of them.  The others
+  // must be up to date already.
+  void UpdateNormals(std::span<const uint32> touched,
+                     Stream<const DirectX::XMFLOAT3> positions,
+                     Stream<DirectX::XMFLOAT3> normals,
+                     ThreadPool *pool = nullptr);
+
+  // Unit tangents along increasing u, orthogonal to the normals.  When
+  // handedness is given it receives +1 or -1 per vertex, the sign to apply to
+  // cross(normal, tangent) for the bitangent.
+  void ComputeTangents(Stream<const DirectX::XMFLOAT3> positions,
+                       Stream<const DirectX::XMFLOAT3> normals,
+                       Stream<const DirectX::XMFLOAT2> texcoords,
+                       Stream<DirectX::XMFLOAT3> tangents,
+                       Stream<float> handedness = {nullptr, 0},
+                       ThreadPool *pool = nullptr) const;
+
+  static constexpr size_t ParallelGrainSize = 2048;
+
+private:
+  DirectX::XMVECTOR
+  VertexNormal(uint32 vertex, Stream<const DirectX::XMFLOAT3> positions) const;
+
+  std::vector<uint32> Indices;
+  // Corners of vertex v are Corners[CornerOffsets[v]..CornerOffsets[v + 1]),
+  // as indices into Indices.
+  std::vector<uint32> CornerOffsets;
+  std::vector<uint32> Corners;
+
+  // Scratch of UpdateNormals: vertices already queued carry the current
+  // epoch.
+  std::vector<uint32> Affected;
+  std::vector<uint32> AffectedEpoch;
+  uint32 Epoch = 0;
+};
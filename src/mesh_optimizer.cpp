@@ -0,0 +1,388 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+using namespace DirectX;
+
+namespace {
+using uint32 = MeshOptimizer::uint32;
+
+// Forsyth's scoring parameters.  The simulated cache is an LRU of 32 entries,
+// which works well for the FIFO caches of real hardware too.
+constexpr int MaxCacheSize = 32;
+constexpr float CacheDecayPower = 1.5f;
+constexpr float LastTriScore = 0.75f;
+constexpr float ValenceBoostScale = 2.0f;
+constexpr float ValenceBoostPower = 0.5f;
+
+float VertexScore(int cachePosition, uint32 remainingTriangles) {
+  if (remainingTriangles == 0) {
+    return -1.0f;
+  }
+
+  float score = 0.0f;
+  if (cachePosition >= 0) {
+    if (cachePosition < 3) {
+      // The vertices of the last triangle get a fixed score so the optimizer
+      // does not prefer to immediately reuse them.
+      score = LastTriScore;
+    } else {
+      const float scaler = 1.0f / (MaxCacheSize - 3);
+      score = 1.0f - (cachePosition - 3) * scaler;
+      score = std::pow(score, CacheDecayPower);
+    }
+  }
+
+  // Boost vertices with few triangles left so lone triangles are not stranded.
+  score += ValenceBoostScale *
+           std::pow((float)remainingTriangles, -ValenceBoostPower);
+  return score;
+}
+
+// FIFO cache simulator shared by the analysis and the overdraw clustering.
+class FifoCache {
+public:
+  FifoCache(size_t vertexCount, uint32 cacheSize)
+      : timestamps(vertexCount, 0), cacheSize(cacheSize),
+        time(cacheSize + 1) {}
+
+  // Returns the number of vertices of the triangle that missed the cache.
+  uint32 Access(const uint32 *triangle) {
+    uint32 misses = 0;
+    for (int k = 0; k < 3; k++) {
+      auto v = triangle[k];
+      if (time - timestamps[v] > cacheSize) {
+        timestamps[v] = time++;
+        misses++;
+      }
+    }
+    return misses;
+  }
+
+  // Makes every vertex miss on its next access.
+  void Flush() { time += cacheSize + 1; }
+
+private:
+  std::vector<size_t> timestamps;
+  size_t cacheSize;
+  size_t time;
+};
+} // namespace
+
+MeshOptimizer::CacheStatistics
+MeshOptimizer::AnalyzeVertexCache(const std::vector<uint32> &indices,
+                                  size_t vertexCount, uint32 cacheSize) {
+  CacheStatistics stats;
+  if (indices.empty()) {
+    return stats;
+  }
+
+  FifoCache cache(vertexCount, cacheSize);
+  std::vector<bool> referenced(vertexCount, false);
+  size_t misses = 0, uniqueVertices = 0;
+
+  for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+    misses += cache.Access(&indices[i]);
+    for (int k = 0; k < 3; k++) {
+      if (!referenced[indices[i + k]]) {
+        referenced[indices[i + k]] = true;
+        uniqueVertices++;
+      }
+    }
+  }
+
+  stats.ACMR = (float)misses / (float)(indices.size() / 3);
+  stats.ATVR = (float)misses / (float)uniqueVertices;
+  return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::vector<uint32> &indices,
+                                        size_t vertexCount) {
+  const auto triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return;
+  }
+
+  //
+  // Build vertex -> triangle adjacency.  The per-vertex lists are shrunk as
+  // triangles are emitted so only the live triangles are visited.
+  //
+
+  std::vector<uint32> remaining(vertexCount, 0);
+  for (auto v : indices) {
+    remaining[v]++;
+  }
+
+  std::vector<uint32> offsets(vertexCount + 1, 0);
+  for (size_t v = 0; v < vertexCount; v++) {
+    offsets[v + 1] = offsets[v] + remaining[v];
+  }
+
+  std::vector<uint32> adjacency(indices.size());
+  {
+    std::vector<uint32> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+      adjacency[fill[indices[i]]++] = (uint32)(i / 3);
+    }
+  }
+
+  std::vector<int> cachePosition(vertexCount, -1);
+  std::vector<float> vertexScore(vertexCount);
+  for (size_t v = 0; v < vertexCount; v++) {
+    vertexScore[v] = VertexScore(-1, remaining[v]);
+  }
+
+  std::vector<bool> emitted(triangleCount, false);
+
+  std::vector<uint32> output;
+  output.reserve(indices.size());
+
+  std::vector<uint32> cache, nextCache;
+  cache.reserve(MaxCacheSize + 3);
+  nextCache.reserve(MaxCacheSize + 3);
+
+  size_t inputCursor = 0;
+  long long bestTriangle = -1;
+
+  for (size_t emittedCount = 0; emittedCount < triangleCount; emittedCount++) {
+    if (bestTriangle < 0) {
+      // Dead end: nothing in the cache has triangles left.  Restart from the
+      // next triangle in input order.
+      while (emitted[inputCursor]) {
+        inputCursor++;
+      }
+      bestTriangle = (long long)inputCursor;
+    }
+
+    const auto t = (size_t)bestTriangle;
+    const uint32 *triangle = &indices[t * 3];
+    output.insert(output.end(), triangle, triangle + 3);
+    emitted[t] = true;
+
+    // Retire the triangle from its vertices' adjacency lists.
+    for (int k = 0; k < 3; k++) {
+      auto v = triangle[k];
+      auto begin = adjacency.begin() + offsets[v];
+      auto end = begin + remaining[v];
+      auto it = std::find(begin, end, (uint32)t);
+      std::iter_swap(it, end - 1);
+      remaining[v]--;
+    }
+
+    // Move the triangle's vertices to the front of the LRU cache.
+    nextCache.assign(triangle, triangle + 3);
+    for (auto v : cache) {
+      if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+        nextCache.push_back(v);
+      }
+    }
+
+    for (size_t i = 0; i < nextCache.size(); i++) {
+      auto v = nextCache[i];
+      cachePosition[v] = i < MaxCacheSize ? (int)i : -1;
+      vertexScore[v] = VertexScore(cachePosition[v], remaining[v]);
+    }
+
+    // Rescore the live triangles of every vertex that is or was in the cache
+    // and pick the best one as the next candidate.
+    float bestScore = -1.0f;
+    bestTriangle = -1;
+    for (auto v : nextCache) {
+      for (uint32 i = 0; i < remaining[v]; i++) {
+        auto adjacent = adjacency[offsets[v] + i];
+        float score = vertexScore[indices[adjacent * 3 + 0]] +
+                      vertexScore[indices[adjacent * 3 + 1]] +
+                      vertexScore[indices[adjacent * 3 + 2]];
+        if (score > bestScore) {
+          bestScore = score;
+          bestTriangle = adjacent;
+        }
+      }
+    }
+
+    if (nextCache.size() > MaxCacheSize) {
+      nextCache.resize(MaxCacheSize);
+    }
+    cache.swap(nextCache);
+  }
+
+  indices.swap(output);
+}
+
+void MeshOptimizer::OptimizeOverdraw(std::vector<uint32> &indices,
+                                     const XMFLOAT3 *positions,
+                                     size_t vertexCount, size_t positionStride,
+                                     float threshold) {
+  const auto triangleCount = indices.size() / 3;
+  if (triangleCount == 0) {
+    return;
+  }
+
+  auto position = [&](uint32 v) {
+    auto bytes = reinterpret_cast<const std::uint8_t *>(positions);
+    return XMLoadFloat3(
+        reinterpret_cast<const XMFLOAT3 *>(bytes + v * positionStride));
+  };
+
+  //
+  // Hard boundaries: triangles where the simulated cache misses all three
+  // vertices.  Reordering at those points costs nothing.
+  //
+
+  std::vector<uint32> hardClusters;
+  std::vector<uint32> triangleMisses(triangleCount);
+  {
+    FifoCache cache(vertexCount, DefaultCacheSize);
+    for (size_t t = 0; t < triangleCount; t++) {
+      triangleMisses[t] = cache.Access(&indices[t * 3]);
+      if (t == 0 || triangleMisses[t] == 3) {
+        hardClusters.push_back((uint32)t);
+      }
+    }
+  }
+
+  //
+  // Soft boundaries: split a hard cluster further wherever the ACMR of the
+  // piece so far stays within threshold of the cluster as a whole.
+  //
+
+  std::vector<uint32> clusters;
+  for (size_t c = 0; c < hardClusters.size(); c++) {
+    auto start = hardClusters[c];
+    auto end = c + 1 < hardClusters.size() ? hardClusters[c + 1]
+                                           : (uint32)triangleCount;
+
+    uint32 clusterMisses = 0;
+    for (auto t = start; t < end; t++) {
+      clusterMisses += triangleMisses[t];
+    }
+    float clusterThreshold =
+        threshold * (float)clusterMisses / (float)(end - start);
+
+    FifoCache cache(vertexCount, DefaultCacheSize);
+    clusters.push_back(start);
+    uint32 pieceStart = start, pieceMisses = 0;
+    for (auto t = start; t < end; t++) {
+      pieceMisses += cache.Access(&indices[t * 3]);
+      float pieceAcmr = (float)pieceMisses / (float)(t + 1 - pieceStart);
+      if (t + 1 < end && pieceAcmr <= clusterThreshold) {
+        clusters.push_back(t + 1);
+        pieceStart = t + 1;
+        pieceMisses = 0;
+        cache.Flush();
+      }
+    }
+  }
+
+  //
+  // Sort key: how far the cluster faces away from the mesh center.  Clusters
+  // on the convex hull facing outward tend to occlude the rest.
+  //
+
+  XMVECTOR meshCentroid = XMVectorZero();
+  float meshArea = 0.0f;
+
+  struct ClusterInfo {
+    uint32 Start = 0;
+    uint32 End = 0;
+    XMFLOAT3 Centroid = {0.0f, 0.0f, 0.0f};
+    XMFLOAT3 Normal = {0.0f, 0.0f, 0.0f};
+    float Key = 0.0f;
+  };
+  std::vector<ClusterInfo> infos(clusters.size());
+
+  for (size_t c = 0; c < clusters.size(); c++) {
+    auto &info = infos[c];
+    info.Start = clusters[c];
+    info.End = c + 1 < clusters.size() ? clusters[c + 1] : (uint32)triangleCount;
+
+    XMVECTOR centroid = XMVectorZero();
+    XMVECTOR normal = XMVectorZero();
+    float area = 0.0f;
+    for (auto t = info.Start; t < info.End; t++) {
+      XMVECTOR p0 = position(indices[t * 3 + 0]);
+      XMVECTOR p1 = position(indices[t * 3 + 1]);
+      XMVECTOR p2 = position(indices[t * 3 + 2]);
+
+      // Twice the area weighted face normal.
+      XMVECTOR n = XMVector3Cross(p1 - p0, p2 - p0);
+      float a = XMVectorGetX(XMVector3Length(n));
+
+      centroid += (a / 3.0f) * (p0 + p1 + p2);
+      normal += n;
+      area += a;
+    }
+
+    meshCentroid += centroid;
+    meshArea += area;
+
+    XMStoreFloat3(&info.Centroid, area > 0.0f ? (1.0f / area) * centroid
+                                              : position(indices[info.Start * 3]));
+    XMStoreFloat3(&info.Normal, XMVector3Normalize(normal));
+  }
+
+  if (meshArea > 0.0f) {
+    meshCentroid = (1.0f / meshArea) * meshCentroid;
+  }
+
+  for (auto &info : infos) {
+    XMVECTOR offset = XMLoadFloat3(&info.Centroid) - meshCentroid;
+    info.Key = XMVectorGetX(XMVector3Dot(offset, XMLoadFloat3(&info.Normal)));
+  }
+
+  std::stable_sort(infos.begin(), infos.end(),
+                   [](const ClusterInfo &a, const ClusterInfo &b) {
+                     return a.Key > b.Key;
+                   });
+
+  std::vector<uint32> output;
+  output.reserve(indices.size());
+  for (auto &info : infos) {
+    output.insert(output.end(), indices.begin() + info.Start * 3,
+                  indices.begin() + info.End * 3);
+  }
+  indices.swap(output);
+}
+
+std::vector<MeshOptimizer::uint32>
+MeshOptimizer::OptimizeVertexFetchRemap(std::vector<uint32> &indices,
+                                        size_t vertexCount) {
+  constexpr auto Unassigned = ~0u;
+  std::vector<uint32> remap(vertexCount, Unassigned);
+
+  uint32 next = 0;
+  for (auto &index : indices) {
+    if (remap[index] == Unassigned) {
+      remap[index] = next++;
+    }
+    index = remap[index];
+  }
+
+  for (auto &r : remap) {
+    if (r == Unassigned) {
+      r = next++;
+    }
+  }
+
+  return remap;
+}
+
+MeshOptimizer::Report
+MeshOptimizer::Optimize(GeometryGenerator::MeshData &meshData) {
+  return Optimize(meshData.Vertices, meshData.Indices32);
+}
+
+std::string MeshOptimizer::Describe(const std::string &name,
+                                    const Report &report) {
+  char buffer[256];
+  std::snprintf(buffer, sizeof(buffer),
+                "%s: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", name.c_str(),
+                report.Before.ACMR, report.After.ACMR, report.Before.ATVR,
+                report.After.ATVR);
+  return buffer;
+}
@@ -0,0 +1,97 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "geometry_generator.h"
+#include <string>
+#include <type_traits>
+
+// Reorders indexed triangle lists for the post-transform vertex cache, for
+// overdraw and for vertex fetch locality.  Works on plain index vectors so
+// the same passes apply to GeometryGenerator output and to imported meshes.
+class MeshOptimizer {
+public:
+  using uint32 = std::uint32_t;
+
+  static constexpr uint32 DefaultCacheSize = 16;
+
+  struct CacheStatistics {
+    // Average cache miss ratio: transformed vertices per triangle (0.5..3).
+    float ACMR = 0.0f;
+    // Average transform to vertex ratio: transformed vertices per referenced
+    // vertex (1.0 is optimal).
+    float ATVR = 0.0f;
+  };
+
+  struct Report {
+    CacheStatistics Before;
+    CacheStatistics After;
+  };
+
+  // Simulates a FIFO post-transform cache of cacheSize entries.
+  static CacheStatistics AnalyzeVertexCache(const std::vector<uint32> &indices,
+                                            size_t vertexCount,
+                                            uint32 cacheSize = DefaultCacheSize);
+
+  // Tom Forsyth's linear-speed vertex cache optimization.
+  static void OptimizeVertexCache(std::vector<uint32> &indices,
+                                  size_t vertexCount);
+
+  // Splits a cache-optimized index list into clusters and sorts them so that
+  // outward facing clusters far from the mesh center are drawn first.
+  // threshold bounds how much the ACMR may degrade (1.05 = 5%).
+  static void OptimizeOverdraw(std::vector<uint32> &indices,
+                               const DirectX::XMFLOAT3 *positions,
+                               size_t vertexCount, size_t positionStride,
+                               float threshold = 1.05f);
+
+  // Renumbers vertices in first-use order.  Returns the old -> new remap
+  // table; unreferenced vertices are moved to the end.
+  static std::vector<uint32> OptimizeVertexFetchRemap(
+      std::vector<uint32> &indices, size_t vertexCount);
+
+  template <typename V>
+  static void RemapVertices(std::vector<V> &vertices,
+                            const std::vector<uint32> &remap);
+
+  // Runs all three passes.  V must start with its XMFLOAT3 position.
+  template <typename V>
+  static Report Optimize(std::vector<V> &vertices,
+                         std::vector<uint32> &indices);
+
+  static Report Optimize(GeometryGenerator::MeshData &meshData);
+
+  static std::string Describe(const std::string &name, const Report &report);
+};
+
+template <typename V>
+inline void MeshOptimizer::RemapVertices(std::vector<V> &vertices,
+                                         const std::vector<uint32> &remap) {
+  std::vector<V> remapped(vertices.size());
+  for (size_t i = 0; i < vertices.size(); i++) {
+    remapped[remap[i]] = vertices[i];
+  }
+  vertices.swap(remapped);
+}
+
+template <typename V>
+inline MeshOptimizer::Report
+MeshOptimizer::Optimize(std::vector<V> &vertices,
+                        std::vector<uint32> &indices) {
+  static_assert(std::is_standard_layout_v<V>,
+                "Vertex must be standard layout with position first");
+
+  Report report;
+  report.Before = AnalyzeVertexCache(indices, vertices.size());
+
+  OptimizeVertexCache(indices, vertices.size());
+  OptimizeOverdraw(indices,
+                   reinterpret_cast<const DirectX::XMFLOAT3 *>(vertices.data()),
+                   vertices.size(), sizeof(V));
+  RemapVertices(vertices, OptimizeVertexFetchRemap(indices, vertices.size()));
+
+  report.After = AnalyzeVertexCache(indices, vertices.size());
+  return report;
+}
@@ -0,0 +1,438 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_simplifier.h"
+#include "mesh_optimizer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace {
+using uint32 = MeshSimplifier::uint32;
+
+// Symmetric 4x4 quadric of summed, area weighted plane equations.
+struct Quadric {
+  double A2 = 0, AB = 0, AC = 0, AD = 0;
+  double B2 = 0, BC = 0, BD = 0;
+  double C2 = 0, CD = 0;
+  double D2 = 0;
+  double Weight = 0;
+
+  void AddPlane(double a, double b, double c, double d, double weight) {
+    A2 += weight * a * a, AB += weight * a * b, AC += weight * a * c;
+    AD += weight * a * d, B2 += weight * b * b, BC += weight * b * c;
+    BD += weight * b * d, C2 += weight * c * c, CD += weight * c * d;
+    D2 += weight * d * d;
+    Weight += weight;
+  }
+
+  Quadric &operator+=(const Quadric &q) {
+    A2 += q.A2, AB += q.AB, AC += q.AC, AD += q.AD;
+    B2 += q.B2, BC += q.BC, BD += q.BD;
+    C2 += q.C2, CD += q.CD;
+    D2 += q.D2;
+    Weight += q.Weight;
+    return *this;
+  }
+
+  // Mean squared distance of p to the accumulated planes.
+  double Evaluate(const XMFLOAT3 &p) const {
+    double x = p.x, y = p.y, z = p.z;
+    double e = A2 * x * x + 2 * AB * x * y + 2 * AC * x * z + 2 * AD * x +
+               B2 * y * y + 2 * BC * y * z + 2 * BD * y + C2 * z * z +
+               2 * CD * z + D2;
+    return Weight > 0 ? std::max(e, 0.0) / Weight : 0.0;
+  }
+};
+
+class Simplifier {
+public:
+  Simplifier(const std::vector<uint32> &indices, const void *vertices,
+             size_t vertexCount, size_t vertexStride)
+      : bytes(static_cast<const std::uint8_t *>(vertices)),
+        stride(vertexStride), quadrics(vertexCount), locked(vertexCount, 0),
+        stamp(vertexCount, 0), dirty(vertexCount, 0) {
+    WeldAndLock(indices);
+    ComputeQuadrics();
+  }
+
+  const std::vector<uint32> &Indices() const { return indices; }
+  float Error() const { return (float)std::sqrt(maxError); }
+
+  // Collapses edges, cheapest first, until at most targetTriangles remain or
+  // nothing more can be collapsed.
+  void Simplify(size_t targetTriangles) {
+    while (indices.size() / 3 > targetTriangles) {
+      if (!CollapsePass(targetTriangles)) {
+        break;
+      }
+    }
+  }
+
+private:
+  struct Collapse {
+    uint32 From;
+    uint32 To;
+    double Cost;
+  };
+
+  const XMFLOAT3 &Position(uint32 v) const {
+    return *reinterpret_cast<const XMFLOAT3 *>(bytes + v * stride);
+  }
+
+  // Redirects vertices that are byte-identical copies of each other to one
+  // of them, and locks vertices on attribute seams and open borders.
+  void WeldAndLock(const std::vector<uint32> &source) {
+    const auto vertexCount = (uint32)quadrics.size();
+
+    std::vector<uint32> order(vertexCount);
+    for (uint32 v = 0; v < vertexCount; v++) {
+      order[v] = v;
+    }
+    auto positionLess = [&](uint32 a, uint32 b) {
+      int c = std::memcmp(&Position(a), &Position(b), sizeof(XMFLOAT3));
+      return c != 0 ? c < 0 : a < b;
+    };
+    std::sort(order.begin(), order.end(), positionLess);
+
+    // group[v] is the lowest vertex sharing v's position; canon[v] is the
+    // vertex v is replaced with.
+    std::vector<uint32> group(vertexCount), canon(vertexCount);
+    for (size_t begin = 0; begin < order.size();) {
+      size_t end = begin + 1;
+      while (end < order.size() &&
+             std::memcmp(&Position(order[begin]), &Position(order[end]),
+                         sizeof(XMFLOAT3)) == 0) {
+        end++;
+      }
+
+      const auto first = order[begin];
+      bool seam = false;
+      for (size_t i = begin + 1; i < end; i++) {
+        seam |= std::memcmp(bytes + first * stride,
+                            bytes + order[i] * stride, stride) != 0;
+      }
+      for (size_t i = begin; i < end; i++) {
+        group[order[i]] = first;
+        canon[order[i]] = seam ? order[i] : first;
+        locked[order[i]] = seam;
+      }
+      begin = end;
+    }
+
+    indices.reserve(source.size());
+    for (size_t i = 0; i + 2 < source.size(); i += 3) {
+      uint32 a = canon[source[i]], b = canon[source[i + 1]],
+             c = canon[source[i + 2]];
+      if (a != b && b != c && c != a) {
+        indices.insert(indices.end(), {a, b, c});
+      }
+    }
+
+    // Edges between position groups used by anything but exactly two
+    // triangles are open borders or non-manifold; pin their vertices.
+    std::vector<std::uint64_t> edges;
+    edges.reserve(indices.size());
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      for (int k = 0; k < 3; k++) {
+        std::uint64_t a = group[indices[i + k]];
+        std::uint64_t b = group[indices[i + (k + 1) % 3]];
+        edges.push_back(a < b ? (a << 32) | b : (b << 32) | a);
+      }
+    }
+    std::sort(edges.begin(), edges.end());
+
+    std::vector<std::uint8_t> lockedGroup(vertexCount, 0);
+    for (size_t begin = 0; begin < edges.size();) {
+      size_t end = begin + 1;
+      while (end < edges.size() && edges[end] == edges[begin]) {
+        end++;
+      }
+      if (end - begin != 2) {
+        lockedGroup[edges[begin] >> 32] = 1;
+        lockedGroup[edges[begin] & 0xffffffffu] = 1;
+      }
+      begin = end;
+    }
+    for (uint32 v = 0; v < vertexCount; v++) {
+      locked[v] |= lockedGroup[group[v]];
+    }
+  }
+
+  void ComputeQuadrics() {
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      XMVECTOR p0 = XMLoadFloat3(&Position(indices[i]));
+      XMVECTOR p1 = XMLoadFloat3(&Position(indices[i + 1]));
+      XMVECTOR p2 = XMLoadFloat3(&Position(indices[i + 2]));
+      XMVECTOR n = XMVector3Cross(p1 - p0, p2 - p0);
+
+      float length = XMVectorGetX(XMVector3Length(n));
+      if (length <= 0.0f) {
+        continue;
+      }
+      n = (1.0f / length) * n;
+
+      XMFLOAT3 normal;
+      XMStoreFloat3(&normal, n);
+      float d = -XMVectorGetX(XMVector3Dot(n, p0));
+      for (int k = 0; k < 3; k++) {
+        quadrics[indices[i + k]].AddPlane(normal.x, normal.y, normal.z, d,
+                                          0.5 * length);
+      }
+    }
+  }
+
+  void BuildAdjacency() {
+    const auto vertexCount = quadrics.size();
+    offsets.assign(vertexCount + 1, 0);
+    for (auto v : indices) {
+      offsets[v + 1]++;
+    }
+    for (size_t v = 0; v < vertexCount; v++) {
+      offsets[v + 1] += offsets[v];
+    }
+
+    triangles.resize(indices.size());
+    std::vector<uint32> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); i++) {
+      triangles[cursor[indices[i]]++] = (uint32)(i / 3);
+    }
+  }
+
+  bool Contains(uint32 t, uint32 v) const {
+    return indices[t * 3] == v || indices[t * 3 + 1] == v ||
+           indices[t * 3 + 2] == v;
+  }
+
+  // Topology and geometry checks for moving u onto v.  Returns the number of
+  // triangles the collapse removes, or 0 if it must not happen.
+  uint32 CheckCollapse(uint32 u, uint32 v) {
+    // Link condition: u and v may only share the neighbors of the triangles
+    // on their common edge, otherwise the collapse pinches the surface.
+    currentStamp++;
+    for (auto i = offsets[u]; i < offsets[u + 1]; i++) {
+      for (int k = 0; k < 3; k++) {
+        stamp[indices[triangles[i] * 3 + k]] = currentStamp;
+      }
+    }
+
+    uint32 shared = 0;
+    for (auto i = offsets[u]; i < offsets[u + 1]; i++) {
+      shared += Contains(triangles[i], v) ? 1 : 0;
+    }
+
+    uint32 common = 0;
+    const auto visited = ++currentStamp;
+    for (auto i = offsets[v]; i < offsets[v + 1]; i++) {
+      for (int k = 0; k < 3; k++) {
+        auto w = indices[triangles[i] * 3 + k];
+        if (w != u && w != v && stamp[w] == visited - 1) {
+          stamp[w] = visited;
+          common++;
+        }
+      }
+    }
+    if (shared == 0 || common != shared) {
+      return 0;
+    }
+
+    // The triangles that survive must not flip or collapse to slivers.
+    XMVECTOR target = XMLoadFloat3(&Position(v));
+    for (auto i = offsets[u]; i < offsets[u + 1]; i++) {
+      auto t = triangles[i];
+      if (Contains(t, v)) {
+        continue;
+      }
+
+      XMVECTOR p[3], q[3];
+      for (int k = 0; k < 3; k++) {
+        p[k] = XMLoadFloat3(&Position(indices[t * 3 + k]));
+        q[k] = indices[t * 3 + k] == u ? target : p[k];
+      }
+      XMVECTOR before = XMVector3Cross(p[1] - p[0], p[2] - p[0]);
+      XMVECTOR after = XMVector3Cross(q[1] - q[0], q[2] - q[0]);
+
+      float dot = XMVectorGetX(XMVector3Dot(before, after));
+      float lengths = XMVectorGetX(XMVector3Length(before)) *
+                      XMVectorGetX(XMVector3Length(after));
+      if (dot <= 0.01f * lengths || lengths <= 0.0f) {
+        return 0;
+      }
+    }
+
+    return shared;
+  }
+
+  bool CollapsePass(size_t targetTriangles) {
+    BuildAdjacency();
+
+    candidates.clear();
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      for (int k = 0; k < 3; k++) {
+        uint32 a = indices[i + k], b = indices[i + (k + 1) % 3];
+        for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}}) {
+          if (locked[from]) {
+            continue;
+          }
+          Quadric q = quadrics[from];
+          q += quadrics[to];
+          candidates.push_back({from, to, q.Evaluate(Position(to))});
+        }
+      }
+    }
+    if (candidates.empty()) {
+      return false;
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Collapse &a, const Collapse &b) {
+                return a.Cost < b.Cost;
+              });
+
+    // Collapses in one pass must not touch each other's triangles, so the
+    // adjacency and quadrics they were scored with stay valid.  That blocks
+    // many cheap collapses until the next pass, so the pass also stops at
+    // the cost of roughly as many candidates as it needs; otherwise the
+    // blocked cheap ones would be replaced by expensive ones.  Every edge is
+    // listed about four times (two directions, two triangles).
+    std::fill(dirty.begin(), dirty.end(), 0);
+    auto triangleCount = indices.size() / 3;
+    auto needed = (triangleCount - targetTriangles) / 2 + 1;
+    auto costLimit =
+        candidates[std::min(needed * 4, candidates.size() - 1)].Cost;
+    std::vector<std::pair<uint32, uint32>> collapses;
+
+    for (auto &c : candidates) {
+      if (triangleCount <= targetTriangles) {
+        break;
+      }
+      if (c.Cost > costLimit && !collapses.empty()) {
+        break;
+      }
+      if (dirty[c.From] || dirty[c.To]) {
+        continue;
+      }
+
+      auto removed = CheckCollapse(c.From, c.To);
+      if (removed == 0) {
+        continue;
+      }
+
+      collapses.push_back({c.From, c.To});
+      quadrics[c.To] += quadrics[c.From];
+      maxError = std::max(maxError, c.Cost);
+      triangleCount -= removed;
+
+      for (auto i = offsets[c.From]; i < offsets[c.From + 1]; i++) {
+        for (int k = 0; k < 3; k++) {
+          dirty[indices[triangles[i] * 3 + k]] = 1;
+        }
+      }
+    }
+
+    if (collapses.empty()) {
+      return false;
+    }
+
+    std::vector<uint32> remap(quadrics.size());
+    for (uint32 v = 0; v < remap.size(); v++) {
+      remap[v] = v;
+    }
+    for (auto [from, to] : collapses) {
+      remap[from] = to;
+    }
+
+    size_t write = 0;
+    for (size_t i = 0; i < indices.size(); i += 3) {
+      uint32 a = remap[indices[i]], b = remap[indices[i + 1]],
+             c = remap[indices[i + 2]];
+      if (a != b && b != c && c != a) {
+        indices[write++] = a;
+        indices[write++] = b;
+        indices[write++] = c;
+      }
+    }
+    indices.resize(write);
+    return true;
+  }
+
+  const std::uint8_t *bytes;
+  size_t stride;
+
+  std::vector<uint32> indices;
+  std::vector<Quadric> quadrics;
+  std::vector<std::uint8_t> locked;
+  double maxError = 0.0;
+
+  // Per-pass scratch.
+  std::vector<uint32> offsets;
+  std::vector<uint32> triangles;
+  std::vector<Collapse> candidates;
+  std::vector<uint32> stamp;
+  uint32 currentStamp = 0;
+  std::vector<std::uint8_t> dirty;
+};
+} // namespace
+
+std::vector<MeshSimplifier::Lod>
+MeshSimplifier::BuildLodChain(std::vector<uint32> &indices,
+                              const void *vertices, size_t vertexCount,
+                              size_t vertexStride,
+                              const std::vector<float> &ratios) {
+  std::vector<Lod> lods;
+  lods.push_back({0, (uint32)indices.size(), 0.0f});
+
+  const auto sourceTriangles = indices.size() / 3;
+  if (sourceTriangles == 0) {
+    return lods;
+  }
+
+  Simplifier simplifier(indices, vertices, vertexCount, vertexStride);
+
+  for (auto ratio : ratios) {
+    if (ratio >= 1.0f) {
+      continue;
+    }
+
+    simplifier.Simplify((size_t)(sourceTriangles * ratio));
+
+    // Stop once the mesh no longer shrinks meaningfully; a level that saves
+    // less than a tenth of the previous one is not worth the memory.
+    auto level = simplifier.Indices();
+    if (level.size() * 10 > lods.back().IndexCount * 9) {
+      break;
+    }
+
+    MeshOptimizer::OptimizeVertexCache(level, vertexCount);
+    lods.push_back(
+        {(uint32)indices.size(), (uint32)level.size(), simplifier.Error()});
+    indices.insert(indices.end(), level.begin(), level.end());
+  }
+
+  return lods;
+}
+
+std::vector<MeshSimplifier::Lod>
+MeshSimplifier::BuildLodChain(GeometryGenerator::MeshData &meshData,
+                              const std::vector<float> &ratios) {
+  return BuildLodChain(meshData.Vertices, meshData.Indices32, ratios);
+}
+
+std::string MeshSimplifier::LodName(const std::string &name, size_t level) {
+  return level == 0 ? name : name + "_lod" + std::to_string(level);
+}
+
+std::string MeshSimplifier::Describe(const std::string &name,
+                                     const std::vector<Lod> &lods) {
+  std::string description = name + ":";
+  for (size_t i = 0; i < lods.size(); i++) {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), " %s%u tris (err %.4f)",
+                  i == 0 ? "" : "/ ", lods[i].IndexCount / 3, lods[i].Error);
+    description += buffer;
+  }
+  return description + "\n";
+}
@@ -0,0 +1,65 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "geometry_generator.h"
+#include <string>
+#include <type_traits>
+
+// Quadric error metric simplifier producing LOD chains.  Edges are collapsed
+// onto one of their existing endpoints, so every level is just another index
+// list over the source vertices and can live in the same vertex buffer.
+class MeshSimplifier {
+public:
+  using uint32 = std::uint32_t;
+
+  struct Lod {
+    uint32 StartIndex = 0;
+    uint32 IndexCount = 0;
+    // Geometric error in mesh units: the largest RMS distance from a
+    // collapsed vertex to the surface it replaced.
+    float Error = 0.0f;
+  };
+
+  // Appends successively coarser levels to indices, each holding about
+  // ratio * source triangles.  Level 0 is the source list with no error.
+  // Vertices that share a position but differ in any other attribute, and
+  // open borders, are never moved, so the chain can stop early when a mesh
+  // runs out of collapsible vertices.  Positions must be the first XMFLOAT3
+  // of each vertex.
+  static std::vector<Lod>
+  BuildLodChain(std::vector<uint32> &indices, const void *vertices,
+                size_t vertexCount, size_t vertexStride,
+                const std::vector<float> &ratios = {1.0f, 0.5f, 0.25f,
+                                                    0.125f});
+
+  template <typename V>
+  static std::vector<Lod>
+  BuildLodChain(const std::vector<V> &vertices, std::vector<uint32> &indices,
+                const std::vector<float> &ratios = {1.0f, 0.5f, 0.25f,
+                                                    0.125f});
+
+  static std::vector<Lod>
+  BuildLodChain(GeometryGenerator::MeshData &meshData,
+                const std::vector<float> &ratios = {1.0f, 0.5f, 0.25f,
+                                                    0.125f});
+
+  // DrawArgs name of a level: "sphere", "sphere_lod1", ...
+  static std::string LodName(const std::string &name, size_t level);
+
+  static std::string Describe(const std::string &name,
+                              const std::vector<Lod> &lods);
+};
+
+template <typename V>
+inline std::vector<MeshSimplifier::Lod>
+MeshSimplifier::BuildLodChain(const std::vector<V> &vertices,
+                              std::vector<uint32> &indices,
+                              const std::vector<float> &ratios) {
+  static_assert(std::is_standard_layout_v<V>,
+                "Vertex must be standard layout with position first");
+  return BuildLodChain(indices, vertices.data(), vertices.size(), sizeof(V),
+                       ratios);
+}
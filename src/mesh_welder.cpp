@@ -0,0 +1,218 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "mesh_welder.h"
+#include "mesh_optimizer.h"
+#include <cmath>
+#include <cstring>
+
+using namespace DirectX;
+
+namespace {
+using uint32 = MeshWelder::uint32;
+
+// Bit pattern of a position with -0.0 folded into 0.0, so equal positions
+// always hash and compare equal.
+struct PositionKey {
+  uint32 Bits[3];
+
+  explicit PositionKey(const XMFLOAT3 &p) {
+    const float xyz[3] = {p.x + 0.0f, p.y + 0.0f, p.z + 0.0f};
+    std::memcpy(Bits, xyz, sizeof(Bits));
+  }
+
+  bool operator==(const PositionKey &rhs) const {
+    return Bits[0] == rhs.Bits[0] && Bits[1] == rhs.Bits[1] &&
+           Bits[2] == rhs.Bits[2];
+  }
+
+  size_t Hash() const {
+    std::uint64_t h = Bits[0];
+    h = h * 0x9E3779B97F4A7C15ull ^ Bits[1];
+    h = h * 0x9E3779B97F4A7C15ull ^ Bits[2];
+    h ^= h >> 29;
+    return (size_t)h;
+  }
+};
+
+// Open addressing tables are kept at most half full.
+size_t TableSize(size_t count) {
+  size_t tableSize = 1;
+  while (tableSize < count * 2) {
+    tableSize *= 2;
+  }
+  return tableSize;
+}
+
+size_t HashCombine(std::uint64_t a, std::uint64_t b, std::uint64_t c) {
+  std::uint64_t h = a;
+  h = h * 0x9E3779B97F4A7C15ull ^ b;
+  h = h * 0x9E3779B97F4A7C15ull ^ c;
+  h ^= h >> 29;
+  return (size_t)h;
+}
+
+bool operator==(const ObjParser::Index &a, const ObjParser::Index &b) {
+  return a.VertexIndex == b.VertexIndex && a.NormalIndex == b.NormalIndex &&
+         a.TexcoordIndex == b.TexcoordIndex;
+}
+
+// Maps every v record to the first one within epsilon of it, itself when
+// there is none.  Kept records are bucketed in a grid of epsilon sized cells,
+// so each lookup only visits the 27 cells around the position.
+std::vector<int> MergeNearbyPositions(const std::vector<float> &xyz,
+                                      float epsilon) {
+  struct Cell {
+    std::int64_t X, Y, Z;
+    bool operator==(const Cell &rhs) const {
+      return X == rhs.X && Y == rhs.Y && Z == rhs.Z;
+    }
+  };
+
+  auto count = xyz.size() / 3;
+  auto position = [&](size_t v) {
+    return XMLoadFloat3(reinterpret_cast<const XMFLOAT3 *>(&xyz[3 * v]));
+  };
+  auto cellOf = [&](size_t v) {
+    return Cell{(std::int64_t)std::floor(xyz[3 * v + 0] / epsilon),
+                (std::int64_t)std::floor(xyz[3 * v + 1] / epsilon),
+                (std::int64_t)std::floor(xyz[3 * v + 2] / epsilon)};
+  };
+
+  // The table holds the newest kept record of each cell, and next chains it
+  // to the older ones.
+  constexpr auto Empty = ~0u;
+  std::vector<uint32> table(TableSize(count), Empty);
+  std::vector<uint32> next(count, Empty);
+  auto head = [&](const Cell &cell) -> uint32 & {
+    auto mask = table.size() - 1;
+    auto slot = HashCombine(cell.X, cell.Y, cell.Z) & mask;
+    while (table[slot] != Empty && !(cellOf(table[slot]) == cell)) {
+      slot = (slot + 1) & mask;
+    }
+    return table[slot];
+  };
+
+  std::vector<int> representative(count);
+  auto epsilonSq = epsilon * epsilon;
+  for (size_t v = 0; v < count; v++) {
+    auto cell = cellOf(v);
+    XMVECTOR p = position(v);
+
+    auto found = Empty;
+    for (int n = 0; n < 27 && found == Empty; n++) {
+      Cell neighbor{cell.X + n % 3 - 1, cell.Y + n / 3 % 3 - 1,
+                    cell.Z + n / 9 - 1};
+      for (auto r = head(neighbor); r != Empty; r = next[r]) {
+        if (XMVectorGetX(XMVector3LengthSq(position(r) - p)) <= epsilonSq) {
+          found = r;
+          break;
+        }
+      }
+    }
+
+    if (found == Empty) {
+      auto &newest = head(cell);
+      next[v] = newest;
+      newest = (uint32)v;
+      found = (uint32)v;
+    }
+    representative[v] = (int)found;
+  }
+  return representative;
+}
+} // namespace
+
+void MeshWelder::WeldPositions(const XMFLOAT3 *positions, size_t vertexCount,
+                               size_t positionStride,
+                               const std::vector<uint32> &indices,
+                               std::vector<XMFLOAT3> &weldedPositions,
+                               std::vector<uint32> &weldedIndices) {
+  auto bytes = reinterpret_cast<const std::uint8_t *>(positions);
+  auto position = [&](size_t v) -> const XMFLOAT3 & {
+    return *reinterpret_cast<const XMFLOAT3 *>(bytes + v * positionStride);
+  };
+
+  // Open addressing table from position to its welded index.
+  constexpr auto Empty = ~0u;
+  size_t tableSize = TableSize(vertexCount);
+  std::vector<uint32> table(tableSize, Empty);
+
+  weldedPositions.clear();
+  std::vector<uint32> remap(vertexCount);
+  for (size_t v = 0; v < vertexCount; v++) {
+    PositionKey key(position(v));
+    size_t slot = key.Hash() & (tableSize - 1);
+    while (table[slot] != Empty &&
+           !(PositionKey(weldedPositions[table[slot]]) == key)) {
+      slot = (slot + 1) & (tableSize - 1);
+    }
+
+    if (table[slot] == Empty) {
+      table[slot] = (uint32)weldedPositions.size();
+      weldedPositions.push_back(position(v));
+    }
+    remap[v] = table[slot];
+  }
+
+  weldedIndices.resize(indices.size());
+  for (size_t i = 0; i < indices.size(); i++) {
+    weldedIndices[i] = remap[indices[i]];
+  }
+
+  // Welding changes which vertices neighbor each other in the cache, so the
+  // welded mesh gets its own order.
+  MeshOptimizer::OptimizeVertexCache(weldedIndices, weldedPositions.size());
+  MeshOptimizer::RemapVertices(
+      weldedPositions, MeshOptimizer::OptimizeVertexFetchRemap(
+                           weldedIndices, weldedPositions.size()));
+}
+
+void MeshWelder::WeldCorners(const ObjParser::Result &obj,
+                             const CornerWeldOptions &options,
+                             std::vector<ObjParser::Index> &vertices,
+                             std::vector<uint32> &indices) {
+  std::vector<int> representative;
+  if (options.PositionEpsilon > 0.0f) {
+    representative =
+        MergeNearbyPositions(obj.Vertices, options.PositionEpsilon);
+  }
+
+  // The tuple a corner is welded by.  Representatives map to themselves, so
+  // applying it to a welded vertex gives back that vertex's key.
+  auto keyOf = [&](ObjParser::Index corner) {
+    if (!representative.empty()) {
+      corner.VertexIndex = representative[corner.VertexIndex];
+    }
+    if (!options.KeepTexcoordSeams) {
+      corner.TexcoordIndex = -1;
+    }
+    return corner;
+  };
+
+  constexpr auto Empty = ~0u;
+  std::vector<uint32> table(TableSize(obj.Indices.size()), Empty);
+  auto mask = table.size() - 1;
+
+  vertices.clear();
+  indices.resize(obj.Indices.size());
+  for (size_t i = 0; i < obj.Indices.size(); i++) {
+    auto &corner = obj.Indices[i];
+    auto key = keyOf(corner);
+    auto slot = HashCombine((uint32)key.VertexIndex, (uint32)key.NormalIndex,
+                            (uint32)key.TexcoordIndex) &
+                mask;
+    while (table[slot] != Empty && !(keyOf(vertices[table[slot]]) == key)) {
+      slot = (slot + 1) & mask;
+    }
+
+    if (table[slot] == Empty) {
+      table[slot] = (uint32)vertices.size();
+      vertices.push_back({.VertexIndex = key.VertexIndex,
+                          .NormalIndex = corner.NormalIndex,
+                          .TexcoordIndex = corner.TexcoordIndex});
+    }
+    indices[i] = table[slot];
+  }
+}
@@ -0,0 +1,58 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "obj_parser.h"
+#include <DirectXMath.h>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+// Merges vertices that only differ in attributes a pass does not read, so the
+// pass fetches fewer vertices and reuses more of them.
+class MeshWelder {
+public:
+  using uint32 = std::uint32_t;
+
+  struct CornerWeldOptions {
+    // Positions closer than this share a vertex even when they come from
+    // different v records.  0 only merges corners that name the same record.
+    float PositionEpsilon = 0.0f;
+    // Whether corners with different vt records stay separate vertices, as
+    // they must along UV seams.
+    bool KeepTexcoordSeams = true;
+  };
+
+  // Gives every distinct (position, normal, texcoord) index tuple among the
+  // corners of obj one vertex, instead of one vertex per corner.  vertices
+  // receives the tuple each welded vertex stands for and indices one entry
+  // per corner.
+  static void WeldCorners(const ObjParser::Result &obj,
+                          const CornerWeldOptions &options,
+                          std::vector<ObjParser::Index> &vertices,
+                          std::vector<uint32> &indices);
+
+  // Builds a tightly packed position stream with one entry per distinct
+  // position and an index list into it, ready for depth-only passes.  The
+  // result is reordered for the vertex cache and fetch locality.
+  static void WeldPositions(const DirectX::XMFLOAT3 *positions,
+                            size_t vertexCount, size_t positionStride,
+                            const std::vector<uint32> &indices,
+                            std::vector<DirectX::XMFLOAT3> &weldedPositions,
+                            std::vector<uint32> &weldedIndices);
+
+  // V must start with its XMFLOAT3 position.
+  template <typename V>
+  static void WeldPositions(const std::vector<V> &vertices,
+                            const std::vector<uint32> &indices,
+                            std::vector<DirectX::XMFLOAT3> &weldedPositions,
+                            std::vector<uint32> &weldedIndices) {
+    static_assert(std::is_standard_layout_v<V>,
+                  "Vertex must be standard layout with position first");
+    WeldPositions(reinterpret_cast<const DirectX::XMFLOAT3 *>(vertices.data()),
+                  vertices.size(), sizeof(V), indices, weldedPositions,
+                  weldedIndices);
+  }
+};
@@ -0,0 +1,256 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "meshlet.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+
+namespace {
+using uint32 = std::uint32_t;
+
+void ComputeMeshletBounds(Meshlet &meshlet,
+                          const std::vector<uint32> &indices,
+                          uint32 firstIndex,
+                          const std::vector<uint32> &vertices,
+                          const std::uint8_t *positions,
+                          size_t positionStride) {
+  auto position = [&](uint32 v) {
+    return XMLoadFloat3(
+        reinterpret_cast<const XMFLOAT3 *>(positions + v * positionStride));
+  };
+
+  //
+  // Bounding sphere: centered on the AABB, radius to the farthest vertex.
+  //
+
+  XMVECTOR vMin = position(vertices[0]);
+  XMVECTOR vMax = vMin;
+  for (auto v : vertices) {
+    vMin = XMVectorMin(vMin, position(v));
+    vMax = XMVectorMax(vMax, position(v));
+  }
+  XMVECTOR center = 0.5f * (vMin + vMax);
+
+  float radius = 0.0f;
+  for (auto v : vertices) {
+    radius = std::max(radius,
+                      XMVectorGetX(XMVector3Length(position(v) - center)));
+  }
+
+  XMStoreFloat3(&meshlet.Center, center);
+  meshlet.Radius = radius;
+
+  //
+  // Normal cone: the axis is the average face normal, the spread is given by
+  // the face normal deviating most from it.
+  //
+
+  struct Face {
+    XMFLOAT3 Point;
+    XMFLOAT3 Normal;
+  };
+  std::vector<Face> faces;
+  faces.reserve(meshlet.IndexCount / 3);
+
+  XMVECTOR axis = XMVectorZero();
+  for (uint32 i = 0; i < meshlet.IndexCount; i += 3) {
+    const uint32 *tri = &indices[firstIndex + i];
+    XMVECTOR p0 = position(tri[0]);
+    XMVECTOR n =
+        XMVector3Cross(position(tri[1]) - p0, position(tri[2]) - p0);
+
+    // Degenerate triangles can face anywhere; leave them out of the cone.
+    if (XMVectorGetX(XMVector3LengthSq(n)) <= 0.0f) {
+      continue;
+    }
+    n = XMVector3Normalize(n);
+    axis += n;
+
+    Face face;
+    XMStoreFloat3(&face.Point, p0);
+    XMStoreFloat3(&face.Normal, n);
+    faces.push_back(face);
+  }
+
+  meshlet.ConeApex = meshlet.Center;
+  meshlet.ConeAxis = XMFLOAT3(0.0f, 0.0f, 0.0f);
+  meshlet.ConeCutoff = 1.0f;
+
+  if (faces.empty() || XMVectorGetX(XMVector3LengthSq(axis)) <= 0.0f) {
+    return;
+  }
+  axis = XMVector3Normalize(axis);
+
+  float minDot = 1.0f;
+  for (auto &face : faces) {
+    minDot = std::min(
+        minDot, XMVectorGetX(XMVector3Dot(XMLoadFloat3(&face.Normal), axis)));
+  }
+
+  // Wider than ~84 degrees: the cone test would almost never succeed.
+  if (minDot <= 0.1f) {
+    return;
+  }
+
+  // Move the apex back along the axis until every triangle plane is in front
+  // of it, so the test stays conservative for eyes close to the meshlet.
+  float maxT = 0.0f;
+  for (auto &face : faces) {
+    XMVECTOR n = XMLoadFloat3(&face.Normal);
+    float dc =
+        XMVectorGetX(XMVector3Dot(center - XMLoadFloat3(&face.Point), n));
+    float dn = XMVectorGetX(XMVector3Dot(axis, n));
+    maxT = std::max(maxT, dc / dn);
+  }
+
+  XMStoreFloat3(&meshlet.ConeApex, center - maxT * axis);
+  XMStoreFloat3(&meshlet.ConeAxis, axis);
+  meshlet.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+}
+} // namespace
+
+std::vector<Meshlet>
+MeshletBuilder::Build(const std::vector<uint32> &indices,
+                      const XMFLOAT3 *positions, size_t vertexCount,
+                      size_t positionStride, uint32 baseIndexLocation,
+                      uint32 maxVertices, uint32 maxTriangles) {
+  std::vector<Meshlet> meshlets;
+  const auto triangleCount = (uint32)(indices.size() / 3);
+  if (triangleCount == 0) {
+    return meshlets;
+  }
+
+  auto bytes = reinterpret_cast<const std::uint8_t *>(positions);
+
+  // Stamp of the meshlet each vertex was last added to, so membership checks
+  // need no clearing between meshlets.
+  constexpr auto NoMeshlet = ~0u;
+  std::vector<uint32> stamp(vertexCount, NoMeshlet);
+  std::vector<uint32> vertices;
+  vertices.reserve(maxVertices);
+
+  uint32 firstTriangle = 0;
+  auto flush = [&](uint32 endTriangle) {
+    Meshlet meshlet;
+    meshlet.StartIndexLocation = baseIndexLocation + firstTriangle * 3;
+    meshlet.IndexCount = (endTriangle - firstTriangle) * 3;
+    meshlet.VertexCount = (uint32)vertices.size();
+    ComputeMeshletBounds(meshlet, indices, firstTriangle * 3, vertices, bytes,
+                         positionStride);
+    meshlets.push_back(meshlet);
+
+    vertices.clear();
+    firstTriangle = endTriangle;
+  };
+
+  for (uint32 t = 0; t < triangleCount; t++) {
+    const uint32 *tri = &indices[t * 3];
+    const auto id = (uint32)meshlets.size();
+
+    uint32 newVertices = 0;
+    for (int k = 0; k < 3; k++) {
+      bool repeated =
+          (k > 0 && tri[k] == tri[0]) || (k > 1 && tri[k] == tri[1]);
+      if (stamp[tri[k]] != id && !repeated) {
+        newVertices++;
+      }
+    }
+
+    if (vertices.size() + newVertices > maxVertices ||
+        t - firstTriangle >= maxTriangles) {
+      flush(t);
+    }
+
+    const auto current = (uint32)meshlets.size();
+    for (int k = 0; k < 3; k++) {
+      if (stamp[tri[k]] != current) {
+        stamp[tri[k]] = current;
+        vertices.push_back(tri[k]);
+      }
+    }
+  }
+  flush(triangleCount);
+
+  return meshlets;
+}
+
+void ClusterCuller::ExtractFrustumPlanes(FXMMATRIX viewProj,
+                                         XMFLOAT4 planes[6]) {
+  XMFLOAT4X4 m;
+  XMStoreFloat4x4(&m, viewProj);
+
+  // Gribb/Hartmann for row vectors and a [0, 1] clip depth range.
+  auto column = [&](int c) {
+    return XMVectorSet(m.m[0][c], m.m[1][c], m.m[2][c], m.m[3][c]);
+  };
+  XMVECTOR c0 = column(0), c1 = column(1), c2 = column(2), c3 = column(3);
+
+  XMVECTOR p[6] = {
+      c3 + c0, // left
+      c3 - c0, // right
+      c3 + c1, // bottom
+      c3 - c1, // top
+      c2,      // near
+      c3 - c2, // far
+  };
+
+  for (int i = 0; i < 6; i++) {
+    float length = XMVectorGetX(XMVector3Length(p[i]));
+    XMStoreFloat4(&planes[i], (1.0f / length) * p[i]);
+  }
+}
+
+size_t ClusterCuller::Cull(const std::vector<Meshlet> &meshlets,
+                           FXMMATRIX world, const XMFLOAT4 planes[6],
+                           const XMFLOAT3 &eyePosW,
+                           std::vector<DrawRange> &visible) {
+  // Spheres scale by the largest axis scale of the world matrix.
+  float scale = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    scale = std::max(scale, XMVectorGetX(XMVector3Length(world.r[i])));
+  }
+
+  XMVECTOR eye = XMLoadFloat3(&eyePosW);
+  size_t survivors = 0;
+
+  for (auto &meshlet : meshlets) {
+    XMVECTOR center =
+        XMVector3TransformCoord(XMLoadFloat3(&meshlet.Center), world);
+    float radius = meshlet.Radius * scale;
+
+    bool culled = false;
+    for (int i = 0; i < 6 && !culled; i++) {
+      XMVECTOR plane = XMLoadFloat4(&planes[i]);
+      float distance =
+          XMVectorGetX(XMVector3Dot(plane, center)) + planes[i].w;
+      culled = distance < -radius;
+    }
+
+    if (!culled && meshlet.ConeCutoff < 1.0f) {
+      XMVECTOR apex =
+          XMVector3TransformCoord(XMLoadFloat3(&meshlet.ConeApex), world);
+      XMVECTOR axis = XMVector3Normalize(
+          XMVector3TransformNormal(XMLoadFloat3(&meshlet.ConeAxis), world));
+      XMVECTOR view = XMVector3Normalize(apex - eye);
+      culled = XMVectorGetX(XMVector3Dot(view, axis)) >= meshlet.ConeCutoff;
+    }
+
+    if (culled) {
+      continue;
+    }
+
+    survivors++;
+    if (!visible.empty() &&
+        visible.back().StartIndexLocation + visible.back().IndexCount ==
+            meshlet.StartIndexLocation) {
+      visible.back().IndexCount += meshlet.IndexCount;
+    } else {
+      visible.push_back({meshlet.StartIndexLocation, meshlet.IndexCount});
+    }
+  }
+
+  return survivors;
+}
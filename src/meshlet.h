@@ -0,0 +1,64 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <DirectXMath.h>
+#include <cstdint>
+#include <vector>
+
+// A contiguous run of triangles in a submesh's index range, small enough to
+// be culled as a unit.  Bounds are in the mesh's local space.
+struct Meshlet {
+  std::uint32_t StartIndexLocation = 0;
+  std::uint32_t IndexCount = 0;
+  std::uint32_t VertexCount = 0;
+
+  DirectX::XMFLOAT3 Center = {0.0f, 0.0f, 0.0f};
+  float Radius = 0.0f;
+
+  // Normal cone.  The meshlet is entirely backfacing when
+  // dot(normalize(ConeApex - eye), ConeAxis) >= ConeCutoff.
+  DirectX::XMFLOAT3 ConeApex = {0.0f, 0.0f, 0.0f};
+  DirectX::XMFLOAT3 ConeAxis = {0.0f, 0.0f, 0.0f};
+  float ConeCutoff = 1.0f;
+};
+
+class MeshletBuilder {
+public:
+  static constexpr std::uint32_t DefaultMaxVertices = 64;
+  static constexpr std::uint32_t DefaultMaxTriangles = 124;
+
+  // Splits the triangle list into meshlets in index order, so feed it a
+  // cache-optimized list.  StartIndexLocation of every meshlet is offset by
+  // baseIndexLocation so it can address the packed index buffer directly.
+  static std::vector<Meshlet>
+  Build(const std::vector<std::uint32_t> &indices,
+        const DirectX::XMFLOAT3 *positions, size_t vertexCount,
+        size_t positionStride, std::uint32_t baseIndexLocation = 0,
+        std::uint32_t maxVertices = DefaultMaxVertices,
+        std::uint32_t maxTriangles = DefaultMaxTriangles);
+};
+
+class ClusterCuller {
+public:
+  struct DrawRange {
+    std::uint32_t StartIndexLocation = 0;
+    std::uint32_t IndexCount = 0;
+  };
+
+  // Extracts the six world-space frustum planes from a view-projection matrix.
+  static void ExtractFrustumPlanes(DirectX::FXMMATRIX viewProj,
+                                   DirectX::XMFLOAT4 planes[6]);
+
+  // Tests every meshlet against the frustum and its normal cone against the
+  // eye, and appends the surviving meshlets to visible as index ranges.
+  // Adjacent ranges are merged so each run costs one draw.  Returns the
+  // number of meshlets that survived.
+  static size_t Cull(const std::vector<Meshlet> &meshlets,
+                     DirectX::FXMMATRIX world,
+                     const DirectX::XMFLOAT4 planes[6],
+                     const DirectX::XMFLOAT3 &eyePosW,
+                     std::vector<DrawRange> &visible);
+};
@@ -0,0 +1,317 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "obj_parser.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+enum Attribute { Position, Normal, Texcoord, AttributeCount };
+
+// Floats stored per record of each attribute.
+constexpr size_t Components[AttributeCount] = {3, 3, 2};
+
+// A triangle corner as read.  A negative OBJ index counts back from the last
+// record read so far, and how many records come before the chunk is unknown
+// until every chunk is parsed, so such indices are kept relative to the chunk
+// start and flagged in RelativeMask.
+struct Corner {
+  int Index[AttributeCount];
+  std::uint32_t Line;
+  std::uint8_t RelativeMask;
+};
+
+struct Chunk {
+  const char *Begin = nullptr;
+  const char *End = nullptr;
+
+  std::vector<float> Values[AttributeCount];
+  std::vector<Corner> Corners;
+  std::uint32_t Lines = 0;
+
+  // First problem found, by line within the chunk.
+  std::uint32_t ErrorLine = 0;
+  std::string Error;
+
+  // Records and corners of all earlier chunks, from the prefix sums.
+  size_t Base[AttributeCount] = {};
+  size_t CornerBase = 0;
+
+  size_t Count(Attribute attribute) const {
+    return Values[attribute].size() / Components[attribute];
+  }
+  void Fail(const char *message) {
+    if (Error.empty()) {
+      ErrorLine = Lines;
+      Error = message;
+    }
+  }
+};
+
+bool IsSpace(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+void SkipSpaces(const char *&p, const char *end) {
+  while (p < end && IsSpace(*p)) {
+    p++;
+  }
+}
+
+bool AtSeparator(const char *p, const char *end) {
+  return p == end || IsSpace(*p);
+}
+
+bool ParseFloat(const char *&p, const char *end, float &value) {
+  // from_chars is locale independent and correctly rounded, but does not
+  // take a leading plus.
+  if (p < end && *p == '+') {
+    p++;
+  }
+  auto [next, error] = std::from_chars(p, end, value);
+  if (error != std::errc() || !AtSeparator(next, end)) {
+    return false;
+  }
+  p = next;
+  return true;
+}
+
+bool ParseInt(const char *&p, const char *end, int &value) {
+  auto [next, error] = std::from_chars(p, end, value);
+  if (error != std::errc()) {
+    return false;
+  }
+  p = next;
+  return true;
+}
+
+// Reads up to count floats into values, padding with zeros after the first
+// required ones.  Values beyond count, such as a w or vertex colors, are
+// ignored.
+bool ReadValues(const char *p, const char *end, size_t count, size_t required,
+                std::vector<float> &values) {
+  for (size_t k = 0; k < count; k++) {
+    SkipSpaces(p, end);
+    float value = 0.0f;
+    if (p == end) {
+      if (k < required) {
+        return false;
+      }
+    } else if (!ParseFloat(p, end, value)) {
+      return false;
+    }
+    values.push_back(value);
+  }
+  return true;
+}
+
+// One v, v/vt, v//vn or v/vt/vn token; absent indices are left at 0.
+bool ReadCorner(const char *&p, const char *end, int raw[AttributeCount]) {
+  raw[Position] = raw[Normal] = raw[Texcoord] = 0;
+  if (!ParseInt(p, end, raw[Position])) {
+    return false;
+  }
+  if (p < end && *p == '/') {
+    p++;
+    if (p < end && *p != '/' && !ParseInt(p, end, raw[Texcoord])) {
+      return false;
+    }
+    if (p < end && *p == '/') {
+      p++;
+      if (!ParseInt(p, end, raw[Normal])) {
+        return false;
+      }
+    }
+  }
+  return AtSeparator(p, end);
+}
+
+void ReadFace(Chunk &chunk, const char *p, const char *end) {
+  Corner first, previous;
+  size_t cornerCount = 0;
+  for (;;) {
+    SkipSpaces(p, end);
+    if (p == end) {
+      break;
+    }
+
+    int raw[AttributeCount];
+    if (!ReadCorner(p, end, raw) || raw[Position] == 0) {
+      chunk.Fail("malformed face");
+      return;
+    }
+
+    Corner corner{.Index = {}, .Line = chunk.Lines, .RelativeMask = 0};
+    for (int a = 0; a < AttributeCount; a++) {
+      if (raw[a] > 0) {
+        corner.Index[a] = raw[a] - 1;
+      } else if (raw[a] < 0) {
+        corner.Index[a] = (int)chunk.Count((Attribute)a) + raw[a];
+        corner.RelativeMask |= 1 << a;
+      } else {
+        corner.Index[a] = -1;
+      }
+    }
+
+    // Polygons become a fan around their first corner.
+    if (cornerCount == 0) {
+      first = corner;
+    } else if (cornerCount >= 2) {
+      chunk.Corners.push_back(first);
+      chunk.Corners.push_back(previous);
+      chunk.Corners.push_back(corner);
+    }
+    previous = corner;
+    cornerCount++;
+  }
+
+  if (cornerCount < 3) {
+    chunk.Fail("face with fewer than three corners");
+  }
+}
+
+void ReadLine(Chunk &chunk, const char *p, const char *end) {
+  SkipSpaces(p, end);
+  auto keyEnd = p;
+  while (keyEnd < end && !IsSpace(*keyEnd)) {
+    keyEnd++;
+  }
+  std::string_view key(p, keyEnd - p);
+
+  bool valid = true;
+  if (key == "v") {
+    valid = ReadValues(keyEnd, end, 3, 3, chunk.Values[Position]);
+  } else if (key == "vn") {
+    valid = ReadValues(keyEnd, end, 3, 3, chunk.Values[Normal]);
+  } else if (key == "vt") {
+    valid = ReadValues(keyEnd, end, 2, 1, chunk.Values[Texcoord]);
+  } else if (key == "f") {
+    ReadFace(chunk, keyEnd, end);
+  }
+  if (!valid) {
+    chunk.Fail("malformed vertex attribute");
+  }
+}
+
+void ReadChunk(Chunk &chunk) {
+  auto p = chunk.Begin;
+  while (p < chunk.End && chunk.Error.empty()) {
+    auto lineEnd =
+        static_cast<const char *>(std::memchr(p, '\n', chunk.End - p));
+    if (!lineEnd) {
+      lineEnd = chunk.End;
+    }
+    chunk.Lines++;
+    ReadLine(chunk, p, lineEnd);
+    p = lineEnd < chunk.End ? lineEnd + 1 : chunk.End;
+  }
+}
+
+// Cuts text into chunks of about ChunkSize bytes, each ending after a line
+// break so no line is split.
+std::vector<Chunk> SplitChunks(const char *begin, const char *end) {
+  size_t size = end - begin;
+  size_t count = std::max<size_t>(1, size / ObjParser::ChunkSize);
+
+  std::vector<Chunk> chunks(count);
+  auto start = begin;
+  for (size_t i = 0; i < count; i++) {
+    auto stop = end;
+    if (i + 1 < count) {
+      stop = std::max(start, begin + size * (i + 1) / count);
+      stop = std::find(stop, end, '\n');
+      stop = stop < end ? stop + 1 : end;
+    }
+    chunks[i].Begin = start;
+    chunks[i].End = stop;
+    start = stop;
+  }
+  return chunks;
+}
+
+template <typename Body>
+void ForEachChunk(ThreadPool *pool, std::vector<Chunk> &chunks,
+                  const Body &body) {
+  if (pool && chunks.size() > 1) {
+    pool->ParallelFor(chunks.size(), [&](size_t i) { body(chunks[i]); });
+  } else {
+    for (auto &chunk : chunks) {
+      body(chunk);
+    }
+  }
+}
+
+// Throws the first error by position in the file.
+void ThrowFirstError(const std::vector<Chunk> &chunks) {
+  size_t line = 0;
+  for (auto &chunk : chunks) {
+    if (!chunk.Error.empty()) {
+      throw std::runtime_error("ObjParser: line " +
+                               std::to_string(line + chunk.ErrorLine) + ": " +
+                               chunk.Error);
+    }
+    line += chunk.Lines;
+  }
+}
+} // namespace
+
+ObjParser::Result ObjParser::Parse(std::span<const std::byte> text,
+                                   ThreadPool *pool) {
+  auto begin = reinterpret_cast<const char *>(text.data());
+  auto chunks = SplitChunks(begin, begin + text.size());
+
+  ForEachChunk(pool, chunks, ReadChunk);
+  ThrowFirstError(chunks);
+
+  // Exclusive prefix sums place every chunk's records and corners.
+  size_t totals[AttributeCount] = {};
+  size_t cornerTotal = 0;
+  for (auto &chunk : chunks) {
+    for (int a = 0; a < AttributeCount; a++) {
+      chunk.Base[a] = totals[a];
+      totals[a] += chunk.Count((Attribute)a);
+    }
+    chunk.CornerBase = cornerTotal;
+    cornerTotal += chunk.Corners.size();
+  }
+
+  Result result;
+  std::vector<float> *outputs[AttributeCount] = {
+      &result.Vertices, &result.Normals, &result.Texcoords};
+  for (int a = 0; a < AttributeCount; a++) {
+    outputs[a]->resize(totals[a] * Components[a]);
+  }
+  result.Indices.resize(cornerTotal);
+
+  ForEachChunk(pool, chunks, [&](Chunk &chunk) {
+    for (int a = 0; a < AttributeCount; a++) {
+      std::copy(chunk.Values[a].begin(), chunk.Values[a].end(),
+                outputs[a]->begin() + chunk.Base[a] * Components[a]);
+    }
+
+    auto out = result.Indices.begin() + chunk.CornerBase;
+    for (auto &corner : chunk.Corners) {
+      int resolved[AttributeCount];
+      for (int a = 0; a < AttributeCount; a++) {
+        bool relative = corner.RelativeMask & (1 << a);
+        resolved[a] = corner.Index[a] + (relative ? (int)chunk.Base[a] : 0);
+        bool absent = !relative && corner.Index[a] == -1;
+        if (!absent && (resolved[a] < 0 || resolved[a] >= (int)totals[a])) {
+          chunk.ErrorLine = corner.Line;
+          chunk.Error = "face index out of range";
+          return;
+        }
+      }
+      *out++ = {.VertexIndex = resolved[Position],
+                .NormalIndex = resolved[Normal],
+                .TexcoordIndex = resolved[Texcoord]};
+    }
+  });
+  ThrowFirstError(chunks);
+
+  return result;
+}
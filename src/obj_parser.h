@@ -0,0 +1,49 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "thread_pool.h"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+// Wavefront OBJ reader for v, vn, vt and f records; everything else (groups,
+// materials, smoothing groups) is skipped.  The text is cut into chunks that
+// end on line breaks, the chunks are parsed in parallel into local arrays,
+// and prefix sums over their counts give each one its place in the result.
+// The output follows tinyobj's attrib layout, with faces split into fans of
+// triangles.
+//
+//   MappedFile file;
+//   file.Open(path);
+//   auto obj = ObjParser::Parse(file.Bytes(), &ThreadPool::Shared());
+//   for (auto &index : obj.Indices) {
+//     ... obj.Vertices[3 * index.VertexIndex + 0] ...
+//   }
+class ObjParser {
+public:
+  // Zero-based attribute indices of one triangle corner; -1 when the face
+  // does not reference that attribute.
+  struct Index {
+    int VertexIndex = -1;
+    int NormalIndex = -1;
+    int TexcoordIndex = -1;
+  };
+
+  struct Result {
+    std::vector<float> Vertices;  // x, y, z of each v record.
+    std::vector<float> Normals;   // x, y, z of each vn record.
+    std::vector<float> Texcoords; // u, v of each vt record.
+    std::vector<Index> Indices;   // Three per triangle.
+  };
+
+  // Bytes of text per chunk.  Smaller inputs are parsed as a single chunk.
+  static constexpr size_t ChunkSize = 256 * 1024;
+
+  // Parses text, serially when pool is null.  Throws std::runtime_error,
+  // naming the line, on a malformed record or an index out of range.
+  static Result Parse(std::span<const std::byte> text,
+                      ThreadPool *pool = nullptr);
+};
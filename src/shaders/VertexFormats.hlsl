@@ -0,0 +1,36 @@
+// Decoders for the vertex formats selected by PACKED_VERTICES, see
+// vertex_formats.h.  The input assembler already expands UNORM, SNORM and
+// half floats, so only the bounds and the octahedral mapping remain.
+
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 0
+#endif
+
+#if PACKED_VERTICES
+#define VERTEX_POSITION float4
+#define VERTEX_DIRECTION float2
+#define VERTEX_TEXCOORD float2
+#else
+#define VERTEX_POSITION float3
+#define VERTEX_DIRECTION float3
+#define VERTEX_TEXCOORD float2
+#endif
+
+float3 OctahedralDecode(float2 e) {
+  float3 n = float3(e.x, e.y, 1.0f - abs(e.x) - abs(e.y));
+  float t = saturate(-n.z);
+  n.xy += (n.xy >= 0.0f) ? -t : t;
+  return normalize(n);
+}
+
+float3 DecodePosition(float4 unorm, float3 boundsMin, float3 boundsExtent) {
+  return boundsMin + unorm.xyz * boundsExtent;
+}
+
+float3 DecodePosition(float3 position, float3 boundsMin, float3 boundsExtent) {
+  return position;
+}
+
+float3 DecodeDirection(float2 octahedral) { return OctahedralDecode(octahedral); }
+
+float3 DecodeDirection(float3 direction) { return direction; }
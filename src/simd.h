@@ -0,0 +1,140 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define SIMD_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) ||                                 \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMD_SSE 1
+#endif
+
+// The widest float vector the target was compiled for: 8 lanes with AVX
+// (/arch:AVX, -mavx), 4 with SSE2, which every x64 target has, and a single
+// lane elsewhere.  Kernels written against it run on SoA arrays padded to a
+// multiple of Simd::Width, so they never need a remainder loop.
+//
+// Comparisons return lane masks as a Simd::Float whose lanes are all ones or
+// all zeros, for Select.
+//
+// Each operation rounds once, like the scalar expression it replaces, so a
+// kernel matches its scalar reference bit for bit as long as the compiler
+// does not fuse multiplies and adds on either side.  GCC and Clang may, so
+// xmake.lua builds with -ffp-contract=off.
+namespace Simd {
+#if SIMD_AVX
+constexpr size_t Width = 8;
+struct Float {
+  __m256 V;
+};
+inline Float Load(const float *p) { return {_mm256_loadu_ps(p)}; }
+inline void Store(float *p, Float a) { _mm256_storeu_ps(p, a.V); }
+inline Float Set(float a) { return {_mm256_set1_ps(a)}; }
+inline Float operator+(Float a, Float b) { return {_mm256_add_ps(a.V, b.V)}; }
+inline Float operator-(Float a, Float b) { return {_mm256_sub_ps(a.V, b.V)}; }
+inline Float operator*(Float a, Float b) { return {_mm256_mul_ps(a.V, b.V)}; }
+inline Float operator/(Float a, Float b) { return {_mm256_div_ps(a.V, b.V)}; }
+inline Float Min(Float a, Float b) { return {_mm256_min_ps(a.V, b.V)}; }
+inline Float Max(Float a, Float b) { return {_mm256_max_ps(a.V, b.V)}; }
+inline Float Sqrt(Float a) { return {_mm256_sqrt_ps(a.V)}; }
+inline Float Greater(Float a, Float b) {
+  return {_mm256_cmp_ps(a.V, b.V, _CMP_GT_OQ)};
+}
+inline Float Less(Float a, Float b) {
+  return {_mm256_cmp_ps(a.V, b.V, _CMP_LT_OQ)};
+}
+inline Float And(Float a, Float b) { return {_mm256_and_ps(a.V, b.V)}; }
+inline Float Or(Float a, Float b) { return {_mm256_or_ps(a.V, b.V)}; }
+// Lanes of b where mask is set, of a elsewhere.
+inline Float Select(Float a, Float b, Float mask) {
+  return {_mm256_blendv_ps(a.V, b.V, mask.V)};
+}
+inline bool Any(Float mask) { return _mm256_movemask_ps(mask.V) != 0; }
+#elif SIMD_SSE
+constexpr size_t Width = 4;
+struct Float {
+  __m128 V;
+};
+inline Float Load(const float *p) { return {_mm_loadu_ps(p)}; }
+inline void Store(float *p, Float a) { _mm_storeu_ps(p, a.V); }
+inline Float Set(float a) { return {_mm_set1_ps(a)}; }
+inline Float operator+(Float a, Float b) { return {_mm_add_ps(a.V, b.V)}; }
+inline Float operator-(Float a, Float b) { return {_mm_sub_ps(a.V, b.V)}; }
+inline Float operator*(Float a, Float b) { return {_mm_mul_ps(a.V, b.V)}; }
+inline Float operator/(Float a, Float b) { return {_mm_div_ps(a.V, b.V)}; }
+inline Float Min(Float a, Float b) { return {_mm_min_ps(a.V, b.V)}; }
+inline Float Max(Float a, Float b) { return {_mm_max_ps(a.V, b.V)}; }
+inline Float Sqrt(Float a) { return {_mm_sqrt_ps(a.V)}; }
+inline Float Greater(Float a, Float b) { return {_mm_cmpgt_ps(a.V, b.V)}; }
+inline Float Less(Float a, Float b) { return {_mm_cmplt_ps(a.V, b.V)}; }
+inline Float And(Float a, Float b) { return {_mm_and_ps(a.V, b.V)}; }
+inline Float Or(Float a, Float b) { return {_mm_or_ps(a.V, b.V)}; }
+inline Float Select(Float a, Float b, Float mask) {
+  return {_mm_or_ps(_mm_and_ps(mask.V, b.V), _mm_andnot_ps(mask.V, a.V))};
+}
+inline bool Any(Float mask) { return _mm_movemask_ps(mask.V) != 0; }
+#else
+constexpr size_t Width = 1;
+struct Float {
+  float V;
+};
+inline Float Load(const float *p) { return {*p}; }
+inline void Store(float *p, Float a) { *p = a.V; }
+inline Float Set(float a) { return {a}; }
+inline Float operator+(Float a, Float b) { return {a.V + b.V}; }
+inline Float operator-(Float a, Float b) { return {a.V - b.V}; }
+inline Float operator*(Float a, Float b) { return {a.V * b.V}; }
+inline Float operator/(Float a, Float b) { return {a.V / b.V}; }
+inline Float Min(Float a, Float b) { return {a.V < b.V ? a.V : b.V}; }
+inline Float Max(Float a, Float b) { return {a.V > b.V ? a.V : b.V}; }
+inline Float Sqrt(Float a) { return {std::sqrt(a.V)}; }
+// The scalar masks only ever feed Select and Any, so 1 and 0 stand in for
+// the bit patterns.
+inline Float Greater(Float a, Float b) { return {a.V > b.V ? 1.0f : 0.0f}; }
+inline Float Less(Float a, Float b) { return {a.V < b.V ? 1.0f : 0.0f}; }
+inline Float And(Float a, Float b) { return {a.V * b.V}; }
+inline Float Or(Float a, Float b) { return {a.V + b.V > 0.0f ? 1.0f : 0.0f}; }
+inline Float Select(Float a, Float b, Float mask) {
+  return {mask.V != 0.0f ? b.V : a.V};
+}
+inline bool Any(Float mask) { return mask.V != 0.0f; }
+#endif
+
+// values[indices[k]] in lane k, for the scattered reads of constraint and
+// collision kernels.
+inline Float Gather(const float *values, const std::uint32_t *indices) {
+#if SIMD_AVX && defined(__AVX2__)
+  auto offsets = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(indices));
+  return {_mm256_i32gather_ps(values, offsets, 4)};
+#else
+  alignas(32) float lanes[Width];
+  for (size_t k = 0; k < Width; k++) {
+    lanes[k] = values[indices[k]];
+  }
+  return Load(lanes);
+#endif
+}
+
+// Writes lane k to values[indices[k]].  The indices must be distinct, or
+// which lane wins is unspecified.
+inline void Scatter(float *values, const std::uint32_t *indices, Float a) {
+  alignas(32) float lanes[Width];
+  Store(lanes, a);
+  for (size_t k = 0; k < Width; k++) {
+    values[indices[k]] = lanes[k];
+  }
+}
+
+// Rounds count up to a whole number of vectors.
+constexpr size_t Padded(size_t count) {
+  return (count + Width - 1) / Width * Width;
+}
+} // namespace Simd
@@ -0,0 +1,111 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "spatial_hash.h"
+#include <algorithm>
+
+using namespace DirectX;
+
+SpatialHash::SpatialHash(float cellSize) {
+  SetCellSize(cellSize);
+  Reserve(0);
+}
+
+void SpatialHash::SetCellSize(float cellSize) {
+  Size = cellSize;
+  InverseSize = 1.0f / cellSize;
+}
+
+void SpatialHash::BuildPoints(const float *x, const float *y, const float *z,
+                              size_t count, ThreadPool *pool) {
+  Reserve(count);
+  auto hashRange = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      EntrySlot[i] = SlotOf(CellOf(x[i], y[i], z[i]));
+      EntryItem[i] = (uint32)i;
+    }
+  };
+  if (pool && count > ParallelGrainSize) {
+    pool->ParallelForRange(count, ParallelGrainSize, hashRange);
+  } else {
+    hashRange(0, count);
+  }
+  Sort(count);
+}
+
+void SpatialHash::BuildBoxes(std::span<const XMFLOAT3> minimums,
+                             std::span<const XMFLOAT3> maximums) {
+  auto cellRange = [&](size_t i, Cell &first, Cell &last) {
+    first = CellOf(minimums[i].x, minimums[i].y, minimums[i].z);
+    last = CellOf(maximums[i].x, maximums[i].y, maximums[i].z);
+  };
+
+  size_t entryCount = 0;
+  for (size_t i = 0; i < minimums.size(); i++) {
+    Cell first, last;
+    cellRange(i, first, last);
+    entryCount += (size_t)(last.X - first.X + 1) * (last.Y - first.Y + 1) *
+                  (last.Z - first.Z + 1);
+  }
+
+  Reserve(entryCount);
+  size_t e = 0;
+  for (size_t i = 0; i < minimums.size(); i++) {
+    Cell first, last;
+    cellRange(i, first, last);
+    for (int z = first.Z; z <= last.Z; z++) {
+      for (int y = first.Y; y <= last.Y; y++) {
+        for (int x = first.X; x <= last.X; x++) {
+          EntrySlot[e] = SlotOf({x, y, z});
+          EntryItem[e] = (uint32)i;
+          e++;
+        }
+      }
+    }
+  }
+  Sort(entryCount);
+}
+
+std::span<const SpatialHash::uint32> SpatialHash::Items(Cell cell) const {
+  auto slot = SlotOf(cell);
+  return {Entries.data() + SlotStart[slot],
+          (size_t)(SlotStart[slot + 1] - SlotStart[slot])};
+}
+
+void SpatialHash::Reserve(size_t entryCount) {
+  // About two slots per entry keeps collisions rare; sizing by items would
+  // crowd the cells of large boxes into few slots.  The arrays only grow,
+  // so a cloth that settles stops allocating.
+  size_t tableSize = 1;
+  while (tableSize < 2 * entryCount) {
+    tableSize *= 2;
+  }
+  if (tableSize + 1 > SlotStart.size()) {
+    SlotStart.resize(tableSize + 1);
+    SlotMask = (uint32)(tableSize - 1);
+  }
+  if (entryCount > Entries.size()) {
+    Entries.resize(entryCount);
+    EntrySlot.resize(entryCount);
+    EntryItem.resize(entryCount);
+  }
+}
+
+void SpatialHash::Sort(size_t entryCount) {
+  // Inclusive prefix sums of the slot sizes put each slot's end in its own
+  // element; filling back to front then walks every element down to its
+  // slot's start, keeping the items of a slot in insertion order.
+  auto tableSize = SlotStart.size() - 1;
+  std::fill(SlotStart.begin(), SlotStart.end(), 0);
+  for (size_t e = 0; e < entryCount; e++) {
+    SlotStart[EntrySlot[e]]++;
+  }
+  for (size_t s = 1; s < tableSize; s++) {
+    SlotStart[s] += SlotStart[s - 1];
+  }
+  SlotStart[tableSize] = (uint32)entryCount;
+  for (size_t e = entryCount; e-- > 0;) {
+    Entries[--SlotStart[EntrySlot[e]]] = EntryItem[e];
+  }
+}
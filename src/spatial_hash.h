@@ -0,0 +1,111 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include "thread_pool.h"
+#include <DirectXMath.h>
+#include <cmath>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Uniform grid over unbounded space, hashed into a table of slots and
+// rebuilt from scratch whenever the items move.  A build is a counting
+// sort of the items by slot into one flat array, so a slot's items are
+// contiguous and no per cell containers exist.  The arrays only ever grow:
+// once they have reached the working size, rebuilding allocates nothing.
+//
+// Distinct cells can share a slot, so what a slot holds is a superset of
+// what its cell holds and callers test the candidates themselves.
+//
+//   hash.BuildPoints(x, y, z, count);
+//   hash.ForEachNear(hash.CellOf(x[i], y[i], z[i]), [&](uint32 j) { ... });
+class SpatialHash {
+public:
+  using uint32 = std::uint32_t;
+
+  struct Cell {
+    int X, Y, Z;
+  };
+
+  explicit SpatialHash(float cellSize = 1.0f);
+
+  float CellSize() const { return Size; }
+  void SetCellSize(float cellSize);
+
+  Cell CellOf(float x, float y, float z) const {
+    return {(int)std::floor(x * InverseSize), (int)std::floor(y * InverseSize),
+            (int)std::floor(z * InverseSize)};
+  }
+
+  // Item i goes into the cell of point (x[i], y[i], z[i]).
+  void BuildPoints(const float *x, const float *y, const float *z,
+                   size_t count, ThreadPool *pool = nullptr);
+
+  // Item i goes into every cell its box overlaps.  When two of those cells
+  // share a slot, the item is in the slot twice.
+  void BuildBoxes(std::span<const DirectX::XMFLOAT3> minimums,
+                  std::span<const DirectX::XMFLOAT3> maximums);
+
+  // The items in cell's slot.
+  std::span<const uint32> Items(Cell cell) const;
+
+  // Calls visit(item) for the items in the 3x3x3 cells around cell,
+  // visiting a slot shared by several of those cells once.
+  template <typename Visit> void ForEachNear(Cell cell, Visit &&visit) const;
+
+  static constexpr size_t ParallelGrainSize = 4096;
+
+private:
+  uint32 SlotOf(Cell cell) const;
+  // Sizes the table and the arrays for entryCount entries.
+  void Reserve(size_t entryCount);
+  // Counting sort of the first entryCount EntrySlot/EntryItem pairs.
+  void Sort(size_t entryCount);
+
+  float Size = 1.0f;
+  float InverseSize = 1.0f;
+
+  // Items of slot s are Entries[SlotStart[s]..SlotStart[s + 1]).
+  std::vector<uint32> SlotStart;
+  uint32 SlotMask = 0;
+  std::vector<uint32> Entries;
+
+  // Scratch of a build, one element per insertion.
+  std::vector<uint32> EntrySlot;
+  std::vector<uint32> EntryItem;
+};
+
+inline SpatialHash::uint32 SpatialHash::SlotOf(Cell cell) const {
+  // The primes of Teschner et al., "Optimized Spatial Hashing for Collision
+  // Detection of Deformable Objects".  The table size is a power of two.
+  auto hash = (uint32)cell.X * 73856093u ^ (uint32)cell.Y * 19349663u ^
+              (uint32)cell.Z * 83492791u;
+  return hash & SlotMask;
+}
+
+template <typename Visit>
+void SpatialHash::ForEachNear(Cell cell, Visit &&visit) const {
+  uint32 visited[27];
+  int visitedCount = 0;
+  for (int dz = -1; dz <= 1; dz++) {
+    for (int dy = -1; dy <= 1; dy++) {
+      for (int dx = -1; dx <= 1; dx++) {
+        auto slot = SlotOf({cell.X + dx, cell.Y + dy, cell.Z + dz});
+        bool seen = false;
+        for (int k = 0; k < visitedCount && !seen; k++) {
+          seen = visited[k] == slot;
+        }
+        if (seen) {
+          continue;
+        }
+        visited[visitedCount++] = slot;
+        for (auto e = SlotStart[slot]; e < SlotStart[slot + 1]; e++) {
+          visit(Entries[e]);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,144 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+
+namespace {
+// State of one ParallelFor call.  Helpers that start after the work ran out
+// still touch it, so it is shared rather than living on the caller's stack.
+struct ParallelForState {
+  std::function<void(size_t)> Task;
+  size_t Count = 0;
+  std::atomic<size_t> Next = 0;
+  std::atomic<size_t> Remaining = 0;
+
+  std::mutex Mutex;
+  std::condition_variable Finished;
+  std::exception_ptr Error;
+
+  // Claims and runs indices until none are left.
+  void Work() {
+    for (;;) {
+      size_t i = Next.fetch_add(1);
+      if (i >= Count) {
+        return;
+      }
+
+      try {
+        Task(i);
+      } catch (...) {
+        std::lock_guard lock(Mutex);
+        if (!Error) {
+          Error = std::current_exception();
+        }
+      }
+
+      if (Remaining.fetch_sub(1) == 1) {
+        std::lock_guard lock(Mutex);
+        Finished.notify_all();
+      }
+    }
+  }
+};
+} // namespace
+
+ThreadPool::ThreadPool(size_t threadCount) {
+  if (threadCount == 0) {
+    auto hardware = std::thread::hardware_concurrency();
+    threadCount = hardware > 1 ? hardware - 1 : 1;
+  }
+
+  Workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; i++) {
+    Workers.emplace_back([this]() { WorkerLoop(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard lock(Mutex);
+    Stopping = true;
+  }
+  JobAvailable.notify_all();
+
+  for (auto &worker : Workers) {
+    worker.join();
+  }
+}
+
+ThreadPool &ThreadPool::Shared() {
+  static ThreadPool pool;
+  return pool;
+}
+
+void ThreadPool::ParallelFor(size_t count,
+                             const std::function<void(size_t)> &task) {
+  if (count == 0) {
+    return;
+  }
+  if (count == 1 || Workers.empty()) {
+    for (size_t i = 0; i < count; i++) {
+      task(i);
+    }
+    return;
+  }
+
+  auto state = std::make_shared<ParallelForState>();
+  state->Task = task;
+  state->Count = count;
+  state->Remaining = count;
+
+  auto helpers = std::min(Workers.size(), count - 1);
+  for (size_t i = 0; i < helpers; i++) {
+    Enqueue([state]() { state->Work(); });
+  }
+  state->Work();
+
+  {
+    std::unique_lock lock(state->Mutex);
+    state->Finished.wait(lock, [&]() { return state->Remaining == 0; });
+  }
+
+  if (state->Error) {
+    std::rethrow_exception(state->Error);
+  }
+}
+
+void ThreadPool::ParallelForRange(
+    size_t count, size_t grainSize,
+    const std::function<void(size_t, size_t)> &task) {
+  grainSize = std::max<size_t>(grainSize, 1);
+  const auto chunks = (count + grainSize - 1) / grainSize;
+  ParallelFor(chunks, [&](size_t chunk) {
+    auto begin = chunk * grainSize;
+    task(begin, std::min(begin + grainSize, count));
+  });
+}
+
+void ThreadPool::Enqueue(std::function<void()> job) {
+  {
+    std::lock_guard lock(Mutex);
+    Jobs.push_back(std::move(job));
+  }
+  JobAvailable.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+  for (;;) {
+    std::function<void()> job;
+    {
+      std::unique_lock lock(Mutex);
+      JobAvailable.wait(lock, [this]() { return Stopping || !Jobs.empty(); });
+      if (Stopping && Jobs.empty()) {
+        return;
+      }
+      job = std::move(Jobs.front());
+      Jobs.pop_front();
+    }
+    job();
+  }
+}
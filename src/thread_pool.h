@@ -0,0 +1,63 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+// Fixed set of worker threads shared by the CPU side jobs (geometry
+// generation, mesh loading, cloth).  ParallelFor lets the calling thread take
+// part, so it may be called from inside a task without deadlocking.
+class ThreadPool {
+public:
+  // threadCount workers; 0 picks one less than the hardware threads, since
+  // the thread calling ParallelFor works too.
+  explicit ThreadPool(size_t threadCount = 0);
+  ThreadPool(const ThreadPool &rhs) = delete;
+  ThreadPool &operator=(const ThreadPool &rhs) = delete;
+  ~ThreadPool();
+
+  static ThreadPool &Shared();
+
+  size_t ThreadCount() const { return Workers.size(); }
+
+  // Runs task(i) for every i in [0, count) and returns once all are done.
+  // The first exception thrown by a task is rethrown here.
+  void ParallelFor(size_t count, const std::function<void(size_t)> &task);
+
+  // Runs task(begin, end) over consecutive ranges of at most grainSize.
+  void ParallelForRange(size_t count, size_t grainSize,
+                        const std::function<void(size_t, size_t)> &task);
+
+  template <typename F> auto Submit(F &&task) -> std::future<decltype(task())>;
+
+private:
+  void Enqueue(std::function<void()> job);
+  void WorkerLoop();
+
+  std::vector<std::thread> Workers;
+  std::deque<std::function<void()>> Jobs;
+  std::mutex Mutex;
+  std::condition_variable JobAvailable;
+  bool Stopping = false;
+};
+
+template <typename F>
+auto ThreadPool::Submit(F &&task) -> std::future<decltype(task())> {
+  using Result = decltype(task());
+  auto packaged =
+      std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+  auto future = packaged->get_future();
+  Enqueue([packaged]() { (*packaged)(); });
+  return future;
+}
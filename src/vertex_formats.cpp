@@ -0,0 +1,102 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#include "vertex_formats.h"
+#include "mesh_bounds.h"
+#include <algorithm>
+#include <cmath>
+
+using namespace DirectX;
+using namespace DirectX::PackedVector;
+
+const D3D_SHADER_MACRO *VertexFormats::ShaderDefines() {
+#if PACKED_VERTICES
+  static const D3D_SHADER_MACRO defines[] = {{"PACKED_VERTICES", "1"},
+                                             {nullptr, nullptr}};
+  return defines;
+#else
+  return nullptr;
+#endif
+}
+
+PositionQuantization
+VertexFormats::ComputeQuantization(const XMFLOAT3 *positions, size_t count,
+                                   size_t positionStride) {
+  PositionQuantization quantization;
+  if (count == 0) {
+    return quantization;
+  }
+
+  XMFLOAT3 min, max;
+  MeshBounds::ComputeRange(positions, count, positionStride, min, max);
+  quantization.Min = min;
+  quantization.Extent = {max.x - min.x, max.y - min.y, max.z - min.z};
+  return quantization;
+}
+
+void VertexFormats::EncodePosition(XMFLOAT3 &out, const XMFLOAT3 &position,
+                                   const PositionQuantization &) {
+  out = position;
+}
+
+void VertexFormats::EncodePosition(XMUSHORTN4 &out, const XMFLOAT3 &position,
+                                   const PositionQuantization &quantization) {
+  // Flat axes have no extent; every vertex sits at Min there.
+  auto normalize = [](float p, float min, float extent) {
+    return extent > 0.0f ? (p - min) / extent : 0.0f;
+  };
+
+  XMFLOAT4 unorm(
+      normalize(position.x, quantization.Min.x, quantization.Extent.x),
+      normalize(position.y, quantization.Min.y, quantization.Extent.y),
+      normalize(position.z, quantization.Min.z, quantization.Extent.z), 0.0f);
+  XMStoreUShortN4(&out, XMLoadFloat4(&unorm));
+}
+
+void VertexFormats::EncodeDirection(XMFLOAT3 &out, const XMFLOAT3 &direction) {
+  out = direction;
+}
+
+void VertexFormats::EncodeDirection(XMSHORTN2 &out, const XMFLOAT3 &direction) {
+  XMFLOAT2 e = OctahedralEncode(direction);
+  XMStoreShortN2(&out, XMLoadFloat2(&e));
+}
+
+void VertexFormats::EncodeTexCoord(XMFLOAT2 &out, const XMFLOAT2 &texC) {
+  out = texC;
+}
+
+void VertexFormats::EncodeTexCoord(XMHALF2 &out, const XMFLOAT2 &texC) {
+  XMStoreHalf2(&out, XMLoadFloat2(&texC));
+}
+
+XMFLOAT2 VertexFormats::OctahedralEncode(const XMFLOAT3 &n) {
+  float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+  if (l1 <= 0.0f) {
+    return XMFLOAT2(0.0f, 0.0f);
+  }
+
+  float x = n.x / l1;
+  float y = n.y / l1;
+
+  // Fold the lower hemisphere over the diagonals.
+  if (n.z < 0.0f) {
+    float foldedX = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+    float foldedY = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+    x = foldedX;
+    y = foldedY;
+  }
+  return XMFLOAT2(x, y);
+}
+
+XMFLOAT3 VertexFormats::OctahedralDecode(const XMFLOAT2 &e) {
+  XMFLOAT3 n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+  float t = std::max<float>(-n.z, 0.0f);
+  n.x += n.x >= 0.0f ? -t : t;
+  n.y += n.y >= 0.0f ? -t : t;
+
+  XMFLOAT3 result;
+  XMStoreFloat3(&result, XMVector3Normalize(XMLoadFloat3(&n)));
+  return result;
+}
@@ -0,0 +1,116 @@
+//
+// Created by arrayJY on 2026/10/17.
+//
+
+#pragma once
+
+#include <DirectXMath.h>
+#include <DirectXPackedVector.h>
+#include <cstdint>
+#include <d3d12.h>
+
+// Vertex attribute storage is picked at compile time.  With PACKED_VERTICES
+//   positions  R32G32B32_FLOAT -> R16G16B16A16_UNORM within submesh bounds
+//   directions R32G32B32_FLOAT -> R16G16_SNORM octahedral
+//   tex coords R32G32_FLOAT    -> R16G16_FLOAT
+// Shaders compiled with VertexFormats::ShaderDefines() decode them with the
+// helpers in src/shaders/VertexFormats.hlsl, which the PBR and Shadow
+// shaders share.
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 0
+#endif
+
+// Bounds quantized positions are normalized to; the shader reconstructs
+// Min + unorm * Extent.
+struct PositionQuantization {
+  DirectX::XMFLOAT3 Min = {0.0f, 0.0f, 0.0f};
+  DirectX::XMFLOAT3 Extent = {1.0f, 1.0f, 1.0f};
+};
+
+// DXGI format of an attribute storage type.
+template <typename T> struct VertexElementFormat;
+
+template <> struct VertexElementFormat<DirectX::XMFLOAT2> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R32G32_FLOAT;
+};
+template <> struct VertexElementFormat<DirectX::XMFLOAT3> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R32G32B32_FLOAT;
+};
+template <> struct VertexElementFormat<DirectX::XMFLOAT4> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R32G32B32A32_FLOAT;
+};
+template <> struct VertexElementFormat<DirectX::PackedVector::XMUSHORTN4> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R16G16B16A16_UNORM;
+};
+template <> struct VertexElementFormat<DirectX::PackedVector::XMSHORTN2> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R16G16_SNORM;
+};
+template <> struct VertexElementFormat<DirectX::PackedVector::XMHALF2> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R16G16_FLOAT;
+};
+template <> struct VertexElementFormat<std::uint32_t> {
+  static constexpr DXGI_FORMAT Value = DXGI_FORMAT_R32_UINT;
+};
+
+// Input element of one vertex member; format and offset follow the member's
+// declaration, so layouts cannot drift from the struct.
+template <typename V, typename M>
+D3D12_INPUT_ELEMENT_DESC VertexElement(const char *semantic, M V::*member,
+                                       UINT semanticIndex = 0,
+                                       UINT inputSlot = 0) {
+  static const V probe{};
+  auto offset = reinterpret_cast<const std::uint8_t *>(&(probe.*member)) -
+                reinterpret_cast<const std::uint8_t *>(&probe);
+
+  return D3D12_INPUT_ELEMENT_DESC{
+      .SemanticName = semantic,
+      .SemanticIndex = semanticIndex,
+      .Format = VertexElementFormat<M>::Value,
+      .InputSlot = inputSlot,
+      .AlignedByteOffset = (UINT)offset,
+      .InputSlotClass = D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+      .InstanceDataStepRate = 0};
+}
+
+class VertexFormats {
+public:
+#if PACKED_VERTICES
+  using Position = DirectX::PackedVector::XMUSHORTN4;
+  using Direction = DirectX::PackedVector::XMSHORTN2;
+  using TexCoord = DirectX::PackedVector::XMHALF2;
+#else
+  using Position = DirectX::XMFLOAT3;
+  using Direction = DirectX::XMFLOAT3;
+  using TexCoord = DirectX::XMFLOAT2;
+#endif
+
+  // Macros shaders must be compiled with to read the selected formats.
+  static const D3D_SHADER_MACRO *ShaderDefines();
+
+  static PositionQuantization
+  ComputeQuantization(const DirectX::XMFLOAT3 *positions, size_t count,
+                      size_t positionStride);
+
+  // Encoders for both storage choices, so vertex filling code reads the same
+  // whichever one Position/Direction/TexCoord resolve to.
+  static void EncodePosition(DirectX::XMFLOAT3 &out,
+                             const DirectX::XMFLOAT3 &position,
+                             const PositionQuantization &quantization);
+  static void EncodePosition(DirectX::PackedVector::XMUSHORTN4 &out,
+                             const DirectX::XMFLOAT3 &position,
+                             const PositionQuantization &quantization);
+
+  static void EncodeDirection(DirectX::XMFLOAT3 &out,
+                              const DirectX::XMFLOAT3 &direction);
+  static void EncodeDirection(DirectX::PackedVector::XMSHORTN2 &out,
+                              const DirectX::XMFLOAT3 &direction);
+
+  static void EncodeTexCoord(DirectX::XMFLOAT2 &out,
+                             const DirectX::XMFLOAT2 &texC);
+  static void EncodeTexCoord(DirectX::PackedVector::XMHALF2 &out,
+                             const DirectX::XMFLOAT2 &texC);
+
+  // Octahedral mapping of a unit vector to [-1, 1]^2 and back.
+  static DirectX::XMFLOAT2 OctahedralEncode(const DirectX::XMFLOAT3 &n);
+  static DirectX::XMFLOAT3 OctahedralDecode(const DirectX::XMFLOAT2 &e);
+};
@@ -2,41 +2,113 @@ set_project("DirectX12Gadget")
 set_languages("c++20")
 
 add_rules("mode.debug", "mode.release")
-add_requires("glfw", "directxtk", "tinyobjloader")
+if is_plat("windows") then
+    add_requires("glfw", "directxtk")
 
-add_repositories("my-repo myrepo")
-add_requires("directxtk12")
+    add_repositories("my-repo myrepo")
+    add_requires("directxtk12")
+else
+    -- The Windows SDK ships DirectXMath; elsewhere only the headless
+    -- targets build, against the standalone headers.
+    add_requires("directxmath")
+end
 
 if is_mode("debug") then
     add_defines("DEBUG")
 end
 
-add_files("src/*.cpp")
-add_syslinks("d3d12", "dxgi", "d3dcompiler")
-add_packages("glfw", "directxtk12", "tinyobjloader")
+-- The cloth's scalar kernels are the reference its SIMD kernels must match
+-- bit for bit, so neither may be fused into FMAs behind our back.
+add_cxflags("-ffp-contract=off", {tools = {"gcc", "clang"}})
+
+option("packed_vertices")
+    set_default(false)
+    set_showmenu(true)
+    set_description("Store vertices as 16-bit positions, octahedral normals and half UVs")
+    add_defines("PACKED_VERTICES=1")
+option_end()
+add_options("packed_vertices")
+
+-- Everything under src/ that needs neither Direct3D nor a window.
+local headless_files = {
+    "src/cloth_colliders.cpp",
+    "src/cloth_scheduler.cpp",
+    "src/cloth_state_buffers.cpp",
+    "src/cpu_cloth.cpp",
+    "src/distance_field.cpp",
+    "src/geometry_generator.cpp",
+    "src/lod_selector.cpp",
+    "src/mesh_bounds.cpp",
+    "src/mesh_normals.cpp",
+    "src/mesh_optimizer.cpp",
+    "src/mesh_simplifier.cpp",
+    "src/mesh_welder.cpp",
+    "src/meshlet.cpp",
+    "src/obj_parser.cpp",
+    "src/spatial_hash.cpp",
+    "src/thread_pool.cpp",
+}
+
+target("Headless")
+    set_kind("static")
+    add_files(headless_files)
+    if not is_plat("windows") then
+        add_packages("directxmath", {public = true})
+        add_syslinks("pthread", {public = true})
+    end
+
+-- The demos take every other source under src/ and render through D3D12.
+local function add_renderer()
+    add_deps("Headless")
+    add_files("src/*.cpp")
+    remove_files(headless_files)
+    add_syslinks("d3d12", "dxgi", "d3dcompiler")
+    add_packages("glfw", "directxtk12")
+end
 
 target("Box")
     set_kind("binary")
+    set_enabled(is_plat("windows"))
+    add_renderer()
     add_files("src/Box/*.cpp")
     add_defines("SHADER_DIR=L\"" .. path.join(os.projectdir(), "src/Box/shaders"):gsub("\\", "/") .. "\"" )
 
 target("PBR")
     set_kind("binary")
+    set_enabled(is_plat("windows"))
+    add_renderer()
     add_files("src/PBR/*.cpp")
     add_defines("SHADER_DIR=L\"" .. path.join(os.projectdir(), "src/PBR/shaders"):gsub("\\", "/") .. "\"" )
 
 target("Cloth")
     set_kind("binary")
+    set_enabled(is_plat("windows"))
+    add_renderer()
     add_files("src/Cloth/*.cpp")
     add_defines("SHADER_DIR=L\"" .. path.join(os.projectdir(), "src/Cloth/shaders"):gsub("\\", "/") .. "\"" )
     add_defines("MODEL_DIR=\"" .. path.join(os.projectdir(), "src/Cloth/models"):gsub("\\", "/") .. "\"" )
 
 target("Shadow")
     set_kind("binary")
+    set_enabled(is_plat("windows"))
+    add_renderer()
     add_files("src/Shadow/*.cpp")
     add_defines("SHADER_DIR=L\"" .. path.join(os.projectdir(), "src/Shadow/shaders"):gsub("\\", "/") .. "\"" )
     add_defines("TEXTURE_DIR=L\"" .. path.join(os.projectdir(), "src/Shadow/textures"):gsub("\\", "/") .. "\"" )
 
+-- Headless, so it runs wherever the cloth test does.
+target("Benchmark")
+    set_kind("binary")
+    add_deps("Headless")
+    add_files("src/Benchmark/*.cpp")
+
+-- Checks the CPU cloth headless; run with xmake test.
+target("ClothTest")
+    set_kind("binary")
+    add_deps("Headless")
+    add_files("src/Tests/cloth_test.cpp")
+    add_tests("default")
+
 --
 -- If you want to known more usage about xmake, please see https://xmake.io
 --